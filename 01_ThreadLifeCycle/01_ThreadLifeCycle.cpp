@@ -1,9 +1,26 @@
-
 #include "Std.hpp"
+#ifdef _WIN32
 #include "Win.hpp"
+#endif
+#include "LifecycleBench.hpp"
 
-int main()
+// 예) 01_ThreadLifeCycle ms=500
+//     01_ThreadLifeCycle api=std     (Windows 에서 std::thread 버전 실행)
+//     01_ThreadLifeCycle mode=lifecycle iterations=5000 stack=0,64,1024
+//     01_ThreadLifeCycle ms=100 trace=trace.json   (Chrome trace / Perfetto 로 타임라인 보기)
+//     01_ThreadLifeCycle log=sync              (비동기 로그 싱크 대신 호출한 스레드에서 바로 출력)
+int main(int argc, char** argv)
 {
-	WMain();	
-	return 0;
-}
\ No newline at end of file
+	const LabArgs cli(argc, argv);
+	TraceSession trace(cli);
+	if (cli.Get("mode", "") == "lifecycle")
+		return LifecycleBenchMain(cli);
+
+	// 데모 워커의 출력은 비동기 로그 싱크로 씁니다. (벤치 모드는 표를 std::cout 에 바로 씀)
+	AsyncLogSession log(cli);
+#ifdef _WIN32
+	if (cli.Get("api", "win") == "win")
+		return WMain();
+#endif
+	return SMain(cli); // Win 버전은 Windows 전용
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// 01_ThreadLifeCycle - 스레드 한 생애의 구간 시각
+//
+// 메인                              워커
+// t0 = NowNs()
+// 생성 호출 ----------------------> firstNs = NowNs()   (워커의 첫 명령)
+// join / Wait 호출 (대기)            ... (빈 작업)
+//                                   lastNs  = NowNs()   (워커의 마지막 명령)
+// t1 = NowNs() <------------------- 스레드 종료
+//
+// - start = firstNs - t0 : 생성 요청부터 워커가 실제로 실행되기까지
+// - join  = t1 - lastNs  : 워커가 일을 마친 뒤 메인의 join 이 돌아오기까지 (스레드 정리 + 메인 깨우기)
+// - cycle = t1 - t0      : 생성 + 실행 + join 전체
+//
+// Std / Win 버전이 같은 구조체와 기록 함수를 씁니다.
+
+#include "../Common/Timing.hpp"
+
+#include <cstdint>
+#include <vector>
+
+struct LifecycleStamp
+{
+	std::int64_t firstNs = 0;
+	std::int64_t lastNs = 0;
+};
+
+struct LifecycleSamples
+{
+	std::vector<std::int64_t> startNs;
+	std::vector<std::int64_t> joinNs;
+	std::vector<std::int64_t> cycleNs;
+	int failures = 0; // 생성 실패 횟수
+};
+
+// 워커 본문: 첫 명령과 마지막 명령의 시각만 남깁니다.
+// 값은 join / Wait 이 돌아온 뒤에 읽으므로 join 이 동기화를 보장합니다.
+inline void StampLifecycle(LifecycleStamp* stamp)
+{
+	stamp->firstNs = NowNs();
+	stamp->lastNs = NowNs();
+}
+
+inline void RecordLifecycle(LifecycleSamples* samples, std::int64_t t0, const LifecycleStamp& stamp, std::int64_t t1)
+{
+	samples->startNs.push_back(stamp.firstNs - t0);
+	samples->joinNs.push_back(t1 - stamp.lastNs);
+	samples->cycleNs.push_back(t1 - t0);
+}
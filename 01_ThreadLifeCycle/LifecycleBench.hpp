@@ -0,0 +1,267 @@
+#pragma once
+
+// 01_ThreadLifeCycle - 스레드 생성 / join 비용 측정 (mode=lifecycle)
+//
+// 워커의 Sleep(2000) 을 빼고 빈 작업만 실행하는 스레드를 반복해서 만들고 join 하며,
+// 생성 API 마다 start(생성 → 첫 명령) / join(마지막 명령 → join 반환) 지연 분포를 봅니다. (Lifecycle.hpp)
+//
+// - std::thread     : 스택 크기를 지정할 수 없으므로 기본 스택만
+// - pthread_create  : pthread_attr_setstacksize        (Linux 등 POSIX)
+// - CreateThread    : dwStackSize (reserve)             (Windows, Win.hpp)
+// - _beginthreadex  : stack_size                        (Windows, Win.hpp)
+// - parked          : 미리 만들어 futex 로 재워 둔 스레드 하나를 깨워 일을 맡기고, 끝났다는 신호를 기다림
+//                     start = 깨우기 요청 → 첫 명령, join = 마지막 명령 → 완료 신호 수신
+//
+// parked 와 생성 방식의 cycle 차이가 "스레드를 새로 만들 때마다 내는 비용"이고,
+// 작업 하나가 이보다 충분히 길지 않다면 스레드 풀(재사용)이 이득입니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/Futex.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+#include "Lifecycle.hpp"
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <climits> // PTHREAD_STACK_MIN
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+void MeasureStdThreadLifecycle(int iterations, LifecycleSamples* samples)
+{
+	for (int i = 0; i < iterations; ++i)
+	{
+		LifecycleStamp stamp;
+		const std::int64_t t0 = NowNs();
+		std::thread worker(&StampLifecycle, &stamp);
+		worker.join();
+		const std::int64_t t1 = NowNs();
+		RecordLifecycle(samples, t0, stamp, t1);
+	}
+}
+
+#if !defined(_WIN32)
+void* LifecyclePthreadProc(void* param)
+{
+	StampLifecycle(static_cast<LifecycleStamp*>(param));
+	return nullptr;
+}
+
+// stackKb == 0 이면 기본 스택 (보통 ulimit -s, 8MB)
+void MeasurePthreadLifecycle(int iterations, unsigned stackKb, LifecycleSamples* samples)
+{
+	pthread_attr_t attr;
+	::pthread_attr_init(&attr);
+	if (stackKb != 0)
+	{
+		const std::size_t bytes = std::max<std::size_t>(static_cast<std::size_t>(stackKb) * 1024, PTHREAD_STACK_MIN);
+		::pthread_attr_setstacksize(&attr, bytes);
+	}
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		LifecycleStamp stamp;
+		pthread_t th;
+		const std::int64_t t0 = NowNs();
+		if (::pthread_create(&th, &attr, &LifecyclePthreadProc, &stamp) != 0)
+		{
+			++samples->failures;
+			continue;
+		}
+		::pthread_join(th, nullptr);
+		const std::int64_t t1 = NowNs();
+		RecordLifecycle(samples, t0, stamp, t1);
+	}
+	::pthread_attr_destroy(&attr);
+}
+#endif
+
+// 미리 만들어 둔 스레드 하나를 재사용합니다.
+// - request_ : 메인이 증가시키면 워커가 깨어나 일을 합니다. (kExitRequest 는 종료)
+// - done_    : 워커가 끝낸 요청 번호를 기록하고 메인을 깨웁니다.
+// 둘 다 futex 워드라서, 상대가 잠들어 있을 때 깨우기 한 번이 join 한 번을 대신합니다.
+class ParkedThread
+{
+public:
+	ParkedThread() : worker_(&ParkedThread::Run, this) {}
+
+	~ParkedThread()
+	{
+		request_.store(kExitRequest, std::memory_order_release);
+		FutexWakeOne(&request_);
+		worker_.join();
+	}
+
+	ParkedThread(const ParkedThread&) = delete;
+	ParkedThread& operator=(const ParkedThread&) = delete;
+
+	// 일을 맡기고 끝날 때까지 기다립니다. (생성 + join 자리)
+	void RunOnce(LifecycleStamp* stamp)
+	{
+		stamp_ = stamp;
+		const std::uint32_t seq = ++issued_;
+		request_.store(seq, std::memory_order_release);
+		FutexWakeOne(&request_);
+
+		std::uint32_t done = done_.load(std::memory_order_acquire);
+		while (done != seq)
+		{
+			FutexWait(&done_, done);
+			done = done_.load(std::memory_order_acquire);
+		}
+	}
+
+private:
+	static constexpr std::uint32_t kExitRequest = 0xFFFFFFFFu;
+
+	void Run()
+	{
+		std::uint32_t seen = 0;
+		while (true)
+		{
+			std::uint32_t request = request_.load(std::memory_order_acquire);
+			while (request == seen)
+			{
+				FutexWait(&request_, request);
+				request = request_.load(std::memory_order_acquire);
+			}
+			if (request == kExitRequest)
+				return;
+			seen = request;
+			StampLifecycle(stamp_);
+			done_.store(request, std::memory_order_release);
+			FutexWakeOne(&done_);
+		}
+	}
+
+	FutexWord request_{ 0 };
+	FutexWord done_{ 0 };
+	std::uint32_t issued_ = 0;           // 메인 스레드 전용
+	LifecycleStamp* stamp_ = nullptr;    // request_ (release / acquire) 로 워커에 전달
+	std::thread worker_;
+};
+
+void MeasureParkedLifecycle(int iterations, LifecycleSamples* samples)
+{
+	ParkedThread parked;
+	for (int i = 0; i < iterations; ++i)
+	{
+		LifecycleStamp stamp;
+		const std::int64_t t0 = NowNs();
+		parked.RunOnce(&stamp);
+		const std::int64_t t1 = NowNs();
+		RecordLifecycle(samples, t0, stamp, t1);
+	}
+}
+
+inline void PrintLifecycleHeader()
+{
+	std::cout << std::left
+		<< std::setw(16) << "api"
+		<< std::setw(9) << "stack"
+		<< std::setw(11) << "start p50"
+		<< std::setw(11) << "start p99"
+		<< std::setw(11) << "start max"
+		<< std::setw(10) << "join p50"
+		<< std::setw(10) << "join p99"
+		<< std::setw(10) << "join max"
+		<< std::setw(10) << "cycle p50"
+		<< "fail\n";
+}
+
+// 반환값: cycle p50 (ns)
+inline std::int64_t PrintLifecycleRow(const char* api, const std::string& stack, LifecycleSamples& samples)
+{
+	const LatencySummary start = Summarize(samples.startNs);
+	const LatencySummary join = Summarize(samples.joinNs);
+	const LatencySummary cycle = Summarize(samples.cycleNs);
+	std::cout << std::left
+		<< std::setw(16) << api
+		<< std::setw(9) << stack
+		<< std::setw(11) << start.p50
+		<< std::setw(11) << start.p99
+		<< std::setw(11) << start.max
+		<< std::setw(10) << join.p50
+		<< std::setw(10) << join.p99
+		<< std::setw(10) << join.max
+		<< std::setw(10) << cycle.p50
+		<< samples.failures << "\n";
+	return cycle.p50;
+}
+
+inline std::string StackLabel(unsigned stackKb)
+{
+	return stackKb == 0 ? std::string("default") : std::to_string(stackKb) + "K";
+}
+
+// "0,64,1024" -> {0, 64, 1024} (KB, 0 = 기본 스택)
+inline std::vector<unsigned> ParseStackList(const std::string& text)
+{
+	std::vector<unsigned> out;
+	std::stringstream ss(text);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		if (!item.empty())
+			out.push_back(static_cast<unsigned>(std::strtoul(item.c_str(), nullptr, 10)));
+	}
+	if (out.empty())
+		out.push_back(0);
+	return out;
+}
+
+// 인자
+// - iterations=N : API / 스택 크기마다 생성 + join 반복 횟수 (기본 2000)
+// - stack=KB,... : 스택 크기 목록, 0 = 기본 (기본 0,64,1024). std::thread / parked 는 기본 스택만
+int LifecycleBenchMain(const LabArgs& cli)
+{
+	const int iterations = static_cast<int>(std::max(1LL, cli.GetInt("iterations", 2000)));
+	const std::vector<unsigned> stacks = ParseStackList(cli.Get("stack", "0,64,1024"));
+
+	std::cout << "01_ThreadLifeCycle (lifecycle cost, iterations=" << iterations
+		<< ", hardware_concurrency=" << std::thread::hardware_concurrency() << ")\n\n";
+	PrintLifecycleHeader();
+
+	std::int64_t fastestCreateCycle = std::numeric_limits<std::int64_t>::max();
+	auto run = [&](const char* api, const std::string& stack, auto&& measure) {
+		LifecycleSamples samples;
+		samples.startNs.reserve(iterations);
+		samples.joinNs.reserve(iterations);
+		samples.cycleNs.reserve(iterations);
+		measure(&samples);
+		return PrintLifecycleRow(api, stack, samples);
+	};
+
+	fastestCreateCycle = std::min(fastestCreateCycle,
+		run("std::thread", "default", [&](LifecycleSamples* s) { MeasureStdThreadLifecycle(iterations, s); }));
+	for (unsigned stackKb : stacks)
+	{
+#if defined(_WIN32)
+		fastestCreateCycle = std::min(fastestCreateCycle,
+			run("CreateThread", StackLabel(stackKb), [&](LifecycleSamples* s) { MeasureCreateThreadLifecycle(iterations, stackKb, s); }));
+		fastestCreateCycle = std::min(fastestCreateCycle,
+			run("_beginthreadex", StackLabel(stackKb), [&](LifecycleSamples* s) { MeasureBeginThreadexLifecycle(iterations, stackKb, s); }));
+#else
+		fastestCreateCycle = std::min(fastestCreateCycle,
+			run("pthread_create", StackLabel(stackKb), [&](LifecycleSamples* s) { MeasurePthreadLifecycle(iterations, stackKb, s); }));
+#endif
+	}
+	const std::int64_t parkedCycle = run("parked", "default", [&](LifecycleSamples* s) { MeasureParkedLifecycle(iterations, s); });
+
+	std::cout << "\nstart = create call -> first instruction, join = last instruction -> join returns, cycle = both + run (ns)\n";
+	std::cout << "parked = reuse one pre-spawned thread (futex wake -> run -> futex done)\n";
+	std::cout << "creating a thread per task costs at least " << (fastestCreateCycle - parkedCycle)
+		<< " ns more than reusing a parked one (cycle p50, fastest API)\n";
+	return 0;
+}
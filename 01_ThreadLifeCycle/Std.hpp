@@ -1,28 +1,42 @@
 #pragma once
 
-#include <Windows.h>
+#include "../Common/Args.hpp"
+#include "../Common/AsyncLog.hpp"
+#include "../Common/Platform.hpp"
+#include "../Common/Trace.hpp"
+
 #include <thread>
 #include <iostream>
 
-constexpr DWORD kStdSleepMs = 2000;
+constexpr unsigned kStdSleepMs = 2000;
 
-void ThreadProc()
+void ThreadProc(unsigned sleepMs)
 {
+	TraceThreadName("std::thread worker");
+	TraceScope scope("ThreadProc", "lifecycle");
 	const char* tag = "std::thread";
-	const DWORD tid = ::GetCurrentThreadId();
-	std::cout << "[" << tag << "] thread start. tid=" << tid << "\n";
-	::Sleep(kStdSleepMs);
-	std::cout << "[" << tag << "] thread end.   tid=" << tid << "\n";
+	const LabThreadId tid = CurrentThreadId();
+	Log() << "[" << tag << "] thread start. tid=" << tid;
+	SleepMs(sleepMs);
+	Log() << "[" << tag << "] thread end.   tid=" << tid;
 }
 
 
-int SMain()
+// 인자
+// - ms=N : 워커가 잠드는 시간 (기본 kStdSleepMs)
+int SMain(const LabArgs& cli)
 {
+	const unsigned sleepMs = static_cast<unsigned>(cli.GetInt("ms", kStdSleepMs));
+
 	std::cout << "01_ThreadLifeCycle - std::thread)\n";
 	std::cout << "\n=== C++ std::thread version ===\n";
-	std::thread worker(&ThreadProc);
-	worker.join(); // ::WaitForSingleObject(hThread, INFINITE) 과 동일
-	std::cout << "[std::thread] joined (join done).\n";
+	std::thread worker(&ThreadProc, sleepMs);
+	TraceInstant("std::thread created", "lifecycle");
+	{
+		TraceScope join("join", "lifecycle");
+		worker.join(); // ::WaitForSingleObject(hThread, INFINITE) 과 동일
+	}
+	Log() << "[std::thread] joined (join done).";
 
     return 0;
 }
@@ -4,16 +4,22 @@
 #include <process.h> // _beginthreadex
 #include <iostream>
 
+#include "../Common/AsyncLog.hpp"
+#include "../Common/Trace.hpp"
+#include "Lifecycle.hpp"
+
 
 constexpr DWORD kWinSleepMs = 2000;
 
 DWORD WINAPI WinThreadProc(LPVOID)
 {
+	TraceThreadName("CreateThread worker");
+	TraceScope scope("WinThreadProc", "lifecycle");
 	const char* tag = "::CreateThread()";
 	const DWORD tid = ::GetCurrentThreadId();
-	std::cout << "[" << tag << "] thread start. tid=" << tid << "\n";
+	Log() << "[" << tag << "] thread start. tid=" << tid;
 	::Sleep(kWinSleepMs);
-	std::cout << "[" << tag << "] thread end.   tid=" << tid << "\n";
+	Log() << "[" << tag << "] thread end.   tid=" << tid;
     return 0;
 }
 
@@ -21,7 +27,7 @@ DWORD WINAPI WinThreadProc(LPVOID)
 // 따라서 CRT 를 사용하는 경우 CreateThread 사용을 권장하지 않는다.
 void RunWinApiThread()
 {
-    std::cout << "\n=== WinAPI CreateThread version ===\n";
+    Log() << "\n=== WinAPI CreateThread version ===";
     DWORD threadId = 0;
     HANDLE hThread = ::CreateThread(
         nullptr,
@@ -33,29 +39,35 @@ void RunWinApiThread()
 
     if (hThread == nullptr)
     {
-        std::cout << "[WinAPI] CreateThread failed. GetLastError=" << ::GetLastError() << "\n";
+        Log() << "[WinAPI] CreateThread failed. GetLastError=" << ::GetLastError();
         return;
     }
 
-    std::cout << "[WinAPI] created. threadId=" << threadId << " (main tid=" << ::GetCurrentThreadId() << ")\n";
-    ::WaitForSingleObject(hThread, INFINITE);
+    TraceInstant("CreateThread created", "lifecycle");
+    Log() << "[WinAPI] created. threadId=" << threadId << " (main tid=" << ::GetCurrentThreadId() << ")";
+    {
+        TraceScope join("WaitForSingleObject", "lifecycle");
+        ::WaitForSingleObject(hThread, INFINITE);
+    }
     ::CloseHandle(hThread);
-    std::cout << "[WinAPI] joined (WaitForSingleObject done).\n";
+    Log() << "[WinAPI] joined (WaitForSingleObject done).";
 }
 
 unsigned __stdcall CrtThreadProc(void*)
 {
+	TraceThreadName("_beginthreadex worker");
+	TraceScope scope("CrtThreadProc", "lifecycle");
 	const char* tag = "::_beginthreadex()";
 	const DWORD tid = ::GetCurrentThreadId();
-	std::cout << "[" << tag << "] thread start. tid=" << tid << "\n";
+	Log() << "[" << tag << "] thread start. tid=" << tid;
 	::Sleep(kWinSleepMs);
-	std::cout << "[" << tag << "] thread end.   tid=" << tid << "\n";
+	Log() << "[" << tag << "] thread end.   tid=" << tid;
     return 0;
 }
 
 void RunCrtThread()
 {
-    std::cout << "\n=== C (CRT) _beginthreadex version ===\n";
+    Log() << "\n=== C (CRT) _beginthreadex version ===";
     unsigned threadId = 0;
 
     // _beginthreadex는 CRT(C 런타임)에서 제공하는 쓰레드 생성 함수.
@@ -70,15 +82,19 @@ void RunCrtThread()
 
     if (hThreadRaw == 0)
     {
-        std::cout << "[CRT] _beginthreadex failed. errno=" << errno << "\n";
+        Log() << "[CRT] _beginthreadex failed. errno=" << errno;
         return;
     }
 
     HANDLE hThread = reinterpret_cast<HANDLE>(hThreadRaw);
-    std::cout << "[CRT] created. threadId=" << threadId << " (main tid=" << ::GetCurrentThreadId() << ")\n";
-    ::WaitForSingleObject(hThread, INFINITE);
+    TraceInstant("_beginthreadex created", "lifecycle");
+    Log() << "[CRT] created. threadId=" << threadId << " (main tid=" << ::GetCurrentThreadId() << ")";
+    {
+        TraceScope join("WaitForSingleObject", "lifecycle");
+        ::WaitForSingleObject(hThread, INFINITE);
+    }
     ::CloseHandle(hThread);
-    std::cout << "[CRT] joined (WaitForSingleObject done).\n";
+    Log() << "[CRT] joined (WaitForSingleObject done).";
 }
 
 
@@ -90,3 +106,61 @@ int WMain()
     return 0;
 }
 
+
+
+// ---- 생명주기 비용 측정 (mode=lifecycle, LifecycleBench.hpp) ----
+// stackKb == 0 이면 기본 스택(실행 파일 헤더의 reserve 크기)을 사용합니다.
+
+DWORD WINAPI LifecycleWinThreadProc(LPVOID param)
+{
+	StampLifecycle(static_cast<LifecycleStamp*>(param));
+	return 0;
+}
+
+unsigned __stdcall LifecycleCrtThreadProc(void* param)
+{
+	StampLifecycle(static_cast<LifecycleStamp*>(param));
+	return 0;
+}
+
+void MeasureCreateThreadLifecycle(int iterations, unsigned stackKb, LifecycleSamples* samples)
+{
+	const SIZE_T stackBytes = static_cast<SIZE_T>(stackKb) * 1024;
+	for (int i = 0; i < iterations; ++i)
+	{
+		LifecycleStamp stamp;
+		const std::int64_t t0 = NowNs();
+		// STACK_SIZE_PARAM_IS_A_RESERVATION: 예약(reserve) 크기로 지정. 없으면 commit 크기로 해석됩니다.
+		HANDLE hThread = ::CreateThread(nullptr, stackBytes, &LifecycleWinThreadProc, &stamp,
+			stackBytes != 0 ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0, nullptr);
+		if (hThread == nullptr)
+		{
+			++samples->failures;
+			continue;
+		}
+		::WaitForSingleObject(hThread, INFINITE);
+		const std::int64_t t1 = NowNs();
+		::CloseHandle(hThread);
+		RecordLifecycle(samples, t0, stamp, t1);
+	}
+}
+
+void MeasureBeginThreadexLifecycle(int iterations, unsigned stackKb, LifecycleSamples* samples)
+{
+	for (int i = 0; i < iterations; ++i)
+	{
+		LifecycleStamp stamp;
+		const std::int64_t t0 = NowNs();
+		const uintptr_t hThreadRaw = _beginthreadex(nullptr, stackKb * 1024, &LifecycleCrtThreadProc, &stamp, 0, nullptr);
+		if (hThreadRaw == 0)
+		{
+			++samples->failures;
+			continue;
+		}
+		HANDLE hThread = reinterpret_cast<HANDLE>(hThreadRaw);
+		::WaitForSingleObject(hThread, INFINITE);
+		const std::int64_t t1 = NowNs();
+		::CloseHandle(hThread);
+		RecordLifecycle(samples, t0, stamp, t1);
+	}
+}
@@ -1,11 +1,36 @@
-#include "std.hpp"
+#include "Std.hpp"
+#ifdef _WIN32
 #include "Win.hpp"
+#endif
+#include "LockBench.hpp"
+#include "ReadMostly.hpp"
+#include "Topology.hpp"
 
 // Global accumulator for this project
 long long g_Total = 0;
 
-int main()
+// 예) 02_MutualExclusion mode=padded-shards threads=8 max=10000000
+//     02_MutualExclusion mode=global-lock lock=mcs threads=8 max=1000000
+//     02_MutualExclusion mode=lock-bench threads=8 ms=200
+//     02_MutualExclusion mode=read-mostly reads=95 threads=8
+//     02_MutualExclusion mode=topology lock=ticket threads=2 ms=200
+//     02_MutualExclusion mode=atomic cpus=0-3 spread=1 priority=high name=acc
+//     02_MutualExclusion api=win mode=atomic   (Windows: CreateThread / Interlocked 버전)
+//     02_MutualExclusion mode=global-lock threads=4 max=100000 exec=spawn trace=trace.json
+int main(int argc, char** argv)
 {
-	SMain();
-	return 0;
-}
\ No newline at end of file
+	const LabArgs cli(argc, argv);
+	TraceSession trace(cli);
+	if (cli.Get("mode", "") == "lock-bench")
+		return LockBenchMain(cli);
+	if (cli.Get("mode", "") == "read-mostly")
+		return ReadMostlyMain(cli);
+	if (cli.Get("mode", "") == "topology")
+		return TopologyMain(cli);
+#ifdef _WIN32
+	if (cli.Get("api", "") == "win")
+		return WMain(cli);
+#endif
+
+	return SMain(cli);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+// 02_MutualExclusion - 누적(accumulation) 전략
+//
+// Std.hpp / Win.hpp 가 같이 쓰는 전략 목록과 결과 리포트입니다.
+//
+// - GlobalLock   : 매 덧셈마다 전역 락 (기존 방식, 모든 스레드가 한 캐시 라인에 줄을 섬)
+// - Atomic       : 매 덧셈마다 원자적 fetch_add (락은 없지만 캐시 라인은 여전히 하나)
+// - PaddedShards : 스레드마다 캐시 라인 하나씩 차지하는 슬롯에 누적, join 후 메인이 합산
+// - LocalPartial : 스레드 로컬 변수에 누적, 마지막에 한 번만 락을 잡고 g_Total에 더함
+//
+// 실행 방식(exec)
+// - spawn : 작업(task) 하나당 스레드 하나를 만들고 join (기존 방식)
+// - pool  : 같은 작업들을 고정 크기 워커 풀에 제출하고 WaitAll
+
+#include "../Common/Timing.hpp"
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+enum class AccumulateMode
+{
+	GlobalLock,
+	Atomic,
+	PaddedShards,
+	LocalPartial,
+};
+
+constexpr AccumulateMode kAllAccumulateModes[] = {
+	AccumulateMode::GlobalLock,
+	AccumulateMode::Atomic,
+	AccumulateMode::PaddedShards,
+	AccumulateMode::LocalPartial,
+};
+
+inline const char* AccumulateModeName(AccumulateMode mode)
+{
+	switch (mode)
+	{
+	case AccumulateMode::GlobalLock:   return "global-lock";
+	case AccumulateMode::Atomic:       return "atomic";
+	case AccumulateMode::PaddedShards: return "padded-shards";
+	case AccumulateMode::LocalPartial: return "local-partial";
+	}
+	return "?";
+}
+
+// 이름으로 전략 찾기. 모르는 이름이면 false
+inline bool ParseAccumulateMode(const char* name, AccumulateMode* out)
+{
+	for (AccumulateMode mode : kAllAccumulateModes)
+	{
+		if (std::strcmp(name, AccumulateModeName(mode)) == 0)
+		{
+			*out = mode;
+			return true;
+		}
+	}
+	return false;
+}
+
+struct AccumulateReport
+{
+	const char* exec = "spawn";
+	AccumulateMode mode = AccumulateMode::GlobalLock;
+	int threadCount = 0;	// 논리 작업 수
+	int workers = 0;		// 실제로 일한 OS 스레드 수
+	long long peakRssKb = -1;
+	int max = 0;
+	long long expected = 0;
+	long long total = 0;
+	double wallSec = 0.0;
+};
+
+inline long long ExpectedTotal(int threadCount, int max)
+{
+	const long long expectedPerThread = (static_cast<long long>(max) * (max + 1)) / 2;
+	return expectedPerThread * threadCount;
+}
+
+inline void PrintAccumulateHeader()
+{
+	std::cout << std::left
+		<< std::setw(7) << "exec"
+		<< std::setw(15) << "mode"
+		<< std::setw(10) << "tasks"
+		<< std::setw(9) << "workers"
+		<< std::setw(12) << "max"
+		<< std::setw(12) << "wall(ms)"
+		<< std::setw(14) << "ops/sec"
+		<< std::setw(14) << "peakRSS(KB)"
+		<< "check\n";
+}
+
+// ops = threadCount * max (g_Total += i 한 번이 1 op)
+inline void PrintAccumulateReport(const AccumulateReport& r)
+{
+	const double ops = static_cast<double>(r.threadCount) * r.max;
+	const double opsPerSec = r.wallSec > 0.0 ? ops / r.wallSec : 0.0;
+
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left
+		<< std::setw(7) << r.exec
+		<< std::setw(15) << AccumulateModeName(r.mode)
+		<< std::setw(10) << r.threadCount
+		<< std::setw(9) << r.workers
+		<< std::setw(12) << r.max
+		<< std::setw(12) << std::fixed << std::setprecision(2) << r.wallSec * 1000.0
+		<< std::setw(14) << std::scientific << std::setprecision(3) << opsPerSec
+		<< std::setw(14) << r.peakRssKb
+		<< (r.total == r.expected ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
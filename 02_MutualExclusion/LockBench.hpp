@@ -0,0 +1,203 @@
+#pragma once
+
+// 02_MutualExclusion - 락 벤치마크
+//
+// 누적 랩의 임계 구역은 덧셈 한 번이라 락 자체의 비용만 보입니다.
+// 여기서는 스레드 수와 임계 구역 길이(cs = 공유 슬롯 갱신 횟수)를 바꿔 가며, 정해진 시간(ms) 동안
+// 각 락으로 lock -> 공유 데이터 갱신 -> unlock 을 반복하고 아래 값을 비교합니다.
+//
+// - acq/sec   : 전체 획득 횟수 / 측정 시간
+// - spread(%) : 스레드별 획득 횟수의 (최대 - 최소) / 평균. 0 에 가까울수록 공정
+// - p50 / p99 : lock() 호출부터 반환까지의 시간 (ns)
+// - check     : 공유 슬롯 합계 == 획득 횟수 * cs (상호 배제가 깨지면 MISMATCH)
+//
+// profile=1 이면 각 락 바로 아래에 같은 락을 ProfiledLock 으로 감싼 줄("+prof")을 추가해 프로파일러 오버헤드를 보여 주고,
+// 끝에 락 경합 보고를 출력합니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/CacheLine.hpp"
+#include "../Common/LockProfiler.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+#include "LockKind.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 스레드마다 보관하는 획득 지연 샘플 수 (넘치면 오래된 것부터 덮어씀)
+constexpr std::size_t kLockBenchMaxSamples = 1 << 16;
+
+template <typename Lock>
+struct LockBenchShared
+{
+	alignas(kCacheLineSize) Lock lock;
+	alignas(kCacheLineSize) long long slots[8] = {};
+	int csLength = 1;
+	std::atomic<int> ready{ 0 };
+	std::atomic<bool> go{ false };
+	std::atomic<bool> stop{ false };
+};
+
+struct LockBenchThreadResult
+{
+	long long acquisitions = 0;
+	std::vector<std::int64_t> acquireNs;
+};
+
+template <typename Lock>
+void LockBenchThreadProc(LockBenchShared<Lock>* shared, LockBenchThreadResult* result)
+{
+	result->acquireNs.reserve(kLockBenchMaxSamples);
+	shared->ready.fetch_add(1);
+	while (!shared->go.load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	// volatile: 임계 구역 안의 갱신을 컴파일러가 한 번의 덧셈으로 합치지 못하게 합니다.
+	volatile long long* slots = shared->slots;
+	const int cs = shared->csLength;
+	long long acquisitions = 0;
+	while (!shared->stop.load(std::memory_order_relaxed))
+	{
+		const std::int64_t t0 = NowNs();
+		shared->lock.lock();
+		const std::int64_t acquired = NowNs();
+		for (int k = 0; k < cs; ++k)
+			slots[k & 7] = slots[k & 7] + 1;
+		shared->lock.unlock();
+
+		if (result->acquireNs.size() < kLockBenchMaxSamples)
+			result->acquireNs.push_back(acquired - t0);
+		else
+			result->acquireNs[acquisitions % kLockBenchMaxSamples] = acquired - t0;
+		++acquisitions;
+	}
+	result->acquisitions = acquisitions;
+}
+
+template <typename Lock>
+void RunLockBenchCell(const std::string& lockName, int threadCount, int csLength, unsigned durationMs)
+{
+	LockBenchShared<Lock> shared;
+	shared.csLength = csLength;
+	NameLock(shared.lock, "lock-bench " + lockName + " threads=" + std::to_string(threadCount) + " cs=" + std::to_string(csLength));
+	std::vector<LockBenchThreadResult> results(threadCount);
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (int t = 0; t < threadCount; ++t)
+		threads.emplace_back(&LockBenchThreadProc<Lock>, &shared, &results[t]);
+
+	while (shared.ready.load() != threadCount)
+		std::this_thread::yield();
+	StopWatch watch;
+	shared.go.store(true, std::memory_order_release);
+	std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+	shared.stop.store(true, std::memory_order_relaxed);
+	for (auto& th : threads)
+		th.join();
+	const double sec = watch.ElapsedSec();
+
+	long long total = 0;
+	long long minAcq = results[0].acquisitions;
+	long long maxAcq = results[0].acquisitions;
+	std::vector<std::int64_t> samples;
+	for (const auto& r : results)
+	{
+		total += r.acquisitions;
+		minAcq = std::min(minAcq, r.acquisitions);
+		maxAcq = std::max(maxAcq, r.acquisitions);
+		samples.insert(samples.end(), r.acquireNs.begin(), r.acquireNs.end());
+	}
+	const LatencySummary latency = Summarize(samples);
+	const double mean = static_cast<double>(total) / threadCount;
+	const double spread = mean > 0.0 ? (maxAcq - minAcq) * 100.0 / mean : 0.0;
+
+	long long slotSum = 0;
+	for (long long v : shared.slots)
+		slotSum += v;
+
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left
+		<< std::setw(16) << lockName
+		<< std::setw(9) << threadCount
+		<< std::setw(7) << csLength
+		<< std::setw(13) << std::scientific << std::setprecision(3) << total / sec
+		<< std::setw(11) << std::fixed << std::setprecision(1) << spread
+		<< std::setw(10) << latency.p50
+		<< std::setw(11) << latency.p99
+		<< (slotSum == total * csLength ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - lock=all|std-mutex|ttas|ticket|mcs|adaptive (기본 all)
+// - threads=N : 1 부터 N 까지 2배씩 늘려 가며 측정 (기본 max(4, hardware_concurrency))
+// - cs=N      : 임계 구역 길이 하나만 측정 (기본 1, 16, 256 을 차례로)
+// - ms=N      : 칸 하나당 측정 시간 (기본 200)
+// - profile=1 : ProfiledLock 으로 감싼 줄을 함께 측정하고 락 경합 보고 출력 (holdsample=N, 기본 16)
+int LockBenchMain(const LabArgs& cli)
+{
+	const std::string lockName = cli.Get("lock", "all");
+	LockKind only = LockKind::StdMutex;
+	if (lockName != "all" && !ParseLockKind(lockName.c_str(), &only))
+	{
+		std::cout << "unknown lock=" << lockName << "\n";
+		return 1;
+	}
+
+	const int hw = static_cast<int>(std::thread::hardware_concurrency());
+	const int maxThreads = static_cast<int>(std::max(1LL, cli.GetInt("threads", std::max(4, hw))));
+	const unsigned durationMs = static_cast<unsigned>(cli.GetInt("ms", 200));
+	const bool profile = cli.GetInt("profile", 0) != 0;
+	LockProfiler::Instance().SetHoldSampleEvery(static_cast<unsigned>(cli.GetInt("holdsample", 16)));
+
+	std::vector<int> threadCounts;
+	for (int t = 1; t < maxThreads; t *= 2)
+		threadCounts.push_back(t);
+	threadCounts.push_back(maxThreads);
+
+	std::vector<int> csLengths = { 1, 16, 256 };
+	if (cli.Has("cs"))
+		csLengths = { static_cast<int>(cli.GetInt("cs", 1)) };
+
+	std::cout << "02_MutualExclusion (lock benchmark, ms=" << durationMs << ", hardware_concurrency=" << hw << ")\n\n";
+	std::cout << std::left
+		<< std::setw(16) << "lock"
+		<< std::setw(9) << "threads"
+		<< std::setw(7) << "cs"
+		<< std::setw(13) << "acq/sec"
+		<< std::setw(11) << "spread(%)"
+		<< std::setw(10) << "p50(ns)"
+		<< std::setw(11) << "p99(ns)"
+		<< "check\n";
+
+	for (int cs : csLengths)
+	{
+		for (int threads : threadCounts)
+		{
+			for (LockKind kind : kAllLockKinds)
+			{
+				if (lockName != "all" && kind != only)
+					continue;
+				VisitLockKind(kind, [&](auto tag) {
+					using Lock = typename decltype(tag)::Type;
+					RunLockBenchCell<Lock>(LockKindName(kind), threads, cs, durationMs);
+					if (profile)
+						RunLockBenchCell<ProfiledLock<Lock>>(std::string(LockKindName(kind)) + "+prof", threads, cs, durationMs);
+				});
+			}
+		}
+	}
+	if (profile)
+	{
+		std::cout << "\n";
+		LockProfiler::Instance().Report(std::cout);
+	}
+	return 0;
+}
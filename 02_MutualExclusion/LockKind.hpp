@@ -0,0 +1,80 @@
+#pragma once
+
+// 02_MutualExclusion - 락 종류 선택
+//
+// Std 버전의 GlobalLock / LocalPartial 전략과 lock-bench 가 사용할 락을 이름으로 고릅니다.
+// 락 타입은 템플릿 인자이므로, 실행 중에 고른 종류를 VisitLockKind 로 타입으로 바꿔 넘깁니다.
+//
+//   VisitLockKind(kind, [&](auto tag) {
+//       using Lock = typename decltype(tag)::Type;
+//       ...
+//   });
+
+#include "../Common/Locks.hpp"
+
+#include <cstring>
+#include <mutex>
+
+enum class LockKind
+{
+	StdMutex,
+	Ttas,
+	Ticket,
+	Mcs,
+	Adaptive,
+};
+
+constexpr LockKind kAllLockKinds[] = {
+	LockKind::StdMutex,
+	LockKind::Ttas,
+	LockKind::Ticket,
+	LockKind::Mcs,
+	LockKind::Adaptive,
+};
+
+inline const char* LockKindName(LockKind kind)
+{
+	switch (kind)
+	{
+	case LockKind::StdMutex: return "std-mutex";
+	case LockKind::Ttas:     return "ttas";
+	case LockKind::Ticket:   return "ticket";
+	case LockKind::Mcs:      return "mcs";
+	case LockKind::Adaptive: return "adaptive";
+	}
+	return "?";
+}
+
+// 이름으로 락 종류 찾기. 모르는 이름이면 false
+inline bool ParseLockKind(const char* name, LockKind* out)
+{
+	for (LockKind kind : kAllLockKinds)
+	{
+		if (std::strcmp(name, LockKindName(kind)) == 0)
+		{
+			*out = kind;
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename T>
+struct LockTag
+{
+	using Type = T;
+};
+
+template <typename F>
+decltype(auto) VisitLockKind(LockKind kind, F&& f)
+{
+	switch (kind)
+	{
+	case LockKind::Ttas:     return f(LockTag<TtasSpinLock>{});
+	case LockKind::Ticket:   return f(LockTag<TicketLock>{});
+	case LockKind::Mcs:      return f(LockTag<McsLock>{});
+	case LockKind::Adaptive: return f(LockTag<AdaptiveMutex>{});
+	case LockKind::StdMutex: break;
+	}
+	return f(LockTag<std::mutex>{});
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+// 02_MutualExclusion - 읽기 위주(read-mostly) 누적기
+//
+// 누적 랩의 g_Total 을 "가끔 쓰고 자주 읽는" 공유 상태로 바꿔, 읽기/쓰기 비율에 따라 동기화 방식을 비교합니다.
+//
+// 공유 상태는 두 값 { total, negTotal } 이고, 쓰기는 두 값을 함께 바꿔 항상 total + negTotal == 0 을 유지합니다.
+// 읽기가 쓰기 도중의 값을 보면(찢어진 읽기) 합이 0 이 아니므로 torn 으로 셉니다.
+//
+// - exclusive    : std::mutex (읽기도 배타적으로) - 기준
+// - shared-mutex : std::shared_mutex
+// - rw-spin      : 쓰기 우선 RW 스핀락 (Common/RwLocks.hpp)
+// - seqlock      : 읽기는 락 없이 복사 후 검증, 쓰기만 직렬화
+// - brlock       : CPU 별 읽기 카운터 (big reader lock)
+
+#include "../Common/Args.hpp"
+#include "../Common/RwLocks.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+#include "LockKind.hpp" // LockTag
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ReadMostlySnapshot
+{
+	long long total = 0;
+	long long negTotal = 0;
+};
+
+// 락으로 보호하는 공유 상태. Mutex 가 lock_shared 를 가지면 읽기는 shared_lock, 아니면 배타 lock
+template <typename Mutex>
+class LockedReadMostly
+{
+public:
+	ReadMostlySnapshot Read()
+	{
+		if constexpr (requires(Mutex& m) { m.lock_shared(); })
+		{
+			std::shared_lock<Mutex> lock(m_);
+			return value_;
+		}
+		else
+		{
+			std::lock_guard<Mutex> lock(m_);
+			return value_;
+		}
+	}
+
+	void Add(long long delta)
+	{
+		std::lock_guard<Mutex> lock(m_);
+		value_.total += delta;
+		value_.negTotal -= delta;
+	}
+
+private:
+	Mutex m_;
+	ReadMostlySnapshot value_;
+};
+
+class SeqLockReadMostly
+{
+public:
+	ReadMostlySnapshot Read() { return seq_.Read(); }
+
+	void Add(long long delta)
+	{
+		seq_.Write([delta](ReadMostlySnapshot& v) {
+			v.total += delta;
+			v.negTotal -= delta;
+		});
+	}
+
+private:
+	SeqLock<ReadMostlySnapshot> seq_;
+};
+
+enum class ReadMostlyKind
+{
+	Exclusive,
+	SharedMutex,
+	RwSpin,
+	SeqLock,
+	BigReader,
+};
+
+constexpr ReadMostlyKind kAllReadMostlyKinds[] = {
+	ReadMostlyKind::Exclusive,
+	ReadMostlyKind::SharedMutex,
+	ReadMostlyKind::RwSpin,
+	ReadMostlyKind::SeqLock,
+	ReadMostlyKind::BigReader,
+};
+
+inline const char* ReadMostlyKindName(ReadMostlyKind kind)
+{
+	switch (kind)
+	{
+	case ReadMostlyKind::Exclusive:   return "exclusive";
+	case ReadMostlyKind::SharedMutex: return "shared-mutex";
+	case ReadMostlyKind::RwSpin:      return "rw-spin";
+	case ReadMostlyKind::SeqLock:     return "seqlock";
+	case ReadMostlyKind::BigReader:   return "brlock";
+	}
+	return "?";
+}
+
+inline bool ParseReadMostlyKind(const char* name, ReadMostlyKind* out)
+{
+	for (ReadMostlyKind kind : kAllReadMostlyKinds)
+	{
+		if (std::strcmp(name, ReadMostlyKindName(kind)) == 0)
+		{
+			*out = kind;
+			return true;
+		}
+	}
+	return false;
+}
+
+// 지연 시간은 kReadMostlySampleEvery 번에 한 번만 잽니다. (seqlock 읽기처럼 수 ns 짜리 연산에 시계 비용이 섞이지 않도록)
+constexpr unsigned kReadMostlySampleEvery = 32;
+constexpr std::size_t kReadMostlyMaxSamples = 1 << 15;
+
+struct ReadMostlyThreadResult
+{
+	long long reads = 0;
+	long long writes = 0;
+	long long torn = 0;
+	long long added = 0;
+	std::vector<std::int64_t> readNs;
+	std::vector<std::int64_t> writeNs;
+};
+
+template <typename Shared>
+struct ReadMostlyRun
+{
+	Shared shared;
+	int readPercent = 95;
+	std::atomic<int> ready{ 0 };
+	std::atomic<bool> go{ false };
+	std::atomic<bool> stop{ false };
+};
+
+inline void PushSample(std::vector<std::int64_t>& samples, std::int64_t ns)
+{
+	if (samples.size() < kReadMostlyMaxSamples)
+		samples.push_back(ns);
+}
+
+template <typename Shared>
+void ReadMostlyThreadProc(ReadMostlyRun<Shared>* run, ReadMostlyThreadResult* result, int index)
+{
+	result->readNs.reserve(kReadMostlyMaxSamples);
+	result->writeNs.reserve(kReadMostlyMaxSamples);
+	run->ready.fetch_add(1);
+	while (!run->go.load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	// 스레드마다 다른 시드의 xorshift 로 읽기/쓰기를 섞습니다.
+	// 카운터는 지역 변수에 모았다가 마지막에 한 번만 기록합니다. (results 의 이웃 원소와 캐시 라인 공유 방지)
+	std::uint32_t rng = 2463534242u + static_cast<std::uint32_t>(index) * 7919u;
+	unsigned op = 0;
+	long long reads = 0;
+	long long writes = 0;
+	long long torn = 0;
+	long long added = 0;
+	while (!run->stop.load(std::memory_order_relaxed))
+	{
+		rng ^= rng << 13;
+		rng ^= rng >> 17;
+		rng ^= rng << 5;
+		const bool isRead = static_cast<int>(rng % 100) < run->readPercent;
+		const bool sample = (++op % kReadMostlySampleEvery) == 0;
+		const std::int64_t t0 = sample ? NowNs() : 0;
+
+		if (isRead)
+		{
+			const ReadMostlySnapshot v = run->shared.Read();
+			if (v.total + v.negTotal != 0)
+				++torn;
+			++reads;
+			if (sample)
+				PushSample(result->readNs, NowNs() - t0);
+		}
+		else
+		{
+			const long long delta = (writes % 100) + 1;
+			run->shared.Add(delta);
+			added += delta;
+			++writes;
+			if (sample)
+				PushSample(result->writeNs, NowNs() - t0);
+		}
+	}
+	result->reads = reads;
+	result->writes = writes;
+	result->torn = torn;
+	result->added = added;
+}
+
+template <typename Shared>
+void RunReadMostlyCell(const char* name, int threadCount, int readPercent, unsigned durationMs)
+{
+	auto run = std::make_unique<ReadMostlyRun<Shared>>();
+	run->readPercent = readPercent;
+	std::vector<ReadMostlyThreadResult> results(threadCount);
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (int t = 0; t < threadCount; ++t)
+		threads.emplace_back(&ReadMostlyThreadProc<Shared>, run.get(), &results[t], t);
+
+	while (run->ready.load() != threadCount)
+		std::this_thread::yield();
+	StopWatch watch;
+	run->go.store(true, std::memory_order_release);
+	std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+	run->stop.store(true, std::memory_order_relaxed);
+	for (auto& th : threads)
+		th.join();
+	const double sec = watch.ElapsedSec();
+
+	long long reads = 0;
+	long long writes = 0;
+	long long torn = 0;
+	long long added = 0;
+	std::vector<std::int64_t> readNs;
+	std::vector<std::int64_t> writeNs;
+	for (const auto& r : results)
+	{
+		reads += r.reads;
+		writes += r.writes;
+		torn += r.torn;
+		added += r.added;
+		readNs.insert(readNs.end(), r.readNs.begin(), r.readNs.end());
+		writeNs.insert(writeNs.end(), r.writeNs.begin(), r.writeNs.end());
+	}
+	const LatencySummary readLatency = Summarize(readNs);
+	const LatencySummary writeLatency = Summarize(writeNs);
+	const ReadMostlySnapshot final = run->shared.Read();
+
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left
+		<< std::setw(14) << name
+		<< std::setw(9) << threadCount
+		<< std::setw(13) << std::scientific << std::setprecision(3) << (reads + writes) / sec
+		<< std::setw(13) << reads / sec
+		<< std::setw(11) << readLatency.p50
+		<< std::setw(11) << readLatency.p99
+		<< std::setw(11) << writeLatency.p99
+		<< (torn == 0 && final.total == added ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
+
+template <typename F>
+decltype(auto) VisitReadMostlyKind(ReadMostlyKind kind, F&& f)
+{
+	switch (kind)
+	{
+	case ReadMostlyKind::SharedMutex: return f(LockTag<LockedReadMostly<std::shared_mutex>>{});
+	case ReadMostlyKind::RwSpin:      return f(LockTag<LockedReadMostly<RwSpinLock>>{});
+	case ReadMostlyKind::SeqLock:     return f(LockTag<SeqLockReadMostly>{});
+	case ReadMostlyKind::BigReader:   return f(LockTag<LockedReadMostly<BigReaderLock>>{});
+	case ReadMostlyKind::Exclusive:   break;
+	}
+	return f(LockTag<LockedReadMostly<std::mutex>>{});
+}
+
+// 인자
+// - rw=all|exclusive|shared-mutex|rw-spin|seqlock|brlock (기본 all)
+// - reads=P   : 읽기 비율(%) (기본 95)
+// - threads=N : 1 부터 N 까지 2배씩 늘려 가며 측정 (기본 max(4, hardware_concurrency))
+// - ms=N      : 칸 하나당 측정 시간 (기본 200)
+int ReadMostlyMain(const LabArgs& cli)
+{
+	const std::string kindName = cli.Get("rw", "all");
+	ReadMostlyKind only = ReadMostlyKind::Exclusive;
+	if (kindName != "all" && !ParseReadMostlyKind(kindName.c_str(), &only))
+	{
+		std::cout << "unknown rw=" << kindName << "\n";
+		return 1;
+	}
+
+	const int readPercent = static_cast<int>(std::clamp<long long>(cli.GetInt("reads", 95), 0, 100));
+	const int hw = static_cast<int>(std::thread::hardware_concurrency());
+	const int maxThreads = static_cast<int>(cli.GetInt("threads", std::max(4, hw)));
+	const unsigned durationMs = static_cast<unsigned>(cli.GetInt("ms", 200));
+
+	std::vector<int> threadCounts;
+	for (int t = 1; t < maxThreads; t *= 2)
+		threadCounts.push_back(t);
+	threadCounts.push_back(maxThreads);
+
+	std::cout << "02_MutualExclusion (read-mostly accumulator, reads=" << readPercent << "%, ms=" << durationMs
+		<< ", hardware_concurrency=" << hw << ")\n\n";
+	std::cout << std::left
+		<< std::setw(14) << "rw"
+		<< std::setw(9) << "threads"
+		<< std::setw(13) << "ops/sec"
+		<< std::setw(13) << "reads/sec"
+		<< std::setw(11) << "rd p50"
+		<< std::setw(11) << "rd p99"
+		<< std::setw(11) << "wr p99"
+		<< "check\n";
+
+	for (int threads : threadCounts)
+	{
+		for (ReadMostlyKind kind : kAllReadMostlyKinds)
+		{
+			if (kindName != "all" && kind != only)
+				continue;
+			VisitReadMostlyKind(kind, [&](auto tag) {
+				using Shared = typename decltype(tag)::Type;
+				RunReadMostlyCell<Shared>(ReadMostlyKindName(kind), threads, readPercent, durationMs);
+			});
+		}
+	}
+	std::cout << "\nlatency columns are ns (1 op in " << kReadMostlySampleEvery << " sampled)\n";
+	return 0;
+}
@@ -1,55 +1,242 @@
 #pragma once
 
-#include <Windows.h>
+#include "../Common/Args.hpp"
+#include "../Common/CacheLine.hpp"
+#include "../Common/LockProfiler.hpp"
+#include "../Common/Platform.hpp"
+#include "../Common/ProcessStats.hpp"
+#include "../Common/ThreadAttributes.hpp"
+#include "../Common/ThreadPool.hpp"
+#include "../Common/Timing.hpp"
+#include "../Common/Trace.hpp"
+#include "AccumulateMode.hpp"
+#include "LockKind.hpp"
 
+#include <atomic>
 #include <iostream>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 extern long long g_Total;
 
 
+// Lock: std::mutex 또는 Common/Locks.hpp 의 락 (lock / unlock 을 가진 타입이면 무엇이든)
+template <typename Lock = std::mutex>
 struct StdThreadArgs
 {
-	std::mutex* totalMutex = nullptr;
+	AccumulateMode mode = AccumulateMode::GlobalLock;
+	Lock* totalMutex = nullptr;							 // GlobalLock, LocalPartial
+	std::atomic<long long>* atomicTotal = nullptr;		 // Atomic
+	CacheLinePadded<std::atomic<long long>>* shards = nullptr; // PaddedShards (스레드당 한 칸)
 	int max = 0;
 };
 
-void AccumulateStdThreadProc(StdThreadArgs* args)
+template <typename Lock = std::mutex>
+void AccumulateStdThreadProc(StdThreadArgs<Lock>* args, int index)
 {
-	for (int i = 1; i <= args->max; ++i)
+	TraceScope scope("AccumulateStdThreadProc", "lifecycle");
+	switch (args->mode)
 	{
-		std::lock_guard<std::mutex> lock(*args->totalMutex);
-		g_Total += i;
+	case AccumulateMode::GlobalLock:
+		for (int i = 1; i <= args->max; ++i)
+		{
+			std::lock_guard<Lock> lock(*args->totalMutex);
+			g_Total += i;
+		}
+		break;
+
+	case AccumulateMode::Atomic:
+		// 락은 없지만 모든 스레드가 같은 캐시 라인을 두고 경쟁합니다.
+		for (int i = 1; i <= args->max; ++i)
+			args->atomicTotal->fetch_add(i, std::memory_order_relaxed);
+		break;
+
+	case AccumulateMode::PaddedShards:
+	{
+		// 자기 슬롯은 자기만 쓰므로 load + store 로 충분합니다. (lock 접두사 없음)
+		// 슬롯이 캐시 라인 단위로 떨어져 있어 다른 스레드와 라인을 공유하지 않습니다.
+		std::atomic<long long>& shard = args->shards[index].value;
+		for (int i = 1; i <= args->max; ++i)
+			shard.store(shard.load(std::memory_order_relaxed) + i, std::memory_order_relaxed);
+		break;
 	}
+
+	case AccumulateMode::LocalPartial:
+	{
+		long long partial = 0;
+		for (int i = 1; i <= args->max; ++i)
+			partial += i;
+
+		// 공유 데이터에는 스레드당 한 번만 접근
+		std::lock_guard<Lock> lock(*args->totalMutex);
+		g_Total += partial;
+		break;
+	}
+	}
+}
+
+// pool == nullptr 이면 작업마다 std::thread 를 생성(spawn), 아니면 같은 작업을 풀에 제출합니다.
+// attrs 는 spawn 한 스레드가 시작하자마자 적용합니다. (풀 워커는 풀을 만들 때 받은 속성을 이미 적용)
+template <typename Lock = std::mutex>
+AccumulateReport RunAccumulateStd(AccumulateMode mode, int threadCount, int max, ThreadPool* pool = nullptr,
+	const ThreadAttributes& attrs = ThreadAttributes())
+{
+	g_Total = 0;
+	Lock totalMutex;
+	NameLock(totalMutex, std::string("totalMutex ") + AccumulateModeName(mode) + "/" + (pool ? "pool" : "spawn"));
+	std::atomic<long long> atomicTotal{ 0 };
+	std::vector<CacheLinePadded<std::atomic<long long>>> shards(
+		mode == AccumulateMode::PaddedShards ? threadCount : 0);
+
+	StdThreadArgs<Lock> args;
+	args.mode = mode;
+	args.totalMutex = &totalMutex;
+	args.atomicTotal = &atomicTotal;
+	args.shards = shards.data();
+	args.max = max;
+
+	ResetPeakRss();
+	StopWatch watch;
+	if (pool)
+	{
+		for (int t = 0; t < threadCount; ++t)
+			pool->Submit([&args, t] { AccumulateStdThreadProc<Lock>(&args, t); });
+		pool->WaitAll();
+	}
+	else
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+		for (int t = 0; t < threadCount; ++t)
+		{
+			if (attrs.IsDefault())
+				threads.emplace_back(&AccumulateStdThreadProc<Lock>, &args, t);
+			else
+				threads.emplace_back([&args, &attrs, t] {
+					ApplyThreadAttributes(attrs, static_cast<unsigned>(t));
+					AccumulateStdThreadProc<Lock>(&args, t);
+				});
+		}
+		for (auto& th : threads)
+			th.join();
+	}
+
+	// join 이후에는 워커가 모두 끝났으므로 락 없이 합산해도 안전합니다.
+	if (mode == AccumulateMode::Atomic)
+		g_Total = atomicTotal.load();
+	else if (mode == AccumulateMode::PaddedShards)
+		for (const auto& shard : shards)
+			g_Total += shard.value.load(std::memory_order_relaxed);
+
+	AccumulateReport report;
+	report.wallSec = watch.ElapsedSec();
+	report.peakRssKb = PeakRssKb();
+	report.exec = pool ? "pool" : "spawn";
+	report.mode = mode;
+	report.threadCount = threadCount;
+	report.workers = pool ? static_cast<int>(pool->Size()) : threadCount;
+	report.max = max;
+	report.expected = ExpectedTotal(threadCount, max);
+	report.total = g_Total;
+	return report;
 }
 
 
-int SMain()
+// SMain 에서 고른 락 타입으로 전략들을 실행합니다.
+template <typename Lock>
+int RunAccumulateModesStd(const std::string& modeName, bool runSpawn, bool runPool, int threadCount, int max, ThreadPool& pool,
+	const ThreadAttributes& attrs)
+{
+	PrintAccumulateHeader();
+	if (modeName == "all")
+	{
+		for (AccumulateMode mode : kAllAccumulateModes)
+		{
+			if (runSpawn)
+				PrintAccumulateReport(RunAccumulateStd<Lock>(mode, threadCount, max, nullptr, attrs));
+			if (runPool)
+				PrintAccumulateReport(RunAccumulateStd<Lock>(mode, threadCount, max, &pool));
+		}
+		return 0;
+	}
+
+	AccumulateMode mode;
+	if (!ParseAccumulateMode(modeName.c_str(), &mode))
+	{
+		std::cout << "unknown mode=" << modeName << "\n";
+		return 1;
+	}
+
+	AccumulateReport report;
+	if (runSpawn)
+		PrintAccumulateReport(report = RunAccumulateStd<Lock>(mode, threadCount, max, nullptr, attrs));
+	if (runPool)
+		PrintAccumulateReport(report = RunAccumulateStd<Lock>(mode, threadCount, max, &pool));
+	std::cout << "\nexpected=" << report.expected << "\n";
+	std::cout << "g_Total =" << report.total << "\n";
+	return 0;
+}
+
+// 인자
+// - mode=global-lock|atomic|padded-shards|local-partial|all (기본 all)
+// - exec=spawn|pool|both (기본 both: 같은 작업을 스레드 생성 방식과 풀 방식으로 나란히 실행)
+// - lock=std-mutex|ttas|ticket|mcs|adaptive (GlobalLock / LocalPartial 이 쓰는 락, 기본 std-mutex)
+// - threads=N (논리 작업 수, 기본 kThreadCount), max=N (기본 kMax)
+// - workers=N (풀 크기, 기본 hardware_concurrency)
+// - profile=1 : totalMutex 를 ProfiledLock 으로 감싸고, 끝날 때 락 경합 보고 출력 (Common/LockProfiler.hpp)
+// - trace=path : 작업 구간과 경합한 락 대기(TracedLock)를 Chrome trace 로 기록 (main 의 TraceSession)
+// - holdsample=N : profile=1 일 때 보유 시간을 N 번 획득에 한 번 잼 (기본 16)
+// - cpus=0-3,8 spread=1 node=N priority=low|high|... name=prefix : spawn 스레드와 풀 워커의 속성 (ThreadAttributes.hpp)
+int SMain(const LabArgs& cli)
 {
 	constexpr int kThreadCount = 10000;
 	constexpr int kMax = 10000;
 
-	g_Total = 0;
-	std::mutex totalMutex;
+	const int threadCount = static_cast<int>(cli.GetInt("threads", kThreadCount));
+	const int max = static_cast<int>(cli.GetInt("max", kMax));
+	const std::string modeName = cli.Get("mode", "all");
+	const std::string exec = cli.Get("exec", "both");
+	const bool runSpawn = (exec == "spawn" || exec == "both");
+	const bool runPool = (exec == "pool" || exec == "both");
+	if (!runSpawn && !runPool)
+	{
+		std::cout << "unknown exec=" << exec << "\n";
+		return 1;
+	}
 
-	StdThreadArgs args;
-	args.totalMutex = &totalMutex;
-	args.max = kMax;
+	const std::string lockName = cli.Get("lock", LockKindName(LockKind::StdMutex));
+	LockKind lockKind;
+	if (!ParseLockKind(lockName.c_str(), &lockKind))
+	{
+		std::cout << "unknown lock=" << lockName << "\n";
+		return 1;
+	}
 
-	std::cout << "02_MutualExclusion (std::thread + std::mutex)\n";
-	std::cout << "main tid=" << ::GetCurrentThreadId() << "\n";
+	const ThreadAttributes attrs = ParseThreadAttributes(cli);
+	ThreadPool pool(static_cast<unsigned>(cli.GetInt("workers", ThreadPool::DefaultThreadCount())), attrs);
 
-	std::thread threads[kThreadCount];
-	for (int t = 0; t < kThreadCount; ++t)
-		threads[t] = std::thread(&AccumulateStdThreadProc, &args);
-	for (auto& th : threads)
-		th.join();
+	std::cout << "02_MutualExclusion (std::thread + " << LockKindName(lockKind) << ")\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n";
+	std::cout << "hardware_concurrency=" << std::thread::hardware_concurrency() << "\n";
+	std::cout << "thread attributes: " << DescribeThreadAttributes(attrs) << "\n\n";
 
-	const long long expectedPerThread = (static_cast<long long>(kMax) * (kMax + 1)) / 2;
-	const long long expected = expectedPerThread * kThreadCount;
+	// 프로파일과 트레이스 중 하나라도 켜져 있으면 락을 감쌉니다. (꺼진 쪽은 감싼 락을 그대로 호출)
+	const bool profile = cli.GetInt("profile", 0) != 0;
+	LockProfiler::Instance().SetEnabled(profile);
+	LockProfiler::Instance().SetHoldSampleEvery(static_cast<unsigned>(cli.GetInt("holdsample", 16)));
 
-	std::cout << "expected=" << expected << "\n";
-	std::cout << "g_Total =" << g_Total << "\n";
-	return 0;
-}
\ No newline at end of file
+	const int result = VisitLockKind(lockKind, [&](auto tag) {
+		using Lock = typename decltype(tag)::Type;
+		if (profile || TraceEnabled())
+			return RunAccumulateModesStd<ProfiledLock<TracedLock<Lock>>>(modeName, runSpawn, runPool, threadCount, max, pool, attrs);
+		return RunAccumulateModesStd<Lock>(modeName, runSpawn, runPool, threadCount, max, pool, attrs);
+	});
+	if (profile)
+	{
+		std::cout << "\n";
+		LockProfiler::Instance().Report(std::cout);
+	}
+	return result;
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+// 02_MutualExclusion - 토폴로지별 경쟁 누적 (mode=topology)
+//
+// 같은 락 / 같은 카운터를 두고 경쟁하는 스레드들을 어디에 고정(pin)하느냐에 따라
+// 캐시 라인이 오가는 거리가 달라집니다.
+//
+// - same-cpu     : 모두 논리 CPU 하나에. 라인 이동은 없고 대신 시분할(문맥 교환)로 번갈아 실행
+// - smt          : 한 물리 코어의 SMT 형제들에. L1 / L2 를 공유
+// - same-socket  : 한 소켓 안의 서로 다른 물리 코어에. LLC(L3) 를 거쳐 이동
+// - cross-socket : 소켓을 번갈아. 소켓 간 인터커넥트(QPI / UPI / Infinity Fabric)를 거쳐 이동
+//
+// 스레드는 시작하자마자 ApplyThreadAttributes(spread) 로 자기 CPU 에 고정한 뒤,
+// lock -> ++counter -> (직전 소유자가 다른 스레드면 handoff + 1) -> unlock 을 ms 동안 반복합니다.
+// handoff/sec 가 높을수록 라인이 자주 이동한 것이고, ns/op 차이가 곧 "거리" 의 비용입니다.
+// 이 머신에 없는 배치(예: 소켓이 하나뿐인데 cross-socket)는 n/a 로 표시합니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/CacheLine.hpp"
+#include "../Common/ThreadAttributes.hpp"
+#include "../Common/Timing.hpp"
+#include "LockKind.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+enum class TopologyPlacement
+{
+	SameCpu,
+	Smt,
+	SameSocket,
+	CrossSocket,
+};
+
+constexpr TopologyPlacement kAllTopologyPlacements[] = {
+	TopologyPlacement::SameCpu,
+	TopologyPlacement::Smt,
+	TopologyPlacement::SameSocket,
+	TopologyPlacement::CrossSocket,
+};
+
+inline const char* TopologyPlacementName(TopologyPlacement p)
+{
+	switch (p)
+	{
+	case TopologyPlacement::SameCpu:     return "same-cpu";
+	case TopologyPlacement::Smt:         return "smt";
+	case TopologyPlacement::SameSocket:  return "same-socket";
+	case TopologyPlacement::CrossSocket: return "cross-socket";
+	}
+	return "?";
+}
+
+// 배치에 쓸 CPU 목록 (스레드 i 는 cpus[i % n]). 이 머신에서 만들 수 없는 배치면 빈 목록
+inline std::vector<unsigned> PlacementCpus(TopologyPlacement placement, const std::vector<CpuInfo>& topo)
+{
+	std::vector<unsigned> out;
+	if (topo.empty())
+		return out;
+
+	switch (placement)
+	{
+	case TopologyPlacement::SameCpu:
+		out.push_back(topo[0].cpu);
+		break;
+
+	case TopologyPlacement::Smt:
+	{
+		// 논리 CPU 가 둘 이상인 첫 물리 코어
+		std::map<int, std::vector<unsigned>> byCore;
+		for (const CpuInfo& c : topo)
+			byCore[c.core].push_back(c.cpu);
+		for (const auto& entry : byCore)
+		{
+			if (entry.second.size() >= 2)
+				return entry.second;
+		}
+		break;
+	}
+
+	case TopologyPlacement::SameSocket:
+	{
+		// 물리 코어가 둘 이상인 첫 소켓에서 코어마다 논리 CPU 하나씩
+		std::map<int, std::map<int, unsigned>> byPackage;
+		for (const CpuInfo& c : topo)
+			byPackage[c.package].emplace(c.core, c.cpu);
+		for (const auto& entry : byPackage)
+		{
+			if (entry.second.size() < 2)
+				continue;
+			for (const auto& core : entry.second)
+				out.push_back(core.second);
+			return out;
+		}
+		break;
+	}
+
+	case TopologyPlacement::CrossSocket:
+	{
+		// 소켓마다 서로 다른 코어를 하나씩 꺼내 번갈아 나열: s0c0, s1c0, s0c1, s1c1, ...
+		std::map<int, std::vector<unsigned>> byPackage;
+		std::set<int> seenCores;
+		for (const CpuInfo& c : topo)
+		{
+			if (seenCores.insert(c.core).second)
+				byPackage[c.package].push_back(c.cpu);
+		}
+		if (byPackage.size() < 2)
+			break;
+		for (std::size_t i = 0;; ++i)
+		{
+			bool any = false;
+			for (const auto& entry : byPackage)
+			{
+				if (i < entry.second.size())
+				{
+					out.push_back(entry.second[i]);
+					any = true;
+				}
+			}
+			if (!any)
+				break;
+		}
+		break;
+	}
+	}
+	return out;
+}
+
+struct TopologyShared
+{
+	alignas(kCacheLineSize) long long counter = 0;
+	int owner = -1;                          // 마지막으로 counter 를 올린 스레드 (락 안에서만 접근)
+	alignas(kCacheLineSize) std::atomic<long long> atomicCounter{ 0 };
+	alignas(kCacheLineSize) std::atomic<int> ready{ 0 };
+	std::atomic<bool> go{ false };
+	std::atomic<bool> stop{ false };
+};
+
+struct TopologyThreadResult
+{
+	long long ops = 0;
+	long long handoffs = 0;
+	bool pinned = false;
+};
+
+struct TopologyCellResult
+{
+	double sec = 0.0;
+	long long ops = 0;
+	long long handoffs = -1; // atomic 은 소유자를 알 수 없음
+	bool pinned = true;
+	bool ok = true;
+};
+
+// Lock == void 이면 락 없이 atomic fetch_add
+template <typename Lock>
+void TopologyThreadProc(TopologyShared* shared, Lock* lock, const ThreadAttributes* attrs, int index, TopologyThreadResult* result)
+{
+	result->pinned = ApplyThreadAttributes(*attrs, static_cast<unsigned>(index));
+	shared->ready.fetch_add(1);
+	while (!shared->go.load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	long long ops = 0;
+	long long handoffs = 0;
+	while (!shared->stop.load(std::memory_order_relaxed))
+	{
+		if constexpr (std::is_void_v<Lock>)
+		{
+			shared->atomicCounter.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			lock->lock();
+			if (shared->owner != index)
+			{
+				shared->owner = index;
+				++handoffs;
+			}
+			++shared->counter;
+			lock->unlock();
+		}
+		++ops;
+	}
+	result->ops = ops;
+	result->handoffs = handoffs;
+}
+
+template <typename Lock>
+TopologyCellResult RunTopologyCell(const std::vector<unsigned>& cpus, int threadCount, unsigned durationMs)
+{
+	struct Empty {};
+	using LockStorage = std::conditional_t<std::is_void_v<Lock>, Empty, Lock>;
+	alignas(kCacheLineSize) LockStorage lockStorage;
+	Lock* lock = nullptr;
+	if constexpr (!std::is_void_v<Lock>)
+		lock = &lockStorage;
+
+	ThreadAttributes attrs;
+	attrs.cpus = cpus;
+	attrs.spread = true;
+	attrs.name = "topo";
+
+	TopologyShared shared;
+	std::vector<TopologyThreadResult> results(threadCount);
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (int t = 0; t < threadCount; ++t)
+		threads.emplace_back(&TopologyThreadProc<Lock>, &shared, lock, &attrs, t, &results[t]);
+
+	while (shared.ready.load() != threadCount)
+		std::this_thread::yield();
+	StopWatch watch;
+	shared.go.store(true, std::memory_order_release);
+	std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+	shared.stop.store(true, std::memory_order_relaxed);
+	for (auto& th : threads)
+		th.join();
+
+	TopologyCellResult cell;
+	cell.sec = watch.ElapsedSec();
+	long long handoffs = 0;
+	for (const auto& r : results)
+	{
+		cell.ops += r.ops;
+		handoffs += r.handoffs;
+		cell.pinned = cell.pinned && r.pinned;
+	}
+	if constexpr (std::is_void_v<Lock>)
+	{
+		cell.ok = shared.atomicCounter.load() == cell.ops;
+	}
+	else
+	{
+		cell.handoffs = handoffs;
+		cell.ok = shared.counter == cell.ops;
+	}
+	return cell;
+}
+
+inline std::string FormatCpuList(const std::vector<unsigned>& cpus, int threadCount)
+{
+	std::string out;
+	for (int t = 0; t < threadCount && !cpus.empty(); ++t)
+	{
+		if (t)
+			out += ',';
+		out += std::to_string(cpus[t % cpus.size()]);
+	}
+	return out;
+}
+
+inline void PrintTopologySummary(const std::vector<CpuInfo>& topo)
+{
+	std::set<int> cores;
+	std::set<int> packages;
+	std::set<int> nodes;
+	for (const CpuInfo& c : topo)
+	{
+		cores.insert(c.core);
+		packages.insert(c.package);
+		nodes.insert(c.node);
+	}
+	std::cout << "topology: cpus=" << topo.size() << " cores=" << cores.size()
+		<< " packages=" << packages.size() << " numa-nodes=" << nodes.size() << "\n";
+}
+
+// 인자
+// - lock=std-mutex|ttas|ticket|mcs|adaptive|atomic (기본 std-mutex, atomic 은 락 없이 fetch_add)
+// - threads=N : 경쟁하는 스레드 수 (기본 2)
+// - ms=N      : 배치 하나당 측정 시간 (기본 200)
+int TopologyMain(const LabArgs& cli)
+{
+	const std::string lockName = cli.Get("lock", LockKindName(LockKind::StdMutex));
+	const bool atomic = lockName == "atomic";
+	LockKind lockKind = LockKind::StdMutex;
+	if (!atomic && !ParseLockKind(lockName.c_str(), &lockKind))
+	{
+		std::cout << "unknown lock=" << lockName << "\n";
+		return 1;
+	}
+	const int threadCount = static_cast<int>(std::max(1LL, cli.GetInt("threads", 2)));
+	const unsigned durationMs = static_cast<unsigned>(cli.GetInt("ms", 200));
+
+	const std::vector<CpuInfo> topo = ReadCpuTopology();
+	std::cout << "02_MutualExclusion (contended accumulation by placement, lock=" << lockName
+		<< ", threads=" << threadCount << ", ms=" << durationMs << ")\n";
+	PrintTopologySummary(topo);
+	std::cout << "\n" << std::left
+		<< std::setw(14) << "placement"
+		<< std::setw(16) << "cpus"
+		<< std::setw(13) << "ops/sec"
+		<< std::setw(10) << "ns/op"
+		<< std::setw(14) << "handoff/sec"
+		<< "check\n";
+
+	for (TopologyPlacement placement : kAllTopologyPlacements)
+	{
+		const std::vector<unsigned> cpus = PlacementCpus(placement, topo);
+		std::cout << std::left << std::setw(14) << TopologyPlacementName(placement);
+		if (cpus.empty())
+		{
+			std::cout << "n/a (not available on this machine)\n";
+			continue;
+		}
+
+		TopologyCellResult cell;
+		if (atomic)
+		{
+			cell = RunTopologyCell<void>(cpus, threadCount, durationMs);
+		}
+		else
+		{
+			cell = VisitLockKind(lockKind, [&](auto tag) {
+				using Lock = typename decltype(tag)::Type;
+				return RunTopologyCell<Lock>(cpus, threadCount, durationMs);
+			});
+		}
+
+		const std::ios::fmtflags flags = std::cout.flags();
+		std::cout << std::setw(16) << FormatCpuList(cpus, threadCount)
+			<< std::setw(13) << std::scientific << std::setprecision(3) << cell.ops / cell.sec
+			<< std::setw(10) << std::fixed << std::setprecision(1) << (cell.ops > 0 ? cell.sec * 1e9 / cell.ops : 0.0)
+			<< std::setw(14) << (cell.handoffs < 0 ? std::string("-") : std::to_string(static_cast<long long>(cell.handoffs / cell.sec)))
+			<< (cell.ok ? "ok" : "MISMATCH") << (cell.pinned ? "" : " (pin failed)") << "\n";
+		std::cout.flags(flags);
+	}
+
+	std::cout << "\nns/op = measured time / total increments (all threads), handoff = counter owner changed between threads\n";
+	return 0;
+}
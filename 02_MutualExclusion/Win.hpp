@@ -5,74 +5,343 @@
 
 #include <process.h> // _beginthreadex
 
+#include "../Common/Args.hpp"
+#include "../Common/CacheLine.hpp"
+#include "../Common/LockProfiler.hpp"
+#include "../Common/ProcessStats.hpp"
+#include "../Common/ThreadAttributes.hpp"
+#include "../Common/Timing.hpp"
+#include "../Common/Trace.hpp"
+#include "AccumulateMode.hpp"
+
 #include <cerrno>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 extern long long g_Total;
 
 
 struct WinThreadArgs
 {
-	CRITICAL_SECTION* cs = nullptr;
+	AccumulateMode mode = AccumulateMode::GlobalLock;
+	CRITICAL_SECTION* cs = nullptr;						 // GlobalLock, LocalPartial
+	ProfiledLock<TracedLock<WinCriticalSection>>* profiledCs = nullptr; // profile=1 또는 trace= 이면 cs 대신 사용
+	volatile LONG64* interlockedTotal = nullptr;		 // Atomic
+	CacheLinePadded<volatile LONG64>* shard = nullptr;	 // PaddedShards (이 스레드 전용 슬롯)
 	int max = 0;
+	const ThreadAttributes* attrs = nullptr;			 // _beginthreadex 스레드만 (풀 스레드는 OS 소유라 건드리지 않음)
+	unsigned index = 0;
 };
 
 unsigned __stdcall AccumulateWinThreadProc(void* param)
 {
 	const auto* args = static_cast<const WinThreadArgs*>(param);
-	for (int i = 1; i <= args->max; ++i)
+	if (args->attrs)
+		ApplyThreadAttributes(*args->attrs, args->index);
+	TraceScope scope("AccumulateWinThreadProc", "lifecycle");
+	switch (args->mode)
+	{
+	case AccumulateMode::GlobalLock:
+		if (args->profiledCs)
+		{
+			for (int i = 1; i <= args->max; ++i)
+			{
+				std::lock_guard<ProfiledLock<TracedLock<WinCriticalSection>>> lock(*args->profiledCs);
+				g_Total += i;
+			}
+			break;
+		}
+		for (int i = 1; i <= args->max; ++i)
+		{
+			::EnterCriticalSection(args->cs);
+			g_Total += i;
+			::LeaveCriticalSection(args->cs);
+		}
+		break;
+
+	case AccumulateMode::Atomic:
+		for (int i = 1; i <= args->max; ++i)
+			::InterlockedExchangeAdd64(args->interlockedTotal, i);
+		break;
+
+	case AccumulateMode::PaddedShards:
+		// volatile 이므로 매 반복 메모리에 기록되지만, 슬롯이 캐시 라인 단위로 떨어져 있어 경쟁이 없습니다.
+		for (int i = 1; i <= args->max; ++i)
+			args->shard->value += i;
+		break;
+
+	case AccumulateMode::LocalPartial:
 	{
+		long long partial = 0;
+		for (int i = 1; i <= args->max; ++i)
+			partial += i;
+
+		if (args->profiledCs)
+		{
+			std::lock_guard<ProfiledLock<TracedLock<WinCriticalSection>>> lock(*args->profiledCs);
+			g_Total += partial;
+			break;
+		}
 		::EnterCriticalSection(args->cs);
-		g_Total += i;
+		g_Total += partial;
 		::LeaveCriticalSection(args->cs);
+		break;
+	}
 	}
 	return 0;
 }
 
+// 풀 실행용 콜백: 스레드 함수와 같은 작업을 Windows 스레드 풀 워커에서 실행합니다.
+VOID CALLBACK AccumulateWinPoolCallback(PTP_CALLBACK_INSTANCE, PVOID param)
+{
+	AccumulateWinThreadProc(param);
+}
 
-int WMain()
+// Windows 스레드 풀 (Vista+) - 워커 수를 고정한 전용 풀
+// - 작업 제출: TrySubmitThreadpoolCallback
+// - 전체 대기: cleanup group 의 CloseThreadpoolCleanupGroupMembers
+struct WinPool
 {
-	constexpr int kThreadCount = 10000;
-	constexpr int kMax = 10000;
+	PTP_POOL pool = nullptr;
+	TP_CALLBACK_ENVIRON env{};
+	DWORD workers = 0;
+};
+
+bool CreateWinPool(WinPool* wp, DWORD workers)
+{
+	wp->pool = ::CreateThreadpool(nullptr);
+	if (wp->pool == nullptr)
+		return false;
+	::SetThreadpoolThreadMaximum(wp->pool, workers);
+	if (!::SetThreadpoolThreadMinimum(wp->pool, workers))
+	{
+		::CloseThreadpool(wp->pool);
+		wp->pool = nullptr;
+		return false;
+	}
+	::InitializeThreadpoolEnvironment(&wp->env);
+	::SetThreadpoolCallbackPool(&wp->env, wp->pool);
+	wp->workers = workers;
+	return true;
+}
+
+void DestroyWinPool(WinPool* wp)
+{
+	::DestroyThreadpoolEnvironment(&wp->env);
+	::CloseThreadpool(wp->pool);
+	wp->pool = nullptr;
+}
+
+// WaitForMultipleObjects는 한 번에 MAXIMUM_WAIT_OBJECTS(64)개까지만 기다릴 수 있으므로 나눠서 기다립니다.
+void WaitForAllHandles(const std::vector<HANDLE>& handles)
+{
+	for (size_t offset = 0; offset < handles.size(); offset += MAXIMUM_WAIT_OBJECTS)
+	{
+		const size_t rest = handles.size() - offset;
+		const DWORD count = static_cast<DWORD>(rest < MAXIMUM_WAIT_OBJECTS ? rest : MAXIMUM_WAIT_OBJECTS);
+		::WaitForMultipleObjects(count, handles.data() + offset, TRUE, INFINITE);
+	}
+}
+
+// 실패 시 report.threadCount == 0
+// pool == nullptr 이면 작업마다 _beginthreadex, 아니면 같은 작업을 Windows 스레드 풀에 제출합니다.
+// profile 또는 트레이스 중이면 cs 대신 ProfiledLock<TracedLock<WinCriticalSection>> 을 씁니다. (LockProfiler.hpp, Trace.hpp)
+AccumulateReport RunAccumulateWin(AccumulateMode mode, int threadCount, int max, WinPool* pool = nullptr,
+	const ThreadAttributes& attrs = ThreadAttributes(), bool profile = false)
+{
+	AccumulateReport report;
+	report.exec = pool ? "pool" : "spawn";
+	report.mode = mode;
+	report.max = max;
+	report.expected = ExpectedTotal(threadCount, max);
 
 	g_Total = 0;
 	CRITICAL_SECTION cs;
 	::InitializeCriticalSection(&cs);
+	std::unique_ptr<ProfiledLock<TracedLock<WinCriticalSection>>> profiledCs;
+	if (profile || TraceEnabled())
+		profiledCs = std::make_unique<ProfiledLock<TracedLock<WinCriticalSection>>>(
+			std::string("cs ") + AccumulateModeName(mode) + "/" + (pool ? "pool" : "spawn"));
+	volatile LONG64 interlockedTotal = 0;
+	std::vector<CacheLinePadded<volatile LONG64>> shards(threadCount);
 
-	WinThreadArgs args;
-	args.cs = &cs;
-	args.max = kMax;
+	std::vector<WinThreadArgs> args(threadCount);
+	for (int t = 0; t < threadCount; ++t)
+	{
+		args[t].mode = mode;
+		args[t].cs = &cs;
+		args[t].profiledCs = profiledCs.get();
+		args[t].interlockedTotal = &interlockedTotal;
+		args[t].shard = &shards[t];
+		args[t].max = max;
+		args[t].attrs = (pool || attrs.IsDefault()) ? nullptr : &attrs;
+		args[t].index = static_cast<unsigned>(t);
+	}
 
-	std::cout << "02_MutualExclusion (WinAPI _beginthreadex + CRITICAL_SECTION)\n";
-	std::cout << "main tid=" << ::GetCurrentThreadId() << "\n";
+	if (pool)
+	{
+		PTP_CLEANUP_GROUP group = ::CreateThreadpoolCleanupGroup();
+		if (group == nullptr)
+		{
+			std::cout << "CreateThreadpoolCleanupGroup failed. GetLastError=" << ::GetLastError() << "\n";
+			::DeleteCriticalSection(&cs);
+			return report;
+		}
+		TP_CALLBACK_ENVIRON env = pool->env;
+		::SetThreadpoolCallbackCleanupGroup(&env, group, nullptr);
+
+		StopWatch watch;
+		for (int t = 0; t < threadCount; ++t)
+		{
+			if (!::TrySubmitThreadpoolCallback(&AccumulateWinPoolCallback, &args[t], &env))
+			{
+				std::cout << "TrySubmitThreadpoolCallback failed. GetLastError=" << ::GetLastError() << "\n";
+				::CloseThreadpoolCleanupGroupMembers(group, FALSE, nullptr);
+				::CloseThreadpoolCleanupGroup(group);
+				::DeleteCriticalSection(&cs);
+				return report;
+			}
+		}
+		// 그룹에 제출된 콜백이 모두 끝날 때까지 대기 (WaitAll)
+		::CloseThreadpoolCleanupGroupMembers(group, FALSE, nullptr);
+		::CloseThreadpoolCleanupGroup(group);
+		::DeleteCriticalSection(&cs);
 
-	HANDLE threads[kThreadCount] = {};
-	unsigned tids[kThreadCount] = {};
+		if (mode == AccumulateMode::Atomic)
+			g_Total = interlockedTotal;
+		else if (mode == AccumulateMode::PaddedShards)
+			for (const auto& shard : shards)
+				g_Total += shard.value;
 
-	for (int t = 0; t < kThreadCount; ++t)
+		report.wallSec = watch.ElapsedSec();
+		report.peakRssKb = PeakRssKb();
+		report.threadCount = threadCount;
+		report.workers = static_cast<int>(pool->workers);
+		report.total = g_Total;
+		return report;
+	}
+
+	std::vector<HANDLE> threads;
+	threads.reserve(threadCount);
+
+	StopWatch watch;
+	for (int t = 0; t < threadCount; ++t)
 	{
-		const uintptr_t h = _beginthreadex(nullptr, 0, &AccumulateWinThreadProc, &args, 0, &tids[t]);
-		threads[t] = reinterpret_cast<HANDLE>(h);
-		if (threads[t] == nullptr)
+		unsigned tid = 0;
+		const uintptr_t h = _beginthreadex(nullptr, 0, &AccumulateWinThreadProc, &args[t], 0, &tid);
+		if (h == 0)
 		{
 			std::cout << "_beginthreadex failed. errno=" << errno << "\n";
-			for (int i = 0; i < t; ++i)
-				::CloseHandle(threads[i]);
+			WaitForAllHandles(threads);
+			for (HANDLE created : threads)
+				::CloseHandle(created);
 			::DeleteCriticalSection(&cs);
-			return 1;
+			return report;
 		}
+		threads.push_back(reinterpret_cast<HANDLE>(h));
 	}
 
-	::WaitForMultipleObjects(kThreadCount, threads, TRUE, INFINITE);
+	WaitForAllHandles(threads);
 	for (HANDLE h : threads)
 		::CloseHandle(h);
 	::DeleteCriticalSection(&cs);
 
-	const long long expectedPerThread = (static_cast<long long>(kMax) * (kMax + 1)) / 2;
-	const long long expected = expectedPerThread * kThreadCount;
+	if (mode == AccumulateMode::Atomic)
+		g_Total = interlockedTotal;
+	else if (mode == AccumulateMode::PaddedShards)
+		for (const auto& shard : shards)
+			g_Total += shard.value;
 
-	std::cout << "expected=" << expected << "\n";
-	std::cout << "g_Total =" << g_Total << "\n";
-	return 0;
+	report.wallSec = watch.ElapsedSec();
+	report.peakRssKb = PeakRssKb();
+	report.threadCount = threadCount;
+	report.workers = threadCount;
+	report.total = g_Total;
+	return report;
 }
 
+
+// 인자는 SMain과 같습니다. (mode=..., exec=spawn|pool|both, threads=N, max=N, workers=N, profile=1, holdsample=N, trace=path)
+// 스레드 속성(cpus=, spread=, node=, priority=, name=)은 _beginthreadex 스레드에만 적용합니다.
+int WMain(const LabArgs& cli)
+{
+	constexpr int kThreadCount = 10000;
+	constexpr int kMax = 10000;
+
+	const int threadCount = static_cast<int>(cli.GetInt("threads", kThreadCount));
+	const int max = static_cast<int>(cli.GetInt("max", kMax));
+	const std::string modeName = cli.Get("mode", "all");
+	const std::string exec = cli.Get("exec", "both");
+	const bool runSpawn = (exec == "spawn" || exec == "both");
+	const bool runPool = (exec == "pool" || exec == "both");
+	if (!runSpawn && !runPool)
+	{
+		std::cout << "unknown exec=" << exec << "\n";
+		return 1;
+	}
+
+	AccumulateMode mode = AccumulateMode::GlobalLock;
+	if (modeName != "all" && !ParseAccumulateMode(modeName.c_str(), &mode))
+	{
+		std::cout << "unknown mode=" << modeName << "\n";
+		return 1;
+	}
+
+	SYSTEM_INFO si;
+	::GetSystemInfo(&si);
+	WinPool pool;
+	if (!CreateWinPool(&pool, static_cast<DWORD>(cli.GetInt("workers", si.dwNumberOfProcessors))))
+	{
+		std::cout << "CreateThreadpool failed. GetLastError=" << ::GetLastError() << "\n";
+		return 1;
+	}
+
+	std::cout << "02_MutualExclusion (WinAPI _beginthreadex + CRITICAL_SECTION)\n";
+	const ThreadAttributes attrs = ParseThreadAttributes(cli);
+	std::cout << "main tid=" << ::GetCurrentThreadId() << "\n";
+	std::cout << "thread attributes: " << DescribeThreadAttributes(attrs) << "\n\n";
+
+	const bool profile = cli.GetInt("profile", 0) != 0;
+	LockProfiler::Instance().SetEnabled(profile);
+	LockProfiler::Instance().SetHoldSampleEvery(static_cast<unsigned>(cli.GetInt("holdsample", 16)));
+
+	PrintAccumulateHeader();
+	AccumulateReport report;
+	for (AccumulateMode m : kAllAccumulateModes)
+	{
+		if (modeName != "all" && m != mode)
+			continue;
+		if (runSpawn)
+		{
+			report = RunAccumulateWin(m, threadCount, max, nullptr, attrs, profile);
+			if (report.threadCount == 0)
+				break;
+			PrintAccumulateReport(report);
+		}
+		if (runPool)
+		{
+			report = RunAccumulateWin(m, threadCount, max, &pool, ThreadAttributes(), profile);
+			if (report.threadCount == 0)
+				break;
+			PrintAccumulateReport(report);
+		}
+	}
+	DestroyWinPool(&pool);
+
+	if (profile)
+	{
+		std::cout << "\n";
+		LockProfiler::Instance().Report(std::cout);
+	}
+	if (report.threadCount == 0)
+		return 1;
+	if (modeName == "all")
+		return 0;
+
+	std::cout << "\nexpected=" << report.expected << "\n";
+	std::cout << "g_Total =" << report.total << "\n";
+	return 0;
+}
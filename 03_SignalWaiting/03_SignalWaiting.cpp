@@ -1,8 +1,56 @@
-#include "Win.hpp"
 #include "Std.hpp"
+#ifdef _WIN32
+#include "Win.hpp"
+#endif
+#include "GateBench.hpp"
+#include "CoTickTock.hpp"
+#include "CoBench.hpp"
+#include "TimerTickTock.hpp"
+#include "TimerBench.hpp"
+#include "BroadcastBench.hpp"
+#if !defined(_WIN32)
+#include "InputBench.hpp"
+#endif
 
-int main()
+// 예) 03_SignalWaiting gate=rungate
+//     03_SignalWaiting mode=gate-bench ms=1000
+//     03_SignalWaiting mode=coroutine pool=2   (Tick/Tock 코루틴)
+//     03_SignalWaiting mode=coro-bench workers=1,100,10000
+//     03_SignalWaiting mode=timer              (Tick/Tock, 키보드 확인을 타이머 휠 콜백으로)
+//     03_SignalWaiting mode=timer-bench timers=1,1000,100000
+//     03_SignalWaiting mode=broadcast-bench workers=1,16,256,1024
+//     03_SignalWaiting mode=input-bench commands=100   (Linux: 30ms 폴링 vs 입력 대기 집합)
+//     03_SignalWaiting api=win          (Windows: Event 버전)
+//     03_SignalWaiting gate=epoch workers=4 trace=trace.json   (대기 / 깨어남을 타임라인으로)
+//     03_SignalWaiting gate=epoch workers=64 logpolicy=drop   (로그 큐가 가득 차면 줄을 버림)
+int main(int argc, char** argv)
 {
-	SMain();
-	return 0;
-}
\ No newline at end of file
+	const LabArgs cli(argc, argv);
+	TraceSession trace(cli);
+	const std::string mode = cli.Get("mode", "");
+	if (mode == "gate-bench")
+		return GateBenchMain(cli);
+	if (mode == "coroutine")
+		return CoTickTockMain(cli);
+	if (mode == "coro-bench")
+		return CoBenchMain(cli);
+	if (mode == "timer")
+		return TimerTickTockMain(cli);
+	if (mode == "timer-bench")
+		return TimerBenchMain(cli);
+	if (mode == "broadcast-bench")
+		return BroadcastBenchMain(cli);
+#if !defined(_WIN32)
+	if (mode == "input-bench")
+		return InputBenchMain(cli);
+#endif
+
+	// Tick/Tock 워커의 출력은 비동기 로그 싱크로 씁니다. (벤치 모드는 표를 std::cout 에 바로 씀)
+	AsyncLogSession log(cli);
+#ifdef _WIN32
+	if (cli.Get("api", "") == "win")
+		return WMain();
+#endif
+
+	return SMain(cli);
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+// 03_SignalWaiting - N 워커 일괄 Pause / Resume (mode=broadcast-bench)
+//
+// 워커 N개가 짧은 작업(work) + 잠깐 쉬기(sleep) 와 게이트 통과를 반복하는 중에, 컨트롤러가 rounds 번 Pause / Resume 합니다.
+// (sleep=0 이면 CPU 를 계속 쓰는 워커. 코어보다 워커가 많으면 깨어난 워커가 실행 차례를 기다리느라 resume 이 길어집니다)
+// 두 구성 모두 "모든 워커가 실제로 멈췄다 / 다시 돈다" 는 확인(ack)을 받은 뒤에야 Pause / Resume 이 끝납니다.
+// - cv    : StdThreadControl 을 N 워커로 넓힌 형태. 반복마다 mutex + condition_variable, Resume 은 notify_all,
+//           ack 는 같은 mutex 아래 카운터 + 컨트롤러용 condition_variable
+// - epoch : EpochGate. 실행 중에는 atomic load 한 번, Resume 은 epoch 워드에 FutexWakeAll, ack 는 atomic 카운터
+//
+// 측정
+// - quiesce : Pause() 호출 -> 마지막 워커가 멈췄다고 ack 하기까지
+// - resume  : Resume() 호출 -> 마지막 워커가 깨어나 ack 하기까지 (wake storm 비용)
+
+#include "../Common/Args.hpp"
+#include "../Common/EpochGate.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+struct BroadcastBenchResult
+{
+	bool ok = false; // 스레드를 모두 만들지 못하면 false
+	unsigned created = 0;
+	LatencySummary quiesceNs;
+	LatencySummary resumeNs;
+};
+
+struct BroadcastWorkload
+{
+	int iterations = 0;  // 최적화로 사라지지 않는 짧은 계산 반복 수
+	int sleepUs = 0;     // 계산 뒤 쉬는 시간 (I/O 나 타이머를 기다리는 워커 흉내)
+};
+
+// 게이트 사이의 작업
+inline void BroadcastWork(const BroadcastWorkload& work)
+{
+	volatile std::uint64_t x = 0;
+	for (int i = 0; i < work.iterations; ++i)
+		x = x + static_cast<std::uint64_t>(i);
+	if (work.sleepUs > 0)
+		std::this_thread::sleep_for(std::chrono::microseconds(work.sleepUs));
+}
+
+// cv 구성: StdThreadControl + 세대 번호 + ack 카운터
+struct CvBroadcastControl
+{
+	std::mutex m;
+	std::condition_variable cv;    // 워커가 Resume / 종료를 기다림
+	std::condition_variable ackCv; // 컨트롤러가 ack 를 기다림
+	bool paused = false;
+	bool exitRequested = false;
+	unsigned generation = 0;
+	unsigned acks = 0;
+	unsigned workers = 0;
+
+	void Pause() { Advance(true); }
+	void Resume() { Advance(false); }
+
+	void Advance(bool pause)
+	{
+		std::unique_lock<std::mutex> lock(m);
+		paused = pause;
+		++generation;
+		acks = 0;
+		if (!pause)
+			cv.notify_all(); // 잠든 N개가 모두 깨어나 같은 mutex 로 몰림
+		ackCv.wait(lock, [&] { return acks == workers; });
+	}
+
+	void RequestExit()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m);
+			exitRequested = true;
+		}
+		cv.notify_all();
+	}
+};
+
+void CvBroadcastWorker(CvBroadcastControl& c, const BroadcastWorkload& work)
+{
+	unsigned seen = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(c.m);
+			while (true)
+			{
+				if (c.exitRequested)
+					return;
+				if (c.generation != seen)
+				{
+					seen = c.generation;
+					if (++c.acks == c.workers)
+						c.ackCv.notify_one();
+				}
+				if (!c.paused)
+					break;
+				c.cv.wait(lock);
+			}
+		}
+		BroadcastWork(work);
+	}
+}
+
+void EpochBroadcastWorker(EpochGate& gate, const BroadcastWorkload& work)
+{
+	std::uint32_t seen = EpochGate::Start();
+	while (gate.Pass(seen))
+		BroadcastWork(work);
+}
+
+// Controller: Pause() / Resume() 가 ack 까지 기다리는 CvBroadcastControl 또는 EpochGate
+template <typename Controller, typename WorkerFn>
+BroadcastBenchResult RunBroadcastRounds(Controller& control, int workers, int rounds, WorkerFn workerFn)
+{
+	BroadcastBenchResult r;
+	std::vector<std::thread> threads;
+	threads.reserve(workers);
+	try
+	{
+		for (int i = 0; i < workers; ++i)
+			threads.emplace_back(workerFn);
+	}
+	catch (const std::system_error&)
+	{
+		// 만든 워커만으로는 ack 가 N 에 닿지 않으므로 측정하지 않고 끝냅니다.
+		control.RequestExit();
+		for (auto& th : threads)
+			th.join();
+		r.created = static_cast<unsigned>(threads.size());
+		return r;
+	}
+
+	std::vector<std::int64_t> quiesce;
+	std::vector<std::int64_t> resumed;
+	quiesce.reserve(rounds);
+	resumed.reserve(rounds);
+	for (int round = 0; round < rounds; ++round)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(2)); // 워커들이 실행 중인 상태에서 시작
+		std::int64_t t0 = NowNs();
+		control.Pause();
+		quiesce.push_back(NowNs() - t0);
+
+		t0 = NowNs();
+		control.Resume();
+		resumed.push_back(NowNs() - t0);
+	}
+
+	control.RequestExit();
+	for (auto& th : threads)
+		th.join();
+	r.created = static_cast<unsigned>(workers);
+	r.quiesceNs = Summarize(quiesce);
+	r.resumeNs = Summarize(resumed);
+	r.ok = true;
+	return r;
+}
+
+BroadcastBenchResult RunCvBroadcast(int workers, int rounds, const BroadcastWorkload& work)
+{
+	CvBroadcastControl control;
+	control.workers = static_cast<unsigned>(workers);
+	return RunBroadcastRounds(control, workers, rounds, [&] { CvBroadcastWorker(control, work); });
+}
+
+BroadcastBenchResult RunEpochBroadcast(int workers, int rounds, const BroadcastWorkload& work)
+{
+	EpochGate gate(static_cast<unsigned>(workers));
+	return RunBroadcastRounds(gate, workers, rounds, [&] { EpochBroadcastWorker(gate, work); });
+}
+
+void PrintBroadcastRow(const char* impl, int workers, const BroadcastBenchResult& r)
+{
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left << std::setw(8) << impl << std::setw(9) << workers;
+	if (!r.ok)
+	{
+		std::cout << "failed to create threads (created " << r.created << ")\n";
+		return;
+	}
+	std::cout << std::fixed << std::setprecision(1)
+		<< std::setw(17) << r.quiesceNs.p50 / 1000.0
+		<< std::setw(17) << r.quiesceNs.max / 1000.0
+		<< std::setw(16) << r.resumeNs.p50 / 1000.0
+		<< r.resumeNs.max / 1000.0 << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - workers=1,4,16,64,256,1024 : 워커 수 목록
+// - rounds=N : Pause / Resume 반복 횟수 (기본 10)
+// - work=N   : 게이트 통과 사이의 계산 반복 수 (기본 2000)
+// - sleep=us : 계산 뒤 쉬는 시간 (기본 20000, 0 이면 쉬지 않음)
+int BroadcastBenchMain(const LabArgs& cli)
+{
+	std::vector<int> workerCounts = ParseIntList(cli.Get("workers", "1,4,16,64,256,1024"));
+	if (workerCounts.empty())
+	{
+		std::cout << "workers= needs a list like 1,16,256\n";
+		return 1;
+	}
+	const int rounds = static_cast<int>(std::max(1LL, cli.GetInt("rounds", 10)));
+	BroadcastWorkload work;
+	work.iterations = static_cast<int>(std::max(0LL, cli.GetInt("work", 2000)));
+	work.sleepUs = static_cast<int>(std::max(0LL, cli.GetInt("sleep", 20000)));
+
+	std::cout << "03_SignalWaiting (broadcast pause/resume with ack barrier, rounds=" << rounds << " work=" << work.iterations
+		<< " sleep=" << work.sleepUs << "us" << ", hardware_concurrency=" << std::thread::hardware_concurrency() << ")\n\n";
+	std::cout << std::left
+		<< std::setw(8) << "impl"
+		<< std::setw(9) << "workers"
+		<< std::setw(17) << "quiesce p50(us)"
+		<< std::setw(17) << "quiesce max(us)"
+		<< std::setw(16) << "resume p50(us)"
+		<< "resume max(us)\n";
+	for (int workers : workerCounts)
+	{
+		PrintBroadcastRow("cv", workers, RunCvBroadcast(workers, rounds, work));
+		PrintBroadcastRow("epoch", workers, RunEpochBroadcast(workers, rounds, work));
+	}
+
+	std::cout << "\nquiesce = Pause() until every worker acked it is parked, resume = Resume() until every worker acked it runs\n";
+	return 0;
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+// 03_SignalWaiting - 코루틴 vs 워커마다 스레드 (mode=coro-bench)
+//
+// Tick/Tock 워커 N개를 period 마다 깨웁니다. (출력 없이 ticks 번)
+// - thread    : 워커마다 std::thread + RunGate::Pass() + sleep_until
+// - coroutine : 워커마다 Task + co_await CoGate::Pass() + co_await SleepUntilNs, OS 스레드는 pool 개
+//
+// 측정
+// - rss/worker : 모든 워커가 시작한 뒤의 RSS 증가 / N (바이트) (스레드는 건드린 스택 페이지 + TLS, 커널 자료구조는 제외)
+// - frame      : 워커 하나가 쓰는 코루틴 프레임 바이트 (CoFrames)
+// - late       : 예정 시각보다 늦게 깨어난 정도 (deadline -> 실제로 다시 실행된 시각)
+// - cpu        : 생성부터 끝까지 프로세스 CPU 시간
+// - resume-all : 게이트에서 멈춰 있는 워커 N개를 Resume 한 뒤 마지막 워커가 통과하기까지
+
+#include "../Common/Args.hpp"
+#include "../Common/Coroutine.hpp"
+#include "../Common/ProcessStats.hpp"
+#include "../Common/RunGate.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+struct CoBenchResult
+{
+	bool ok = false; // 스레드를 모두 만들지 못하면 false
+	unsigned osThreads = 0;
+	double rssPerWorkerBytes = 0.0;
+	double frameBytes = -1.0; // 스레드는 -1 ("-")
+	LatencySummary lateNs;
+	double cpuMs = 0.0;
+	double resumeAllUs = 0.0;
+};
+
+// 워커 i 의 지각 샘플은 samples[i * ticks ...]. 측정 전에 미리 채워서(페이지를 건드려서) RSS 차이에 섞이지 않게 합니다.
+struct CoBenchShared
+{
+	std::int64_t periodNs = 0;
+	int ticks = 0;
+	std::vector<std::int64_t> samples;
+	std::atomic<int> started{ 0 };
+};
+
+Task<void> CoTickWorker(CoScheduler& scheduler, CoGate& gate, CoBenchShared& shared, int index, std::latch& done)
+{
+	shared.started.fetch_add(1, std::memory_order_relaxed);
+	std::int64_t* samples = shared.samples.data() + static_cast<std::size_t>(index) * shared.ticks;
+	std::int64_t next = NowNs();
+	for (int t = 0; t < shared.ticks && co_await gate.Pass(); ++t)
+	{
+		next += shared.periodNs;
+		co_await scheduler.SleepUntilNs(next);
+		samples[t] = NowNs() - next;
+	}
+	done.count_down();
+}
+
+void ThreadTickWorker(RunGate& gate, CoBenchShared& shared, int index)
+{
+	shared.started.fetch_add(1, std::memory_order_relaxed);
+	std::int64_t* samples = shared.samples.data() + static_cast<std::size_t>(index) * shared.ticks;
+	std::int64_t next = NowNs();
+	for (int t = 0; t < shared.ticks && gate.Pass(); ++t)
+	{
+		next += shared.periodNs;
+		std::this_thread::sleep_until(LabClock::time_point(std::chrono::duration_cast<LabClock::duration>(std::chrono::nanoseconds(next))));
+		samples[t] = NowNs() - next;
+	}
+}
+
+void WaitStarted(const std::atomic<int>& started, int count)
+{
+	while (started.load(std::memory_order_relaxed) < count)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void FinishTickResult(CoBenchResult& r, CoBenchShared& shared, int workers, long long rssBefore, long long rssAfter,
+	const ProcessUsage& before)
+{
+	r.rssPerWorkerBytes = (rssBefore >= 0 && rssAfter >= 0) ? static_cast<double>(rssAfter - rssBefore) * 1024.0 / workers : -1.0;
+	r.cpuMs = UsageDelta(before, ReadProcessUsage()).CpuNs() / 1e6;
+	r.lateNs = Summarize(shared.samples);
+}
+
+CoBenchResult RunCoroutineTicks(int workers, unsigned poolThreads, std::int64_t periodNs, int ticks)
+{
+	CoBenchShared shared;
+	shared.periodNs = periodNs;
+	shared.ticks = ticks;
+	shared.samples.assign(static_cast<std::size_t>(workers) * ticks, 0);
+
+	// 스케줄러를 latch 보다 나중에 선언: 먼저 파괴(워커 join)되어야 count_down 중인 워커가 latch 를 건드리지 않음
+	CoBenchResult r;
+	std::latch done(workers);
+	CoScheduler scheduler(poolThreads);
+	CoGate gate(scheduler);
+	r.osThreads = scheduler.Size();
+
+	const ProcessUsage before = ReadProcessUsage();
+	const long long rssBefore = CurrentRssKb();
+	const long long framesBefore = CoFrames().bytes.load();
+	for (int i = 0; i < workers; ++i)
+		Spawn(scheduler, CoTickWorker(scheduler, gate, shared, i, done));
+	WaitStarted(shared.started, workers);
+	const long long rssAfter = CurrentRssKb();
+	r.frameBytes = static_cast<double>(CoFrames().bytes.load() - framesBefore) / workers;
+
+	done.wait();
+	FinishTickResult(r, shared, workers, rssBefore, rssAfter, before);
+	r.ok = true;
+	return r;
+}
+
+CoBenchResult RunThreadTicks(int workers, std::int64_t periodNs, int ticks)
+{
+	CoBenchShared shared;
+	shared.periodNs = periodNs;
+	shared.ticks = ticks;
+	shared.samples.assign(static_cast<std::size_t>(workers) * ticks, 0);
+
+	CoBenchResult r;
+	RunGate gate;
+	std::vector<std::thread> threads;
+	threads.reserve(workers);
+
+	const ProcessUsage before = ReadProcessUsage();
+	const long long rssBefore = CurrentRssKb();
+	try
+	{
+		for (int i = 0; i < workers; ++i)
+			threads.emplace_back(&ThreadTickWorker, std::ref(gate), std::ref(shared), i);
+	}
+	catch (const std::system_error&)
+	{
+		// 스레드 수 한도(ulimit -u, threads-max)나 메모리 부족: 만든 것만 끝내고 실패로 표시
+		gate.RequestExit();
+		for (auto& th : threads)
+			th.join();
+		r.osThreads = static_cast<unsigned>(threads.size());
+		return r;
+	}
+	WaitStarted(shared.started, workers);
+	const long long rssAfter = CurrentRssKb();
+
+	for (auto& th : threads)
+		th.join();
+	r.osThreads = static_cast<unsigned>(workers);
+	FinishTickResult(r, shared, workers, rssBefore, rssAfter, before);
+	r.ok = true;
+	return r;
+}
+
+// 게이트에서 멈춘 코루틴 N개를 Resume 한 뒤 마지막 코루틴이 통과하기까지 (us)
+double MeasureCoResumeAllUs(int workers, unsigned poolThreads)
+{
+	std::latch done(workers);
+	std::atomic<int> passed{ 0 };
+	std::atomic<std::int64_t> lastNs{ 0 };
+	CoScheduler scheduler(poolThreads);
+	CoGate gate(scheduler, true);
+
+	auto waiter = [&]() -> Task<void> {
+		co_await gate.Pass();
+		if (passed.fetch_add(1, std::memory_order_acq_rel) + 1 == workers)
+			lastNs.store(NowNs(), std::memory_order_release);
+		done.count_down();
+	};
+	for (int i = 0; i < workers; ++i)
+		Spawn(scheduler, waiter());
+	while (gate.Waiters() < static_cast<std::size_t>(workers))
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	const std::int64_t t0 = NowNs();
+	gate.Resume();
+	done.wait();
+	return (lastNs.load(std::memory_order_acquire) - t0) / 1000.0;
+}
+
+// RunGate 에서 잠든 스레드 N개를 Resume 한 뒤 마지막 스레드가 통과하기까지 (us)
+// 스레드가 모두 futex 에 들어갔는지 셀 방법이 없으므로, 시작한 뒤 잠깐 기다렸다가 잽니다.
+double MeasureThreadResumeAllUs(int workers)
+{
+	RunGate gate(true);
+	std::atomic<int> started{ 0 };
+	std::atomic<int> passed{ 0 };
+	std::atomic<std::int64_t> lastNs{ 0 };
+	std::vector<std::thread> threads;
+	threads.reserve(workers);
+	try
+	{
+		for (int i = 0; i < workers; ++i)
+		{
+			threads.emplace_back([&] {
+				started.fetch_add(1, std::memory_order_relaxed);
+				gate.Pass();
+				if (passed.fetch_add(1, std::memory_order_acq_rel) + 1 == workers)
+					lastNs.store(NowNs(), std::memory_order_release);
+			});
+		}
+	}
+	catch (const std::system_error&)
+	{
+		gate.RequestExit();
+		for (auto& th : threads)
+			th.join();
+		return -1.0;
+	}
+	WaitStarted(started, workers);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+	const std::int64_t t0 = NowNs();
+	gate.Resume();
+	for (auto& th : threads)
+		th.join();
+	return (lastNs.load(std::memory_order_acquire) - t0) / 1000.0;
+}
+
+void PrintCoBenchHeader()
+{
+	std::cout << std::left
+		<< std::setw(11) << "impl"
+		<< std::setw(9) << "workers"
+		<< std::setw(8) << "os-thr"
+		<< std::setw(15) << "rss/worker(B)"
+		<< std::setw(10) << "frame(B)"
+		<< std::setw(14) << "late p50(us)"
+		<< std::setw(14) << "late p99(us)"
+		<< std::setw(14) << "late max(us)"
+		<< std::setw(10) << "cpu(ms)"
+		<< "resume-all(us)\n";
+}
+
+void PrintCoBenchRow(const char* impl, int workers, const CoBenchResult& r)
+{
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left << std::setw(11) << impl << std::setw(9) << workers;
+	if (!r.ok)
+	{
+		std::cout << "failed to create threads (created " << r.osThreads << ")\n";
+		return;
+	}
+	std::cout << std::fixed << std::setprecision(0)
+		<< std::setw(8) << r.osThreads
+		<< std::setw(15) << r.rssPerWorkerBytes
+		<< std::setw(10) << (r.frameBytes < 0 ? std::string("-") : std::to_string(static_cast<long long>(r.frameBytes)))
+		<< std::setw(14) << std::setprecision(1) << r.lateNs.p50 / 1000.0
+		<< std::setw(14) << r.lateNs.p99 / 1000.0
+		<< std::setw(14) << r.lateNs.max / 1000.0
+		<< std::setw(10) << r.cpuMs
+		<< r.resumeAllUs << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - workers=1,10,100,1000,10000 : 워커 수 목록
+// - pool=N        : 코루틴을 실행할 OS 스레드 수 (기본 min(4, hardware_concurrency))
+// - period=ms     : tick 간격 (기본 10)
+// - ticks=N       : 워커마다 tick 횟수 (기본 20)
+// - threads=0     : thread 구성을 생략 (기본 1)
+// - max-threads=N : thread 구성을 이 워커 수까지만 실행 (기본 10000)
+int CoBenchMain(const LabArgs& cli)
+{
+	std::vector<int> workerCounts = ParseIntList(cli.Get("workers", "1,10,100,1000,10000"));
+	if (workerCounts.empty())
+	{
+		std::cout << "workers= needs a list like 1,10,100\n";
+		return 1;
+	}
+	const unsigned pool = static_cast<unsigned>(cli.GetInt("pool", std::min(4u, ThreadPool::DefaultThreadCount())));
+	const std::int64_t periodNs = cli.GetInt("period", 10) * 1000000;
+	const int ticks = static_cast<int>(std::max(1LL, cli.GetInt("ticks", 20)));
+	const bool runThreads = cli.GetInt("threads", 1) != 0;
+	const int maxThreads = static_cast<int>(cli.GetInt("max-threads", 10000));
+
+	std::cout << "03_SignalWaiting (tick/tock workers: thread per worker vs coroutines on a pool, period="
+		<< periodNs / 1000000 << "ms ticks=" << ticks << ", hardware_concurrency=" << std::thread::hardware_concurrency() << ")\n\n";
+	PrintCoBenchHeader();
+	for (int workers : workerCounts)
+	{
+		if (runThreads && workers <= maxThreads)
+		{
+			CoBenchResult r = RunThreadTicks(workers, periodNs, ticks);
+			if (r.ok)
+				r.resumeAllUs = MeasureThreadResumeAllUs(workers);
+			PrintCoBenchRow("thread", workers, r);
+		}
+		CoBenchResult r = RunCoroutineTicks(workers, pool, periodNs, ticks);
+		r.resumeAllUs = MeasureCoResumeAllUs(workers, pool);
+		PrintCoBenchRow("coroutine", workers, r);
+	}
+
+	std::cout << "\nrss/worker = RSS growth / workers once all have started (thread: touched stack + TLS, kernel memory excluded)\n";
+	std::cout << "late = wake-up time - scheduled deadline, cpu = process CPU time from creation to the last tick\n";
+	return 0;
+}
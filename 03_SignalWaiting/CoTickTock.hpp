@@ -0,0 +1,68 @@
+#pragma once
+
+// 03_SignalWaiting - 코루틴 Tick/Tock (mode=coroutine, Common/Coroutine.hpp)
+//
+// TickTockGateWorker 와 같은 반복을 코루틴으로 씁니다.
+// - gate->Pass()          -> co_await gate.Pass()          : 일시정지 중에는 코루틴만 멈추고 스레드는 내어 줌
+// - sleep_for(1s)         -> co_await scheduler.SleepFor(1s): 스레드를 재우지 않고 타이머에 등록
+// 코루틴은 작은 풀(CoScheduler) 위에서 실행되므로, 깨어날 때마다 다른 OS 스레드에서 이어질 수 있습니다. (tid 출력)
+
+#include "../Common/Args.hpp"
+#include "../Common/Coroutine.hpp"
+#include "../Common/InputWaitSet.hpp"
+#include "../Common/Platform.hpp" // ReadKey
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+Task<void> TickTockTask(CoScheduler& scheduler, CoGate& gate)
+{
+	bool tick = true;
+	while (co_await gate.Pass())
+	{
+		std::cout << (tick ? "Tick" : "Tock") << " (tid=" << CurrentThreadId() << ")\n";
+		tick = !tick;
+		co_await scheduler.SleepFor(std::chrono::seconds(1));
+	}
+}
+
+// 인자
+// - pool=N : 코루틴을 실행할 OS 스레드 수 (기본 2)
+int CoTickTockMain(const LabArgs& cli)
+{
+	CoScheduler scheduler(static_cast<unsigned>(std::max(1LL, cli.GetInt("pool", 2))));
+	CoGate gate(scheduler);
+
+	std::cout << "03_SignalWaiting (C++20 coroutine on " << scheduler.Size()
+		<< " pool threads) - Tick/Tock task (Press T to Pause/Continue, Q to Quit)\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n\n";
+
+	Future<Unit> done = StartOn(scheduler, TickTockTask(scheduler, gate));
+
+	InputWaitSet input;
+	bool running = true;
+	while (input.Wait() == InputWait::Key)
+	{
+		const int ch = ReadKey();
+		if (ch == 't' || ch == 'T')
+		{
+			running = !running;
+			if (running)
+				gate.Resume();
+			else
+				gate.Pause();
+			std::cout << (running ? "[Main] Continue\n" : "[Main] Pause\n");
+		}
+		else if (ch == 'q' || ch == 'Q' || ch == kKeyEof)
+		{
+			std::cout << "[Main] Quit\n";
+			break;
+		}
+	}
+	gate.RequestExit();
+
+	// 타이머에서 기다리던 코루틴이 다음 Pass 에서 종료를 보고 끝날 때까지 대기
+	done.Get();
+	return 0;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+// 03_SignalWaiting - 일시정지 게이트 비용 비교
+//
+// TickTockWorker 에서 출력과 sleep_for(1s) 를 빼고, 아무도 Pause 하지 않는 상태에서
+// 워커가 게이트를 1초에 몇 번 통과하는지 셉니다. (= 반복 한 번마다 게이트가 더하는 비용)
+//
+// - cv      : 반복마다 mutex lock + condition_variable::wait(pred) + unlock
+// - event   : 반복마다 WaitForMultipleObjects(exitEvent, runEvent)   (Windows 전용, Win.hpp)
+// - rungate : 반복마다 RunGate::Pass() = atomic load 한 번
+
+#include "../Common/Args.hpp"
+#include "../Common/RunGate.hpp"
+#include "../Common/Timing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+long long CountCvGateIterations(unsigned durationMs)
+{
+	StdThreadControl ctrl;
+	long long iterations = 0;
+	std::thread worker([&] {
+		long long n = 0;
+		while (true)
+		{
+			std::unique_lock<std::mutex> lock(ctrl.m);
+			ctrl.cv.wait(lock, [&] { return ctrl.exitRequested || ctrl.running; });
+			if (ctrl.exitRequested)
+				break;
+			++n;
+		}
+		iterations = n;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+	{
+		std::lock_guard<std::mutex> lock(ctrl.m);
+		ctrl.exitRequested = true;
+	}
+	ctrl.cv.notify_all();
+	worker.join();
+	return iterations;
+}
+
+long long CountRunGateIterations(unsigned durationMs)
+{
+	RunGate gate;
+	long long iterations = 0;
+	std::thread worker([&] {
+		long long n = 0;
+		while (gate.Pass())
+			++n;
+		iterations = n;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+	gate.RequestExit();
+	worker.join();
+	return iterations;
+}
+
+// Pause -> Resume 을 cycles 번 반복하며, 잠든 워커가 Resume 호출 후 게이트를 다시 통과하기까지의 시간을 잽니다.
+// 통과 시각은 워커가 직접 기록하므로, 메인 스레드가 늦게 확인해도 결과에 섞이지 않습니다.
+double MeasureRunGateResumeUs(int cycles)
+{
+	RunGate gate;
+	std::atomic<std::int64_t> passedNs{ 0 };
+	std::thread worker([&] {
+		while (gate.Pass())
+		{
+			if (passedNs.load(std::memory_order_relaxed) == 0)
+				passedNs.store(NowNs(), std::memory_order_release);
+		}
+	});
+
+	std::int64_t totalNs = 0;
+	for (int i = 0; i < cycles; ++i)
+	{
+		gate.Pause();
+		// 워커가 futex 에서 잠들 때까지 대기 (CPU 가 하나뿐이어도 진행되도록 yield)
+		while (!gate.Parked())
+			std::this_thread::yield();
+
+		passedNs.store(0, std::memory_order_relaxed);
+		const std::int64_t t0 = NowNs();
+		gate.Resume();
+		std::int64_t passed = 0;
+		while ((passed = passedNs.load(std::memory_order_acquire)) == 0)
+			std::this_thread::yield();
+		totalNs += passed - t0;
+	}
+
+	gate.RequestExit();
+	worker.join();
+	return cycles > 0 ? static_cast<double>(totalNs) / cycles / 1000.0 : 0.0;
+}
+
+void PrintGateBenchRow(const char* gate, long long iterations, unsigned durationMs)
+{
+	const double sec = durationMs / 1000.0;
+	const double perSec = iterations / sec;
+	std::cout << std::left << std::fixed << std::setprecision(1)
+		<< std::setw(10) << gate
+		<< std::setw(16) << iterations
+		<< std::setw(18) << perSec
+		<< (iterations > 0 ? (sec * 1e9) / iterations : 0.0) << "\n";
+}
+
+// 인자
+// - ms=N     : 구성마다 워커를 돌리는 시간 (기본 1000)
+// - cycles=N : RunGate Pause/Resume 왕복 측정 횟수 (기본 1000)
+int GateBenchMain(const LabArgs& cli)
+{
+	const unsigned durationMs = static_cast<unsigned>(cli.GetInt("ms", 1000));
+	const int cycles = static_cast<int>(cli.GetInt("cycles", 1000));
+
+	std::cout << "03_SignalWaiting (pause gate cost, no output / no sleep, ms=" << durationMs << ")\n\n";
+	std::cout << std::left
+		<< std::setw(10) << "gate"
+		<< std::setw(16) << "iterations"
+		<< std::setw(18) << "iterations/sec"
+		<< "ns/iter\n";
+
+	PrintGateBenchRow("cv", CountCvGateIterations(durationMs), durationMs);
+#ifdef _WIN32
+	const long long eventIterations = CountEventGateIterations(durationMs);
+	if (eventIterations < 0)
+		return 1;
+	PrintGateBenchRow("event", eventIterations, durationMs);
+#endif
+	PrintGateBenchRow("rungate", CountRunGateIterations(durationMs), durationMs);
+
+	std::cout << "\nRunGate Resume -> worker running again (parked worker): " << std::fixed << std::setprecision(2)
+		<< MeasureRunGateResumeUs(cycles) << " us (cycles=" << cycles << ")\n";
+	return 0;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+// 03_SignalWaiting - 키 입력 폴링 vs 대기 집합 (mode=input-bench, Linux / POSIX)
+//
+// 표준 입력 대신 pipe 를 입력으로 쓰고, 별도 스레드가 사람 대신 키를 씁니다.
+// - poll  : 기존 SMain 의 메인 루프 (입력 확인 -> 없으면 sleep 30ms), 워커 종료는 반복마다 플래그 확인
+// - event : InputWaitSet 으로 입력과 워커 종료 신호를 함께 기다림
+//
+// 측정
+// - react   : 't' 를 쓴 시각 -> 메인이 RunGate 를 Resume 해 멈춰 있던 워커가 통과한 시각
+// - exit    : 'q' 를 쓴 시각 -> 워커가 끝난 것을 보고 메인 루프가 빠져나온 시각 (종료 신호가 대기 집합에 있는지)
+// - idle    : 아무 입력 없이 기다리는 동안 메인 루프가 깨어난 횟수 / 초
+
+#include "../Common/Args.hpp"
+#include "../Common/InputWaitSet.hpp"
+#include "../Common/RunGate.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
+struct InputBenchResult
+{
+	bool ok = false;
+	LatencySummary reactNs;
+	double exitUs = 0.0;
+	double idleWakeupsPerSec = 0.0;
+};
+
+struct InputBenchShared
+{
+	RunGate gate{ true };                    // 워커는 't' 를 기다리며 멈춰 있음
+	std::atomic<std::int64_t> sentNs{ 0 };   // 마지막 키를 쓴 시각
+	std::atomic<int> reactions{ 0 };
+	std::atomic<bool> workerDone{ false };   // poll 구성이 반복마다 확인
+	std::atomic<long long> loopWakeups{ 0 }; // 메인 루프가 깨어난 횟수
+	std::atomic<std::int64_t> loopExitNs{ 0 };
+	std::vector<std::int64_t> samples;
+};
+
+// 't' 로 풀려날 때마다 반응 시간을 기록하고 스스로 다시 멈춥니다. (다음 't' 는 이 Pause 뒤에만 옴)
+void InputBenchWorker(InputBenchShared& shared, InputWaitSet* input)
+{
+	while (shared.gate.Pass())
+	{
+		const std::int64_t now = NowNs();
+		shared.samples.push_back(now - shared.sentNs.load(std::memory_order_acquire));
+		shared.gate.Pause();
+		shared.reactions.fetch_add(1, std::memory_order_release);
+	}
+	shared.workerDone.store(true, std::memory_order_release);
+	if (input)
+		input->SignalExit();
+}
+
+// 메인 루프의 키 처리: 't' 는 Resume, 'q' 는 종료 요청 (루프는 워커 종료를 보고 끝남)
+void HandleBenchKey(InputBenchShared& shared, int fd)
+{
+	char ch = 0;
+	if (::read(fd, &ch, 1) != 1)
+		return;
+	if (ch == 't')
+		shared.gate.Resume();
+	else if (ch == 'q')
+		shared.gate.RequestExit();
+}
+
+void PollingControlLoop(InputBenchShared& shared, int fd)
+{
+	while (!shared.workerDone.load(std::memory_order_acquire))
+	{
+		shared.loopWakeups.fetch_add(1, std::memory_order_relaxed);
+		pollfd pfd{ fd, POLLIN, 0 };
+		if (::poll(&pfd, 1, 0) > 0)
+			HandleBenchKey(shared, fd);
+		std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	}
+	shared.loopExitNs.store(NowNs(), std::memory_order_release);
+}
+
+void EventControlLoop(InputBenchShared& shared, InputWaitSet& input, int fd)
+{
+	while (true)
+	{
+		const InputWait w = input.Wait();
+		shared.loopWakeups.fetch_add(1, std::memory_order_relaxed);
+		if (w != InputWait::Key)
+			break;
+		HandleBenchKey(shared, fd);
+	}
+	shared.loopExitNs.store(NowNs(), std::memory_order_release);
+}
+
+InputBenchResult RunInputBench(bool useEvent, int commands, int idleMs)
+{
+	InputBenchResult r;
+	int fds[2];
+	if (::pipe(fds) != 0)
+		return r;
+
+	InputBenchShared shared;
+	shared.samples.reserve(commands);
+	InputWaitSet input(fds[0]);
+	if (useEvent && !input.Ok())
+	{
+		::close(fds[0]);
+		::close(fds[1]);
+		return r;
+	}
+
+	std::thread worker(&InputBenchWorker, std::ref(shared), useEvent ? &input : nullptr);
+	std::thread control([&] {
+		if (useEvent)
+			EventControlLoop(shared, input, fds[0]);
+		else
+			PollingControlLoop(shared, fds[0]);
+	});
+
+	// 사람이 누르는 것처럼 5 ~ 25ms 간격으로 't' 를 씁니다. 워커가 반응한 뒤에만 다음 키
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> gapMs(5, 25);
+	for (int i = 0; i < commands; ++i)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(gapMs(rng)));
+		shared.sentNs.store(NowNs(), std::memory_order_release);
+		const char t = 't';
+		[[maybe_unused]] const ssize_t n = ::write(fds[1], &t, 1);
+		while (shared.reactions.load(std::memory_order_acquire) <= i)
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+
+	// 유휴: 입력 없이 idleMs 동안 메인 루프가 몇 번 깨어나는지
+	const long long wakeupsBefore = shared.loopWakeups.load();
+	const std::int64_t idleStart = NowNs();
+	std::this_thread::sleep_for(std::chrono::milliseconds(idleMs));
+	r.idleWakeupsPerSec = (shared.loopWakeups.load() - wakeupsBefore) * 1e9 / (NowNs() - idleStart);
+
+	const std::int64_t quitNs = NowNs();
+	const char q = 'q';
+	[[maybe_unused]] const ssize_t n = ::write(fds[1], &q, 1);
+	worker.join();
+	control.join();
+	r.exitUs = (shared.loopExitNs.load() - quitNs) / 1000.0;
+
+	::close(fds[0]);
+	::close(fds[1]);
+	r.reactNs = Summarize(shared.samples);
+	r.ok = true;
+	return r;
+}
+
+// 인자
+// - commands=N : 't' 명령 수 (기본 100)
+// - idle=ms    : 유휴 깨어남을 세는 시간 (기본 2000)
+int InputBenchMain(const LabArgs& cli)
+{
+	const int commands = static_cast<int>(std::max(1LL, cli.GetInt("commands", 100)));
+	const int idleMs = static_cast<int>(std::max(1LL, cli.GetInt("idle", 2000)));
+
+	std::cout << "03_SignalWaiting (controller input: 30ms polling vs wait set, commands=" << commands
+		<< " idle=" << idleMs << "ms)\n\n";
+	std::cout << std::left
+		<< std::setw(8) << "impl"
+		<< std::setw(14) << "react p50(us)"
+		<< std::setw(14) << "react p99(us)"
+		<< std::setw(14) << "react max(us)"
+		<< std::setw(10) << "exit(us)"
+		<< "idle wakeups/s\n";
+
+	for (bool useEvent : { false, true })
+	{
+		const char* impl = useEvent ? "event" : "poll";
+		const InputBenchResult r = RunInputBench(useEvent, commands, idleMs);
+		if (!r.ok)
+		{
+			std::cout << std::setw(8) << impl << "setup failed\n";
+			continue;
+		}
+		const std::ios::fmtflags flags = std::cout.flags();
+		std::cout << std::left << std::fixed << std::setprecision(1)
+			<< std::setw(8) << impl
+			<< std::setw(14) << r.reactNs.p50 / 1000.0
+			<< std::setw(14) << r.reactNs.p99 / 1000.0
+			<< std::setw(14) << r.reactNs.max / 1000.0
+			<< std::setw(10) << r.exitUs
+			<< r.idleWakeupsPerSec << "\n";
+		std::cout.flags(flags);
+	}
+
+	std::cout << "\nreact = key written -> paused worker passes the gate, exit = 'q' written -> controller loop returns\n";
+	return 0;
+}
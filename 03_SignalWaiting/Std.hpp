@@ -1,14 +1,23 @@
 #pragma once
 
-#include <Windows.h>
-
-#include <conio.h> // _kbhit, _getch
+#include "../Common/Args.hpp"
+#include "../Common/AsyncLog.hpp"
+#include "../Common/EpochGate.hpp"
+#include "../Common/InputWaitSet.hpp"
+#include "../Common/Platform.hpp" // ReadKey
+#include "../Common/RunGate.hpp"
+#include "../Common/Timing.hpp"
+#include "../Common/Trace.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <iostream>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 struct StdThreadControl
 {
@@ -20,6 +29,8 @@ struct StdThreadControl
 
 void TickTockWorker(StdThreadControl* ctrl)
 {
+	TraceThreadName("TickTockWorker");
+	TraceScope scope("TickTockWorker", "lifecycle");
 	// 출력 토글 상태 (Tick <-> Tock)
 	bool tick = true;
 
@@ -27,41 +38,148 @@ void TickTockWorker(StdThreadControl* ctrl)
 	{
 		{
 			// scope-based lock 기반으로 참이 될때까지 대기
+			const std::int64_t t0 = NowNs();
 			std::unique_lock<std::mutex> lock(ctrl->m);
 			ctrl->cv.wait(lock, [&] { return ctrl->exitRequested || ctrl->running; });
+			// 메인의 notify_all 과 이 구간의 끝 사이가 깨어나는 지연입니다.
+			TraceComplete("cv wait", "signal", t0, NowNs() - t0);
 
 			if (ctrl->exitRequested)
 				break;
 		}
 
 		// 실제 작업: 1초마다 Tick/Tock 출력
-		std::cout << (tick ? "Tick" : "Tock") << "\n";
+		TraceInstant(tick ? "Tick" : "Tock", "signal");
+		Log() << (tick ? "Tick" : "Tock");
 		tick = !tick;
 		std::this_thread::sleep_for(std::chrono::seconds(1));
 	}
 }
 
+// RunGate 버전: 실행 중에는 mutex 없이 atomic load 한 번으로 통과하고, Pause 일 때만 futex 로 잠듭니다.
+void TickTockGateWorker(RunGate* gate)
+{
+	TraceThreadName("TickTockGateWorker");
+	TraceScope scope("TickTockGateWorker", "lifecycle");
+	bool tick = true;
 
-int SMain()
+	while (true)
+	{
+		const std::int64_t t0 = NowNs();
+		const bool run = gate->Pass();
+		TraceComplete("gate pass", "signal", t0, NowNs() - t0);
+		if (!run)
+			break;
+		TraceInstant(tick ? "Tick" : "Tock", "signal");
+		Log() << (tick ? "Tick" : "Tock");
+		tick = !tick;
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+	}
+}
+
+// EpochGate 버전: 워커 N개를 한 번에 Pause / Resume 하고, 컨트롤러는 모두 멈췄다는 ack 를 받은 뒤 돌아옵니다.
+void TickTockEpochWorker(EpochGate* gate, int index)
 {
-	std::cout << "03_SignalWaiting (std::thread) - Tick/Tock worker (Press T to Pause/Continue, Q to Quit)\n";
-	std::cout << "main tid=" << ::GetCurrentThreadId() << "\n\n";
+	TraceThreadName("TickTockEpochWorker");
+	TraceScope scope("TickTockEpochWorker", "lifecycle");
+	bool tick = true;
+	std::uint32_t seen = EpochGate::Start();
+
+	while (true)
+	{
+		const std::int64_t t0 = NowNs();
+		const bool run = gate->Pass(seen);
+		TraceComplete("epoch pass", "signal", t0, NowNs() - t0);
+		if (!run)
+			break;
+		TraceInstant(tick ? "Tick" : "Tock", "signal", index);
+		// 한 줄은 워커의 LogRecord 에서 만들어진 뒤 통째로 큐에 들어가므로 다른 워커의 출력과 섞이지 않습니다.
+		Log() << (tick ? "Tick" : "Tock") << " [worker " << index << "]";
+		tick = !tick;
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+	}
+}
+
+// 인자
+// - gate=cv      : mutex + condition_variable 로 제어 (기본)
+// - gate=rungate : RunGate 로 제어
+// - gate=epoch   : EpochGate 로 워커 여러 개를 제어 (workers=N, 기본 4)
+// - trace=path   : 워커의 대기 구간과 메인의 Pause / Continue / Quit 신호를 Chrome trace 로 기록 (main 의 TraceSession)
+// - log=sync     : Tick/Tock 과 [Main] 줄을 비동기 로그 싱크 대신 바로 출력 (main 의 AsyncLogSession)
+int SMain(const LabArgs& cli)
+{
+	const std::string gateName = cli.Get("gate", "cv");
+	const bool useGate = (gateName == "rungate");
+	const bool useEpoch = (gateName == "epoch");
+	if (!useGate && !useEpoch && gateName != "cv")
+	{
+		std::cout << "unknown gate=" << gateName << "\n";
+		return 1;
+	}
+
+	const int workers = useEpoch ? static_cast<int>(std::max(1LL, cli.GetInt("workers", 4))) : 1;
+
+	std::cout << "03_SignalWaiting (std::thread, " << (useEpoch ? "EpochGate x" + std::to_string(workers) : useGate ? "RunGate" : "condition_variable")
+		<< ") - Tick/Tock worker (Press T to Pause/Continue, Q to Quit)\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n\n";
+
+	// 키 입력과 워커 종료 신호를 한 대기 집합에서 기다립니다. (30ms 폴링 대신)
+	InputWaitSet input;
+	if (!input.Ok())
+	{
+		std::cout << "InputWaitSet setup failed\n";
+		return 1;
+	}
 
 	StdThreadControl ctrl;
-	std::thread worker(&TickTockWorker, &ctrl);
+	RunGate gate;
+	EpochGate epoch(static_cast<unsigned>(workers));
+	std::vector<std::thread> threads;
+	for (int i = 0; i < workers; ++i)
+	{
+		threads.emplace_back([&, i] {
+			if (useEpoch)
+				TickTockEpochWorker(&epoch, i);
+			else if (useGate)
+				TickTockGateWorker(&gate);
+			else
+				TickTockWorker(&ctrl);
+			input.SignalExit(); // 워커가 어떤 이유로든 끝나면 메인도 깨어남
+		});
+	}
 
 	// 메인 스레드: 키 입력으로 워커를 제어
 	// - T: Pause <-> Continue
 	// - Q: 종료
+	// 키가 눌리거나 워커가 끝날 때만 깨어납니다.
 	bool running = true;
-	while (true)
+	while (input.Wait() == InputWait::Key)
 	{
-		if (_kbhit())
+		const int ch = ReadKey();
+		if (ch == 't' || ch == 'T')
 		{
-			const int ch = _getch();
-			if (ch == 't' || ch == 'T')
+			running = !running;
+			TraceInstant(running ? "Continue" : "Pause", "signal");
+			if (useEpoch)
+			{
+				// 모든 워커가 게이트에 도착(ack)할 때까지 돌아오지 않습니다. 워커가 sleep_for(1s) 중이면 그만큼 걸림
+				StopWatch watch;
+				if (running)
+					epoch.Resume();
+				else
+					epoch.Pause();
+				Log() << "[Main] all " << workers << " workers acked in " << watch.ElapsedMs() << " ms";
+			}
+			else if (useGate)
+			{
+				// 잠든 워커가 있을 때만 futex wake 를 호출합니다.
+				if (running)
+					gate.Resume();
+				else
+					gate.Pause();
+			}
+			else
 			{
-				running = !running;
 				// Scope-based lock 을 사용
 				{
 					std::lock_guard<std::mutex> lock(ctrl.m);
@@ -69,11 +187,22 @@ int SMain()
 				}
 				// wait(), wait_for(), wait_until()로 대기 중인 모든 스레드를 깨웁니다.
 				ctrl.cv.notify_all();
-				std::cout << (running ? "[Main] Continue\n" : "[Main] Pause\n");
 			}
-			else if (ch == 'q' || ch == 'Q')
+			Log() << (running ? "[Main] Continue" : "[Main] Pause");
+		}
+		else if (ch == 'q' || ch == 'Q' || ch == kKeyEof) // 입력이 닫히면 종료로 취급
+		{
+			TraceInstant("Quit", "signal");
+			Log() << "[Main] Quit";
+			if (useEpoch)
+				epoch.RequestExit();
+			else if (useGate)
+			{
+				// 종료는 별도 상태: 이후의 Pause / Resume 으로 되돌릴 수 없습니다.
+				gate.RequestExit();
+			}
+			else
 			{
-				std::cout << "[Main] Quit\n";
 				// Scope-based lock 을 사용
 				{
 					std::lock_guard<std::mutex> lock(ctrl.m);
@@ -82,16 +211,13 @@ int SMain()
 				}
 				// wait(), wait_for(), wait_until()로 대기 중인 모든 스레드를 깨웁니다.
 				ctrl.cv.notify_all();
-				break;
 			}
+			break;
 		}
-
-		// 퀀텀까지 소비하지 않고 다른 쓰레드에 양보함
-		std::this_thread::sleep_for(std::chrono::milliseconds(30));
 	}
 
 	// 생성한 쓰레드의 종료까지 대기
-	worker.join();
+	for (auto& th : threads)
+		th.join();
 	return 0;
 }
-
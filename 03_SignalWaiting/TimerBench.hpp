@@ -0,0 +1,277 @@
+#pragma once
+
+// 03_SignalWaiting - 타이머 휠 vs 타이머마다 잠자는 스레드 (mode=timer-bench)
+//
+// 주기 타이머 N개를 ms 동안 돌립니다. 시작 시각(phase)은 period 안에서 무작위로 흩어 둡니다.
+// - wheel  : TimerWheel 하나 (서비스 스레드 1개) 에 ScheduleAtNs(phase, period) N개
+// - thread : 타이머마다 std::thread 하나가 sleep_until 반복 (CoBench 의 thread 구성과 같은 방식)
+//
+// 측정
+// - late       : 콜백 / 깨어난 시각 - 예정 시각 (wheel 은 1ms tick 으로 올림한 만큼 포함)
+// - cpu        : 실행 동안의 프로세스 CPU 시간
+// - wakeups/s  : 잠에서 깨어난 횟수 / 초 (wheel: 서비스 스레드, thread: 모든 스레드의 sleep_until)
+// - rss/timer  : 타이머를 모두 등록한 뒤의 RSS 증가 / N (바이트)
+// - sched / cancel : 먼 미래의 단발 타이머 N개를 등록 / 취소하는 데 걸린 시간 / N. N 과 무관하면 O(1)
+
+#include "../Common/Args.hpp"
+#include "../Common/ProcessStats.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/TimerWheel.hpp"
+#include "../Common/Timing.hpp"
+#include "CoBench.hpp" // WaitStarted
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+struct TimerBenchResult
+{
+	bool ok = false; // 스레드를 모두 만들지 못하면 false
+	unsigned osThreads = 0;
+	LatencySummary lateNs;
+	double cpuMs = 0.0;
+	double wakeupsPerSec = 0.0;
+	double rssPerTimerBytes = 0.0;
+	double scheduleNs = -1.0; // thread 는 -1 ("-")
+	double cancelNs = -1.0;
+};
+
+// 샘플 버퍼는 측정 전에 채워서(페이지를 건드려서) RSS 차이에 섞이지 않게 합니다.
+struct TimerBenchShared
+{
+	std::int64_t periodNs = 0;
+	std::int64_t endNs = 0;
+	std::vector<std::int64_t> phaseNs; // 타이머마다 첫 실행까지
+	std::vector<std::int64_t> samples;
+	std::size_t count = 0;             // wheel: 서비스 스레드만 씀
+	std::atomic<int> started{ 0 };     // thread
+	std::atomic<long long> wakeups{ 0 };
+};
+
+void PrepareTimerShared(TimerBenchShared& shared, int timers, std::int64_t periodNs, std::int64_t runNs)
+{
+	shared.periodNs = periodNs;
+	std::mt19937_64 rng(12345);
+	std::uniform_int_distribution<std::int64_t> phase(0, periodNs - 1);
+	shared.phaseNs.resize(timers);
+	for (auto& p : shared.phaseNs)
+		p = phase(rng);
+	// 타이머마다 runNs / period 번 + 여유 1번
+	shared.samples.assign(static_cast<std::size_t>(timers) * static_cast<std::size_t>(runNs / periodNs + 1), 0);
+}
+
+TimerBenchResult RunWheelTimers(int timers, std::int64_t periodNs, std::int64_t runNs)
+{
+	TimerBenchShared shared;
+	PrepareTimerShared(shared, timers, periodNs, runNs);
+
+	TimerBenchResult r;
+	r.osThreads = 1;
+
+	const ProcessUsage before = ReadProcessUsage();
+	long long rssBefore = 0;
+	long long rssAfter = 0;
+	std::int64_t elapsedNs = 0;
+	long long wakeups = 0;
+	{
+		// 밀린 콜백은 lock 밖에서 실행되므로 Cancel 로는 멈추지 않습니다. 휠을 없앤 뒤(서비스 스레드 join) shared 를 읽습니다.
+		TimerWheel wheel;
+		rssBefore = CurrentRssKb();
+		const long long wakeupsBefore = wheel.Wakeups();
+		const std::int64_t t0 = NowNs();
+		shared.endNs = t0 + runNs;
+		for (int i = 0; i < timers; ++i)
+		{
+			wheel.ScheduleAtNs(t0 + shared.phaseNs[i], periodNs, [&shared](std::int64_t dueNs) {
+				const std::int64_t now = NowNs();
+				if (dueNs < shared.endNs && shared.count < shared.samples.size())
+					shared.samples[shared.count++] = now - dueNs;
+			});
+		}
+		rssAfter = CurrentRssKb();
+
+		std::this_thread::sleep_for(std::chrono::nanoseconds(shared.endNs - NowNs()));
+		elapsedNs = NowNs() - t0;
+		wakeups = wheel.Wakeups() - wakeupsBefore;
+	}
+
+	r.cpuMs = UsageDelta(before, ReadProcessUsage()).CpuNs() / 1e6;
+	r.wakeupsPerSec = wakeups * 1e9 / elapsedNs;
+	r.rssPerTimerBytes = (rssBefore >= 0 && rssAfter >= 0) ? static_cast<double>(rssAfter - rssBefore) * 1024.0 / timers : -1.0;
+	shared.samples.resize(shared.count);
+	r.lateNs = Summarize(shared.samples);
+	r.ok = true;
+	return r;
+}
+
+void SleepingTimerThread(TimerBenchShared& shared, int index, std::int64_t t0)
+{
+	shared.started.fetch_add(1, std::memory_order_relaxed);
+	const std::size_t perTimer = shared.samples.size() / shared.phaseNs.size();
+	std::int64_t* samples = shared.samples.data() + static_cast<std::size_t>(index) * perTimer;
+	long long wakeups = 0;
+	std::size_t n = 0;
+	for (std::int64_t due = t0 + shared.phaseNs[index]; due < shared.endNs && n < perTimer; due += shared.periodNs)
+	{
+		std::this_thread::sleep_until(LabClock::time_point(std::chrono::duration_cast<LabClock::duration>(std::chrono::nanoseconds(due))));
+		samples[n++] = NowNs() - due;
+		++wakeups;
+	}
+	// 채우지 못한 자리는 -1 로 남겨 집계에서 뺍니다.
+	shared.wakeups.fetch_add(wakeups, std::memory_order_relaxed);
+}
+
+TimerBenchResult RunThreadTimers(int timers, std::int64_t periodNs, std::int64_t runNs)
+{
+	TimerBenchShared shared;
+	PrepareTimerShared(shared, timers, periodNs, runNs);
+	std::fill(shared.samples.begin(), shared.samples.end(), -1);
+
+	TimerBenchResult r;
+	std::vector<std::thread> threads;
+	threads.reserve(timers);
+
+	const ProcessUsage before = ReadProcessUsage();
+	const long long rssBefore = CurrentRssKb();
+	const std::int64_t t0 = NowNs();
+	shared.endNs = t0 + runNs;
+	try
+	{
+		for (int i = 0; i < timers; ++i)
+			threads.emplace_back(&SleepingTimerThread, std::ref(shared), i, t0);
+	}
+	catch (const std::system_error&)
+	{
+		// 스레드 수 한도: 만든 것만 끝내고 실패로 표시 (endNs 가 지나면 모두 스스로 끝남)
+		for (auto& th : threads)
+			th.join();
+		r.osThreads = static_cast<unsigned>(threads.size());
+		return r;
+	}
+	WaitStarted(shared.started, timers);
+	const long long rssAfter = CurrentRssKb();
+
+	for (auto& th : threads)
+		th.join();
+	const std::int64_t elapsedNs = NowNs() - t0;
+
+	r.osThreads = static_cast<unsigned>(timers);
+	r.cpuMs = UsageDelta(before, ReadProcessUsage()).CpuNs() / 1e6;
+	r.wakeupsPerSec = shared.wakeups.load() * 1e9 / elapsedNs;
+	r.rssPerTimerBytes = (rssBefore >= 0 && rssAfter >= 0) ? static_cast<double>(rssAfter - rssBefore) * 1024.0 / timers : -1.0;
+	shared.samples.erase(std::remove(shared.samples.begin(), shared.samples.end(), -1), shared.samples.end());
+	r.lateNs = Summarize(shared.samples);
+	r.ok = true;
+	return r;
+}
+
+// 먼 미래(1초 ~ 1시간)의 단발 타이머 N개를 등록한 뒤 모두 취소. 레벨 0 ~ 3 에 고루 들어갑니다.
+void MeasureScheduleCancel(int timers, TimerBenchResult& r)
+{
+	TimerWheel wheel;
+	std::mt19937_64 rng(777);
+	std::uniform_int_distribution<std::int64_t> delay(1000000000LL, 3600LL * 1000000000LL);
+	std::vector<std::int64_t> dues(timers);
+	const std::int64_t now = NowNs();
+	for (auto& d : dues)
+		d = now + delay(rng);
+	std::vector<TimerId> ids(timers);
+
+	// 한 번 등록 / 취소해 노드를 free list 에 만들어 두고(할당 제외), 두 번째를 잽니다.
+	for (int round = 0; round < 2; ++round)
+	{
+		const std::int64_t t0 = NowNs();
+		for (int i = 0; i < timers; ++i)
+			ids[i] = wheel.ScheduleAtNs(dues[i], 0, [](std::int64_t) {});
+		const std::int64_t t1 = NowNs();
+		for (const TimerId& id : ids)
+			wheel.Cancel(id);
+		const std::int64_t t2 = NowNs();
+		r.scheduleNs = static_cast<double>(t1 - t0) / timers;
+		r.cancelNs = static_cast<double>(t2 - t1) / timers;
+	}
+}
+
+void PrintTimerBenchHeader()
+{
+	std::cout << std::left
+		<< std::setw(8) << "impl"
+		<< std::setw(9) << "timers"
+		<< std::setw(8) << "os-thr"
+		<< std::setw(14) << "late p50(us)"
+		<< std::setw(14) << "late p99(us)"
+		<< std::setw(14) << "late max(us)"
+		<< std::setw(10) << "cpu(ms)"
+		<< std::setw(12) << "wakeups/s"
+		<< std::setw(14) << "rss/timer(B)"
+		<< std::setw(11) << "sched(ns)"
+		<< "cancel(ns)\n";
+}
+
+void PrintTimerBenchRow(const char* impl, int timers, const TimerBenchResult& r)
+{
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left << std::setw(8) << impl << std::setw(9) << timers;
+	if (!r.ok)
+	{
+		std::cout << "failed to create threads (created " << r.osThreads << ")\n";
+		return;
+	}
+	auto orDash = [](double v) { return v < 0 ? std::string("-") : std::to_string(static_cast<long long>(v + 0.5)); };
+	std::cout << std::fixed << std::setprecision(1)
+		<< std::setw(8) << r.osThreads
+		<< std::setw(14) << r.lateNs.p50 / 1000.0
+		<< std::setw(14) << r.lateNs.p99 / 1000.0
+		<< std::setw(14) << r.lateNs.max / 1000.0
+		<< std::setprecision(0)
+		<< std::setw(10) << r.cpuMs
+		<< std::setw(12) << r.wakeupsPerSec
+		<< std::setw(14) << r.rssPerTimerBytes
+		<< std::setw(11) << orDash(r.scheduleNs)
+		<< orDash(r.cancelNs) << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - timers=1,100,1000,10000,100000 : 타이머 수 목록
+// - period=ms     : 타이머 주기 (기본 100)
+// - ms=N          : 구성마다 실행 시간 (기본 2000)
+// - threads=0     : thread 구성을 생략 (기본 1)
+// - max-threads=N : thread 구성을 이 타이머 수까지만 실행 (기본 1000)
+int TimerBenchMain(const LabArgs& cli)
+{
+	std::vector<int> timerCounts = ParseIntList(cli.Get("timers", "1,100,1000,10000,100000"));
+	if (timerCounts.empty())
+	{
+		std::cout << "timers= needs a list like 1,100,1000\n";
+		return 1;
+	}
+	const std::int64_t periodNs = std::max(1LL, cli.GetInt("period", 100)) * 1000000;
+	const std::int64_t runNs = std::max(1LL, cli.GetInt("ms", 2000)) * 1000000;
+	const bool runThreads = cli.GetInt("threads", 1) != 0;
+	const int maxThreads = static_cast<int>(cli.GetInt("max-threads", 1000));
+
+	std::cout << "03_SignalWaiting (periodic timers: timer wheel vs sleeping thread per timer, period="
+		<< periodNs / 1000000 << "ms run=" << runNs / 1000000 << "ms, hardware_concurrency=" << std::thread::hardware_concurrency() << ")\n\n";
+	PrintTimerBenchHeader();
+	for (int timers : timerCounts)
+	{
+		if (runThreads && timers <= maxThreads)
+			PrintTimerBenchRow("thread", timers, RunThreadTimers(timers, periodNs, runNs));
+		TimerBenchResult r = RunWheelTimers(timers, periodNs, runNs);
+		MeasureScheduleCancel(timers, r);
+		PrintTimerBenchRow("wheel", timers, r);
+	}
+
+	std::cout << "\nlate = callback/wake-up time - due time (wheel rounds up to its 1ms tick)\n";
+	std::cout << "sched/cancel = per-op cost of arming then cancelling N one-shot timers 1s..1h away (flat across N = O(1))\n";
+	return 0;
+}
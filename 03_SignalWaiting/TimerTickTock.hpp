@@ -0,0 +1,83 @@
+#pragma once
+
+// 03_SignalWaiting - 타이머 휠 Tick/Tock (mode=timer, Common/TimerWheel.hpp)
+//
+// 처음 버전은 TickTockWorker 스레드가 sleep_for(1s) 로, 메인 스레드가 sleep_for(30ms) 폴링으로 시간을 보냈습니다.
+// 여기서는 둘 다 TimerWheel 의 주기 타이머 콜백이 되고, 시간을 기다리는 스레드는 서비스 스레드 하나뿐입니다.
+// - tick/tock : 1초 주기 타이머. 일시정지는 Cancel, 재개는 다시 ScheduleEvery (게이트가 필요 없음)
+// - 키보드    : 30ms 주기 타이머에서 KeyHit 확인. Q 를 받으면 promise 로 메인에 종료를 알림
+// 콜백은 모두 서비스 스레드에서 차례로 실행되므로, 콜백끼리 공유하는 상태(tickId, tick)에 lock 이 필요 없습니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/Platform.hpp" // KeyHit, ReadKey
+#include "../Common/TimerWheel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <iostream>
+
+// 인자
+// - period=ms : tick/tock 간격 (기본 1000, 1 이상)
+// - poll=ms   : 키보드 확인 간격 (기본 30, 1 이상)
+int TimerTickTockMain(const LabArgs& cli)
+{
+	// 0 이하면 ScheduleEvery 가 단발 타이머가 되어 키를 더 읽지 않으므로 1ms 이상으로 둡니다.
+	const std::chrono::milliseconds period(std::max(1LL, cli.GetInt("period", 1000)));
+	const std::chrono::milliseconds poll(std::max(1LL, cli.GetInt("poll", 30)));
+
+	// 콜백이 참조로 잡는 상태는 휠보다 먼저 선언합니다. (휠 소멸자가 서비스 스레드를 join 한 뒤에 없어짐)
+	std::promise<void> quit;
+
+	// 아래 상태는 서비스 스레드의 콜백만 만집니다.
+	bool tick = true;
+	TimerId tickId;
+	bool quitting = false;
+
+	auto onTick = [&](std::int64_t dueNs) {
+		const double lateMs = (NowNs() - dueNs) / 1e6;
+		std::cout << (tick ? "Tick" : "Tock") << " (tid=" << CurrentThreadId() << ", late " << lateMs << "ms)\n";
+		tick = !tick;
+	};
+
+	TimerWheel wheel;
+	std::cout << "03_SignalWaiting (timer wheel, " << wheel.TickNs() / 1000 << "us tick, one service thread)"
+		<< " - Tick/Tock timer (Press T to Pause/Continue, Q to Quit)\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n\n";
+
+	tickId = wheel.ScheduleEvery(period, onTick);
+
+	const TimerId pollId = wheel.ScheduleEvery(poll, [&](std::int64_t) {
+		if (quitting || !KeyHit())
+			return;
+
+		const int ch = ReadKey();
+		if (ch == 't' || ch == 'T')
+		{
+			if (wheel.Cancel(tickId))
+			{
+				tickId = TimerId{};
+				std::cout << "[Timer] Pause\n";
+			}
+			else
+			{
+				tickId = wheel.ScheduleEvery(period, onTick);
+				std::cout << "[Timer] Continue\n";
+			}
+		}
+		else if (ch == 'q' || ch == 'Q' || ch == kKeyEof)
+		{
+			std::cout << "[Timer] Quit\n";
+			quitting = true;
+			wheel.Cancel(tickId);
+			quit.set_value();
+		}
+	});
+
+	// 메인 스레드는 종료 신호만 기다립니다. (폴링 없음)
+	quit.get_future().wait();
+	wheel.Cancel(pollId);
+	std::cout << "[Main] service wakeups=" << wheel.Wakeups() << "\n";
+	return 0;
+}
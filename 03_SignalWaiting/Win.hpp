@@ -1,7 +1,11 @@
 ﻿#pragma once
 
+#include "../Common/AsyncLog.hpp"
+#include "../Common/InputWaitSet.hpp"
+#include "../Common/Trace.hpp"
+
 #include <Windows.h>
-#include <conio.h>   // _kbhit, _getch
+#include <conio.h>   // _getch
 #include <process.h> // _beginthreadex
 #include <iostream>
 
@@ -16,6 +20,8 @@ struct WinThreadControl
 
 unsigned __stdcall TickTockThreadProc(void* param)
 {
+	TraceThreadName("TickTockThreadProc");
+	TraceScope scope("TickTockThreadProc", "lifecycle");
 	const auto* ctrl = static_cast<const WinThreadControl*>(param);
 	bool tick = true;
 
@@ -23,12 +29,15 @@ unsigned __stdcall TickTockThreadProc(void* param)
 	{
 		// 2개의 신호를 기다림 
 		HANDLE waits[2] = { ctrl->exitEvent, ctrl->runEvent };
+		const std::int64_t t0 = NowNs();
 		const DWORD w = ::WaitForMultipleObjects(2, waits, FALSE, INFINITE);
+		TraceComplete("WaitForMultipleObjects", "signal", t0, NowNs() - t0);
 		if (w == WAIT_OBJECT_0) // exitEvent 이면 쓰레드 종료
 			break;
 
 		// runEvent 이면 아래처리
-		std::cout << (tick ? "Tick" : "Tock") << "\n";
+		TraceInstant(tick ? "Tick" : "Tock", "signal");
+		Log() << (tick ? "Tick" : "Tock");
 		tick = !tick;
 		::Sleep(1000);
 	}
@@ -36,6 +45,58 @@ unsigned __stdcall TickTockThreadProc(void* param)
 	return 0;
 }
 
+// 게이트 비교용: TickTockThreadProc 에서 출력과 Sleep 을 뺀 반복 (반복마다 WaitForMultipleObjects)
+struct WinGateBenchArgs
+{
+	const WinThreadControl* ctrl = nullptr;
+	long long iterations = 0;
+};
+
+unsigned __stdcall EventGateBenchThreadProc(void* param)
+{
+	auto* args = static_cast<WinGateBenchArgs*>(param);
+	HANDLE waits[2] = { args->ctrl->exitEvent, args->ctrl->runEvent };
+	long long n = 0;
+	while (::WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0)
+		++n;
+	args->iterations = n;
+	return 0;
+}
+
+// durationMs 동안 워커가 통과한 반복 수. 실패 시 -1
+long long CountEventGateIterations(unsigned durationMs)
+{
+	WinThreadControl ctrl;
+	ctrl.exitEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
+	ctrl.runEvent = ::CreateEvent(nullptr, TRUE, TRUE, nullptr);
+	if (ctrl.exitEvent == nullptr || ctrl.runEvent == nullptr)
+	{
+		std::cout << "CreateEvent failed. GetLastError=" << ::GetLastError() << "\n";
+		if (ctrl.exitEvent) ::CloseHandle(ctrl.exitEvent);
+		if (ctrl.runEvent) ::CloseHandle(ctrl.runEvent);
+		return -1;
+	}
+
+	WinGateBenchArgs args;
+	args.ctrl = &ctrl;
+	const uintptr_t h = _beginthreadex(nullptr, 0, &EventGateBenchThreadProc, &args, 0, nullptr);
+	if (h == 0)
+	{
+		std::cout << "_beginthreadex failed. errno=" << errno << "\n";
+		::CloseHandle(ctrl.exitEvent);
+		::CloseHandle(ctrl.runEvent);
+		return -1;
+	}
+
+	::Sleep(durationMs);
+	::SetEvent(ctrl.exitEvent);
+	::WaitForSingleObject(reinterpret_cast<HANDLE>(h), INFINITE);
+	::CloseHandle(reinterpret_cast<HANDLE>(h));
+	::CloseHandle(ctrl.exitEvent);
+	::CloseHandle(ctrl.runEvent);
+	return args.iterations;
+}
+
 
 int WMain()
 {
@@ -78,43 +139,42 @@ int WMain()
 	HANDLE workerHandle = reinterpret_cast<HANDLE>(workerHandleRaw);
 	std::cout << "worker tid=" << workerTid << "\n";
 
+	// 콘솔 입력 핸들과 워커 스레드 핸들을 한 WaitForMultipleObjects 에 넣습니다. (30ms 폴링 대신)
+	// 스레드가 실행 중이면 → non-signaled , 스레드가 종료(Terminated) 되면 → signaled
+	InputWaitSet input;
+	input.WatchThread(workerHandle);
+	if (!input.Ok())
+		std::cout << "InputWaitSet setup failed. GetLastError=" << ::GetLastError() << "\n";
+
 	bool running = true;
-	while (true)
+	while (input.Ok() && input.Wait() == InputWait::Key)
 	{
-		if (_kbhit())
+		const int ch = _getch();
+		if (ch == 't' || ch == 'T')
 		{
-			const int ch = _getch();
-			if (ch == 't' || ch == 'T')
+			running = !running;
+			if (running)
 			{
-				running = !running;
-				if (running)
-				{
-					::SetEvent(ctrl.runEvent);  // signaled
-					std::cout << "[Main] Continue\n";
-				}
-				else
-				{
-					::ResetEvent(ctrl.runEvent); // non-signaled
-					std::cout << "[Main] Pause\n";
-				}
+				TraceInstant("SetEvent(runEvent)", "signal");
+				::SetEvent(ctrl.runEvent);  // signaled
+				Log() << "[Main] Continue";
 			}
-			else if (ch == 'q' || ch == 'Q')
+			else
 			{
-				std::cout << "[Main] Quit\n";
-				::SetEvent(ctrl.exitEvent);
-				break;
+				TraceInstant("ResetEvent(runEvent)", "signal");
+				::ResetEvent(ctrl.runEvent); // non-signaled
+				Log() << "[Main] Pause";
 			}
 		}
-
-		// 쓰레드의 종료 여부의 검사도 가능하다.
-		//스레드가 실행 중이면 → non-signaled , 스레드가 종료(Terminated) 되면 → signaled
-		const DWORD done = ::WaitForSingleObject(workerHandle, 0);
-		if (done == WAIT_OBJECT_0)
+		else if (ch == 'q' || ch == 'Q')
+		{
+			Log() << "[Main] Quit";
 			break;
-
-		// 퀀텀까지 소비하지 않고 다른 쓰레드에 양보함
-		::Sleep(30);
+		}
 	}
+	// 입력 대기를 만들지 못했거나 Quit: 워커에 종료 요청
+	TraceInstant("SetEvent(exitEvent)", "signal");
+	::SetEvent(ctrl.exitEvent);
 
 	::WaitForSingleObject(workerHandle, INFINITE);
 	::CloseHandle(workerHandle);
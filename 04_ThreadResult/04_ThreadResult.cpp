@@ -1,8 +1,48 @@
-#include "Win.hpp"
 #include "Std.hpp"
+#include "Cancel.hpp"
+#include "CoResult.hpp"
+#include "LabFuture.hpp"
+#include "ParallelSum.hpp"
+#include "PooledResult.hpp"
+#include "Reduction.hpp"
+#ifdef _WIN32
+#include "Win.hpp"
+#endif
 
-int main()
+// 전역 operator new / delete 교체 (mode=result-pool 의 할당 세기). 이 프로그램의 모든 모드가 이 operator new 를 지납니다.
+#include "../Common/AllocCounter.hpp"
+
+// 예) 04_ThreadResult mode=parallel-sum n=1000000000 grain=65536 workers=8
+//     04_ThreadResult mode=reduce max=256 workers=8 simd=avx2
+//     04_ThreadResult mode=cancel load=2 deadline=5
+//     04_ThreadResult mode=coroutine n=1000   (Task<T> 코루틴 버전)
+//     04_ThreadResult mode=result-pool rounds=2000000 inflight=64   (왕복마다 할당하는 promise vs 재사용 슬롯)
+//     04_ThreadResult api=win timeout=100   (Windows: 100ms 안에 결과가 없으면 cancelEvent 로 취소)
+//     04_ThreadResult api=std n=1000   (Windows 에서 std::promise 버전 실행)
+//     04_ThreadResult n=1000 trace=trace.json   (워커 / 결과 대기를 타임라인으로)
+int main(int argc, char** argv)
 {
-	WMain();
-	return 0;
+	const LabArgs cli(argc, argv);
+	TraceSession trace(cli);
+	const std::string mode = cli.Get("mode", "");
+	if (mode == "parallel-sum")
+		return ParallelSumMain(cli);
+	if (mode == "lab-future")
+		return LabFutureMain(cli);
+	if (mode == "reduce")
+		return ReductionMain(cli);
+	if (mode == "cancel")
+		return CancelMain(cli);
+	if (mode == "coroutine")
+		return CoResultMain(cli);
+	if (mode == "result-pool")
+		return PooledResultMain(cli);
+
+	// 워커와 메인의 결과 줄은 비동기 로그 싱크로 씁니다. (다른 모드는 std::cout 에 바로 씀)
+	AsyncLogSession log(cli);
+#ifdef _WIN32
+	if (cli.Get("api", "win") == "win")
+		return WMain(static_cast<DWORD>(cli.GetInt("timeout", kWinResultTimeoutMs)));
+#endif
+	return SMain(cli); // Win 버전은 Windows 전용
 }
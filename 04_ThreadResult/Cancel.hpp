@@ -0,0 +1,271 @@
+#pragma once
+
+// 04_ThreadResult - 취소와 deadline (mode=cancel, Common/Cancellation.hpp)
+//
+// PromiseWorker 는 한번 시작하면 끝까지 실행되고, 메인은 future.get() 에서 무한정 기다릴 수밖에 없습니다.
+// 여기서는 같은 계산을 취소 가능한 작업으로 바꿔 세 가지를 봅니다.
+//
+// 1) GetFor 시간 초과 -> 작업 취소 -> 워커가 다음 확인 지점에서 빠져나옴
+// 2) Cancel() 부터 결과(OperationCancelled)가 준비되기까지의 지연 = 워커가 풀려나는 데 걸리는 시간
+// 3) 과부하(도착률 > 처리율)에서 deadline 이 지난 작업을 버릴 때(shed)와 버리지 않을 때의 지연 / 처리량
+
+#include "../Common/Args.hpp"
+#include "../Common/Cancellation.hpp"
+#include "../Common/Future.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/ThreadPool.hpp"
+#include "../Common/Timing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 몇 번 더할 때마다 token 을 확인할지 (확인 한 번 = atomic load + NowNs)
+constexpr int kCancelCheckInterval = 1 << 14;
+
+// PromiseWorker 와 같은 계산. 250ms 지연을 1ms 씩 나눠 자며 그 사이마다 취소를 확인합니다.
+long long CancellableSumWorker(const StopToken& token, int n, int delayMs)
+{
+	for (int ms = 0; ms < delayMs; ++ms)
+	{
+		token.ThrowIfStopRequested();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	long long total = 0;
+	for (int i = 1; i <= n; ++i)
+	{
+		if ((i & (kCancelCheckInterval - 1)) == 0)
+			token.ThrowIfStopRequested();
+		total += i;
+	}
+	return total;
+}
+
+// 취소될 때까지(또는 spinNs 가 지날 때까지) CPU 를 쓰는 작업. 반환값은 끝난 시각(NowNs)
+std::int64_t BusyTask(const StopToken& token, std::int64_t spinNs)
+{
+	const std::int64_t end = NowNs() + spinNs;
+	volatile std::uint64_t sink = 0;
+	while (true)
+	{
+		for (int i = 0; i < 256; ++i)
+			sink = sink + i;
+		token.ThrowIfStopRequested();
+		const std::int64_t now = NowNs();
+		if (now >= end)
+			return now;
+	}
+}
+
+void RunTimeoutDemo(ThreadPool& pool, int n, int timeoutMs)
+{
+	std::cout << "[1] GetFor(" << timeoutMs << "ms) on a 250ms task\n";
+	std::atomic<std::int64_t> stoppedAt{ 0 };
+	CancellableFuture<long long> task = SubmitCancellable(pool, [&stoppedAt, n](const StopToken& token) {
+		try
+		{
+			return CancellableSumWorker(token, n, 250);
+		}
+		catch (const OperationCancelled&)
+		{
+			stoppedAt.store(NowNs());
+			throw;
+		}
+	});
+
+	const std::int64_t t0 = NowNs();
+	std::optional<long long> value = task.GetFor(std::chrono::milliseconds(timeoutMs));
+	const std::int64_t timedOutAt = NowNs();
+	if (value)
+	{
+		std::cout << "    result=" << *value << " (finished before the deadline)\n";
+		return;
+	}
+	std::cout << "    [Main] timed out after " << (timedOutAt - t0) / 1000000 << " ms -> Cancel()\n";
+	try
+	{
+		const long long result = task.Get();
+		std::cout << "    [Main] result=" << result << " (finished before it saw the cancel)\n";
+	}
+	catch (const OperationCancelled& e)
+	{
+		std::cout << "    [Main] exception: " << e.what()
+			<< ", worker released " << (stoppedAt.load() - timedOutAt) / 1000 << " us after Cancel()\n";
+	}
+
+	// 이미 deadline 이 지난 작업은 워커가 꺼내자마자 버립니다.
+	CancellableFuture<long long> late = SubmitCancellable(pool,
+		[n](const StopToken& token) { return CancellableSumWorker(token, n, 250); }, NowNs() - 1);
+	try
+	{
+		late.Get();
+	}
+	catch (const OperationCancelled& e)
+	{
+		std::cout << "    [Main] late task: " << e.what() << " (shed without running)\n";
+	}
+}
+
+// Cancel() -> 결과 준비까지의 지연 (ns)
+void RunCancelLatency(ThreadPool& pool, int iterations)
+{
+	std::vector<std::int64_t> samples;
+	samples.reserve(iterations);
+	for (int i = 0; i < iterations; ++i)
+	{
+		std::atomic<bool> started{ false };
+		CancellableFuture<std::int64_t> task = SubmitCancellable(pool, [&started](const StopToken& token) {
+			started.store(true, std::memory_order_release);
+			return BusyTask(token, 1000000000LL);
+		});
+		while (!started.load(std::memory_order_acquire))
+			std::this_thread::yield();
+
+		const std::int64_t t0 = NowNs();
+		task.Cancel();
+		task.Result().Wait();
+		samples.push_back(NowNs() - t0);
+		try
+		{
+			task.Get();
+		}
+		catch (const OperationCancelled&)
+		{
+		}
+	}
+	const LatencySummary s = Summarize(samples);
+	std::cout << "\n[2] Cancel() -> worker released (busy task, " << iterations << " runs): p50=" << s.p50 / 1000.0
+		<< " us p99=" << s.p99 / 1000.0 << " us max=" << s.max / 1000.0 << " us\n";
+}
+
+struct OverloadResult
+{
+	long long submitted = 0;
+	long long completed = 0;
+	long long onTime = 0;     // deadline 안에 끝남
+	long long shed = 0;       // 시작하지 않고 버림
+	long long aborted = 0;    // 실행 중 deadline 이 지나 중단
+	double sec = 0.0;         // 첫 제출 -> 마지막 결과
+	LatencySummary latencyNs; // 완료된 작업의 제출 -> 완료
+};
+
+// 도착 간격 intervalNs 로 durationMs 동안 작업(serviceNs)을 넣습니다.
+// shed 면 작업마다 deadline 을 주어 늦은 작업을 버리고, 아니면 모두 실행합니다.
+OverloadResult RunOverload(ThreadPool& pool, bool shed, std::int64_t serviceNs, std::int64_t intervalNs,
+	std::int64_t deadlineNs, int durationMs)
+{
+	struct Pending
+	{
+		std::int64_t submittedNs;
+		CancellableFuture<std::int64_t> task;
+	};
+	std::vector<Pending> pending;
+	std::atomic<long long> started{ 0 };
+
+	const std::int64_t begin = NowNs();
+	const std::int64_t stop = begin + static_cast<std::int64_t>(durationMs) * 1000000;
+	std::int64_t next = begin;
+	while (next < stop)
+	{
+		while (NowNs() < next)
+			std::this_thread::yield();
+		const std::int64_t now = NowNs();
+		pending.push_back({ now, SubmitCancellable(pool, [&started, serviceNs](const StopToken& token) {
+			started.fetch_add(1, std::memory_order_relaxed);
+			return BusyTask(token, serviceNs);
+		}, shed ? now + deadlineNs : StopState::kNoDeadline) });
+		next += intervalNs;
+	}
+
+	OverloadResult r;
+	std::vector<std::int64_t> latency;
+	for (Pending& p : pending)
+	{
+		++r.submitted;
+		try
+		{
+			const std::int64_t doneNs = p.task.Get();
+			++r.completed;
+			latency.push_back(doneNs - p.submittedNs);
+			if (doneNs - p.submittedNs <= deadlineNs)
+				++r.onTime;
+		}
+		catch (const OperationCancelled&)
+		{
+			++r.aborted;
+		}
+	}
+	r.sec = (NowNs() - begin) / 1e9;
+	r.shed = r.submitted - started.load();
+	r.aborted -= r.shed;
+	r.latencyNs = Summarize(latency);
+	return r;
+}
+
+// 인자
+// - n=N           : 타임아웃 데모의 합 (기본 100000)
+// - timeout=ms    : 타임아웃 데모의 GetFor 시간 (기본 50)
+// - iterations=N  : 취소 지연 측정 횟수 (기본 200)
+// - workers=N     : 풀 크기 (기본 hardware_concurrency)
+// - service=us    : 과부하 작업 하나의 실행 시간 (기본 200)
+// - load=X        : 도착률 / 처리율 (기본 2.0 = 처리 가능한 양의 두 배가 들어옴)
+// - deadline=ms   : 작업 deadline (기본 5)
+// - ms=N          : 과부하 구간 길이 (기본 500)
+int CancelMain(const LabArgs& cli)
+{
+	const int n = static_cast<int>(cli.GetInt("n", 100000));
+	const int timeoutMs = static_cast<int>(cli.GetInt("timeout", 50));
+	const int iterations = static_cast<int>(std::max(1LL, cli.GetInt("iterations", 200)));
+	const std::int64_t serviceNs = cli.GetInt("service", 200) * 1000;
+	const double load = std::max(0.01, cli.GetDouble("load", 2.0));
+	const std::int64_t deadlineNs = cli.GetInt("deadline", 5) * 1000000;
+	const int durationMs = static_cast<int>(cli.GetInt("ms", 500));
+
+	ThreadPool pool(static_cast<unsigned>(cli.GetInt("workers", ThreadPool::DefaultThreadCount())));
+	const std::int64_t intervalNs = std::max<std::int64_t>(1, static_cast<std::int64_t>(serviceNs / (pool.Size() * load)));
+
+	std::cout << "04_ThreadResult (cancellation tokens and deadlines, workers=" << pool.Size() << ")\n\n";
+	RunTimeoutDemo(pool, n, timeoutMs);
+	RunCancelLatency(pool, iterations);
+
+	std::cout << "\n[3] overload: service=" << serviceNs / 1000 << "us load=" << load << "x deadline="
+		<< deadlineNs / 1000000 << "ms for " << durationMs << "ms\n";
+	std::cout << std::left
+		<< std::setw(7) << "shed"
+		<< std::setw(11) << "submitted"
+		<< std::setw(11) << "completed"
+		<< std::setw(9) << "on-time"
+		<< std::setw(8) << "shed"
+		<< std::setw(9) << "aborted"
+		<< std::setw(12) << "p50(ms)"
+		<< std::setw(12) << "p99(ms)"
+		<< std::setw(11) << "drain(ms)"
+		<< "goodput/s\n";
+	for (bool shed : { false, true })
+	{
+		const OverloadResult r = RunOverload(pool, shed, serviceNs, intervalNs, deadlineNs, durationMs);
+		const std::ios::fmtflags flags = std::cout.flags();
+		std::cout << std::left << std::fixed << std::setprecision(2)
+			<< std::setw(7) << (shed ? "on" : "off")
+			<< std::setw(11) << r.submitted
+			<< std::setw(11) << r.completed
+			<< std::setw(9) << r.onTime
+			<< std::setw(8) << r.shed
+			<< std::setw(9) << r.aborted
+			<< std::setw(12) << r.latencyNs.p50 / 1e6
+			<< std::setw(12) << r.latencyNs.p99 / 1e6
+			<< std::setw(11) << (r.sec * 1000.0 - durationMs)
+			<< std::setprecision(0) << r.onTime / r.sec << "\n";
+		std::cout.flags(flags);
+	}
+	std::cout << "\nlatency = submit -> completion of completed tasks, drain = time to finish the backlog after arrivals stop\n";
+	std::cout << "goodput = tasks finished within the deadline per second\n";
+	return 0;
+}
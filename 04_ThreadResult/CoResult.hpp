@@ -0,0 +1,77 @@
+#pragma once
+
+// 04_ThreadResult - 코루틴 결과 (mode=coroutine, Common/Coroutine.hpp)
+//
+// PromiseWorker 는 250ms 동안 스레드 하나를 sleep_for 로 붙잡은 채 결과를 promise 에 넣습니다.
+// 여기서는 같은 계산을 Task<long long> 코루틴으로 씁니다.
+// - 지연은 co_await scheduler.SleepFor(250ms): 기다리는 동안 풀 스레드는 다른 코루틴을 실행
+// - 결과는 co_return, 실패는 throw: 값 / 예외가 co_await 한 쪽(또는 StartOn 의 Future)으로 전달
+// - 코루틴끼리는 co_await 로 결과를 받으므로 promise / future 를 직접 만들 필요가 없음
+//
+// 마지막으로 Task 두 개를 동시에 시작(StartOn)해, 같은 OS 스레드 하나 위에서 두 지연이 겹치는 것을 보여줍니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/Coroutine.hpp"
+#include "../Common/Platform.hpp"
+#include "../Common/Timing.hpp"
+#include "Std.hpp" // SumUpToStd
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+Task<long long> SumTask(CoScheduler& scheduler, int n, bool shouldFail)
+{
+	co_await scheduler.SleepFor(std::chrono::milliseconds(250));
+
+	if (shouldFail)
+		throw std::runtime_error("worker failed intentionally");
+	if (n < 0)
+		throw std::invalid_argument("n must be >= 0");
+
+	co_return SumUpToStd(n);
+}
+
+// 다른 Task 의 결과를 co_await 로 받아 이어서 계산합니다. (예외도 그대로 올라옴)
+Task<long long> SumTwiceTask(CoScheduler& scheduler, int n, bool shouldFail)
+{
+	const long long first = co_await SumTask(scheduler, n, false);
+	const long long second = co_await SumTask(scheduler, n, shouldFail);
+	std::cout << "[Task] both parts done on tid=" << CurrentThreadId() << "\n";
+	co_return first + second;
+}
+
+// 인자
+// - n=N    : 1 부터 n 까지의 합 (기본 100000)
+// - pool=N : 코루틴을 실행할 OS 스레드 수 (기본 1)
+int CoResultMain(const LabArgs& cli)
+{
+	const int n = static_cast<int>(cli.GetInt("n", 100000));
+	CoScheduler scheduler(static_cast<unsigned>(cli.GetInt("pool", 1)));
+
+	std::cout << "04_ThreadResult (C++20 coroutine Task<T> on " << scheduler.Size() << " pool thread(s))\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n\n";
+
+	for (bool shouldFail : { false, true })
+	{
+		std::cout << (shouldFail ? "[Main] waiting for result (failure case)...\n" : "[Main] waiting for result...\n");
+		try
+		{
+			const long long result = SyncWait(scheduler, SumTwiceTask(scheduler, n, shouldFail));
+			std::cout << "[Main] result=" << result << "\n\n";
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << "[Main] exception: " << e.what() << "\n\n";
+		}
+	}
+
+	// 250ms 지연 두 개를 동시에: 스레드가 하나여도 약 250ms 에 둘 다 끝남
+	StopWatch watch;
+	Future<long long> a = StartOn(scheduler, SumTask(scheduler, n, false));
+	Future<long long> b = StartOn(scheduler, SumTask(scheduler, n, false));
+	const long long total = a.Get() + b.Get();
+	std::cout << "[Main] two concurrent tasks: total=" << total << " in " << watch.ElapsedMs() << " ms\n";
+	return 0;
+}
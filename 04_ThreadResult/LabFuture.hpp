@@ -0,0 +1,194 @@
+#pragma once
+
+// 04_ThreadResult - 프로젝트 Future / Promise (Common/Future.hpp)
+//
+// Std 버전의 PromiseWorker 와 같은 흐름을 std::promise 대신 Promise<T> 로 실행하고,
+// std::future 에는 없는 Then / WhenAll / WhenAny 를 보여준 뒤,
+// set -> get 지연 시간(ping-pong 왕복의 절반)을 std::future 와 비교합니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/Future.hpp"
+#include "../Common/Platform.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/ThreadPool.hpp"
+#include "../Common/Timing.hpp"
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// PromiseWorker 와 같은 계산 / 예외 규칙
+void LabPromiseWorker(Promise<long long> promise, int n, bool shouldFail)
+{
+	try
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+		if (shouldFail)
+			throw std::runtime_error("worker failed intentionally");
+
+		if (n < 0)
+			throw std::invalid_argument("n must be >= 0");
+
+		long long total = 0;
+		for (int i = 1; i <= n; ++i)
+			total += i;
+		promise.SetValue(total);
+	}
+	catch (...)
+	{
+		promise.SetException(std::current_exception());
+	}
+}
+
+// set -> get 지연 측정용: std::promise / Promise<T> 를 같은 코드로 다루기 위한 오버로드
+inline void SetResult(std::promise<long long>& p, long long v) { p.set_value(v); }
+inline void SetResult(Promise<long long>& p, long long v) { p.SetValue(v); }
+inline long long GetResult(std::future<long long>& f) { return f.get(); }
+inline long long GetResult(Future<long long>& f) { return f.Get(); }
+inline std::future<long long> FutureOf(std::promise<long long>& p) { return p.get_future(); }
+inline Future<long long> FutureOf(Promise<long long>& p) { return p.GetFuture(); }
+
+// main 이 request[i] 를 set 하면 echo 스레드가 get 한 뒤 reply[i] 를 set, main 이 reply[i] 를 get.
+// 왕복 시간 / 2 = set -> get 한 번의 지연. promise/future 생성(할당)은 측정 구간 밖에서 미리 합니다.
+template <typename PromiseT>
+std::vector<std::int64_t> MeasureSetGetLatencyNs(int iterations)
+{
+	std::vector<PromiseT> requests(iterations);
+	std::vector<PromiseT> replies(iterations);
+	using FutureT = decltype(FutureOf(requests[0]));
+	std::vector<FutureT> requestFutures;
+	std::vector<FutureT> replyFutures;
+	requestFutures.reserve(iterations);
+	replyFutures.reserve(iterations);
+	for (int i = 0; i < iterations; ++i)
+	{
+		requestFutures.push_back(FutureOf(requests[i]));
+		replyFutures.push_back(FutureOf(replies[i]));
+	}
+
+	std::thread echo([&] {
+		for (int i = 0; i < iterations; ++i)
+			SetResult(replies[i], GetResult(requestFutures[i]) + 1);
+	});
+
+	std::vector<std::int64_t> samples;
+	samples.reserve(iterations);
+	for (int i = 0; i < iterations; ++i)
+	{
+		const std::int64_t t0 = NowNs();
+		SetResult(requests[i], i);
+		GetResult(replyFutures[i]);
+		samples.push_back((NowNs() - t0) / 2);
+	}
+	echo.join();
+	return samples;
+}
+
+void PrintLatencyRow(const char* name, std::vector<std::int64_t> samples)
+{
+	const LatencySummary s = Summarize(samples);
+	std::cout << std::left
+		<< std::setw(16) << name
+		<< std::setw(10) << s.min
+		<< std::setw(10) << s.p50
+		<< std::setw(10) << s.p99
+		<< std::setw(12) << s.max
+		<< std::fixed << std::setprecision(1) << s.mean << "\n";
+}
+
+// 인자
+// - iterations=N : set -> get 왕복 횟수 (기본 100000)
+int LabFutureMain(const LabArgs& cli)
+{
+	std::cout << "04_ThreadResult (project Future / Promise)\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n\n";
+
+	constexpr int n = 100000;
+
+	// 1) 성공 / 실패: PromiseWorker 와 같은 예외 전파
+	for (bool shouldFail : { false, true })
+	{
+		Promise<long long> promise;
+		Future<long long> future = promise.GetFuture();
+		std::thread worker(&LabPromiseWorker, std::move(promise), n, shouldFail);
+
+		std::cout << "[Main] waiting for result" << (shouldFail ? " (failure case)" : "") << "...\n";
+		try
+		{
+			const long long result = future.Get();
+			std::cout << "[Main] result=" << result << "\n";
+		}
+		catch (const std::exception& e)
+		{
+			std::cout << "[Main] exception: " << e.what() << "\n";
+		}
+		worker.join();
+	}
+
+	// 2) Then: 워커가 값을 채우는 순간 워커 스레드에서 이어서 실행 / 풀에서 실행
+	{
+		ThreadPool pool(2);
+		Promise<long long> promise;
+		Future<std::string> text = promise.GetFuture()
+			.Then([](long long sum) { return sum * 2; })
+			.Then(pool, [](long long doubled) { return "doubled=" + std::to_string(doubled); });
+
+		std::thread worker(&LabPromiseWorker, std::move(promise), n, false);
+		std::cout << "\n[Main] Then chain: " << text.Get() << "\n";
+		worker.join();
+	}
+
+	// 3) WhenAll / WhenAny
+	{
+		std::vector<Promise<long long>> promises(4);
+		std::vector<Future<long long>> all;
+		std::vector<Future<long long>> any;
+		std::vector<std::thread> workers;
+		for (int i = 0; i < 4; ++i)
+		{
+			Future<long long> f = promises[i].GetFuture();
+			// 같은 결과를 WhenAll 과 WhenAny 에 모두 넘기기 위해 Then 으로 두 갈래를 만듭니다.
+			Promise<long long> forAny;
+			any.push_back(forAny.GetFuture());
+			all.push_back(f.Then([p = std::make_shared<Promise<long long>>(std::move(forAny))](long long v) {
+				p->SetValue(v);
+				return v;
+			}));
+		}
+		Future<std::vector<long long>> allDone = WhenAll(std::move(all));
+		Future<WhenAnyResult<long long>> first = WhenAny(std::move(any));
+
+		for (int i = 0; i < 4; ++i)
+			workers.emplace_back(&LabPromiseWorker, std::move(promises[i]), n * (i + 1), false);
+
+		const WhenAnyResult<long long> winner = first.Get();
+		std::cout << "[Main] WhenAny: index=" << winner.index << " value=" << winner.value << "\n";
+		std::cout << "[Main] WhenAll:";
+		for (long long v : allDone.Get())
+			std::cout << " " << v;
+		std::cout << "\n";
+		for (auto& w : workers)
+			w.join();
+	}
+
+	// 4) set -> get 지연 (ns)
+	const int iterations = static_cast<int>(cli.GetInt("iterations", 100000));
+	std::cout << "\nset->get latency (ns, ping-pong RTT/2, iterations=" << iterations << ")\n";
+	std::cout << std::left
+		<< std::setw(16) << "impl"
+		<< std::setw(10) << "min"
+		<< std::setw(10) << "p50"
+		<< std::setw(10) << "p99"
+		<< std::setw(12) << "max"
+		<< "mean\n";
+	PrintLatencyRow("std::future", MeasureSetGetLatencyNs<std::promise<long long>>(iterations));
+	PrintLatencyRow("Future<T>", MeasureSetGetLatencyNs<Promise<long long>>(iterations));
+	return 0;
+}
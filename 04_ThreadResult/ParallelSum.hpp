@@ -0,0 +1,152 @@
+#pragma once
+
+// 04_ThreadResult - 분할 정복(divide-and-conquer) 병렬 합
+//
+// SumUpToStd(n) 을 워커 하나가 처음부터 끝까지 더하는 대신,
+// 구간 [lo, hi] 를 grain 크기 이하가 될 때까지 반으로 나누어 작업 훔치기 스케줄러에서 실행합니다.
+//
+//   Sum(lo, hi)
+//   ├─ Spawn: Sum(lo, mid)       <- 자기 덱에 넣어 둠 (놀고 있는 워커가 훔쳐 감)
+//   ├─ 직접 : Sum(mid + 1, hi)
+//   └─ Wait : 왼쪽 결과를 기다린 뒤 합침
+//
+// 루트 작업의 결과는 Std 버전과 같은 std::promise / std::future 통로로 메인 스레드에 전달합니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/Timing.hpp"
+#include "../Common/WorkStealing.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// [lo, hi] 구간의 합 (SumUpToStd(n) == SumRangeStd(1, n))
+long long SumRangeStd(int lo, int hi)
+{
+	long long total = 0;
+	for (int i = lo; i <= hi; ++i)
+		total += i;
+	return total;
+}
+
+long long ParallelSumRangeStd(WorkStealingScheduler& scheduler, int lo, int hi, int grain)
+{
+	if (hi - lo < grain)
+		return SumRangeStd(lo, hi);
+
+	const int mid = lo + (hi - lo) / 2;
+	long long left = 0;
+	TaskGroup children;
+	scheduler.Spawn(children, [&] { left = ParallelSumRangeStd(scheduler, lo, mid, grain); });
+	const long long right = ParallelSumRangeStd(scheduler, mid + 1, hi, grain);
+	// Wait 가 끝나기 전에는 이 함수가 반환하지 않으므로, 자식이 참조하는 left / children 은 살아 있습니다.
+	scheduler.Wait(children);
+	return left + right;
+}
+
+long long RunParallelSumUpTo(WorkStealingScheduler& scheduler, int n, int grain)
+{
+	std::promise<long long> promise;
+	std::future<long long> future = promise.get_future();
+
+	TaskGroup root;
+	scheduler.Spawn(root, [&] {
+		try
+		{
+			promise.set_value(ParallelSumRangeStd(scheduler, 1, n, grain));
+		}
+		catch (...)
+		{
+			promise.set_exception(std::current_exception());
+		}
+	});
+
+	const long long result = future.get();
+	scheduler.Wait(root);
+	return result;
+}
+
+// reps 번 실행한 것 중 가장 빠른 시간(ms)
+double MeasureParallelSumMs(WorkStealingScheduler& scheduler, int n, int grain, int reps, long long* result)
+{
+	double best = 0.0;
+	for (int r = 0; r < reps; ++r)
+	{
+		StopWatch watch;
+		*result = RunParallelSumUpTo(scheduler, n, grain);
+		const double ms = watch.ElapsedMs();
+		if (r == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+// 인자
+// - n=N (기본 1000000000), grain=N (기본 65536), reps=N (기본 3). grain / reps / workers 는 1 이상
+// - workers=N : 1 부터 N 까지 (2의 거듭제곱 + N) 워커 수를 늘려 가며 측정 (기본 hardware_concurrency)
+// - cpus=, spread=1, node=, priority=, name= : 스케줄러 워커의 속성 (Common/ThreadAttributes.hpp)
+int ParallelSumMain(const LabArgs& cli)
+{
+	const int n = static_cast<int>(cli.GetInt("n", 1000000000));
+	const int grain = static_cast<int>(std::max(1LL, cli.GetInt("grain", 65536)));
+	const int reps = static_cast<int>(std::max(1LL, cli.GetInt("reps", 3)));
+	const int maxWorkers = static_cast<int>(std::max(1LL, cli.GetInt("workers", WorkStealingScheduler::DefaultThreadCount())));
+
+	std::cout << "04_ThreadResult (divide-and-conquer sum: work-stealing vs global queue)\n";
+	const ThreadAttributes attrs = ParseThreadAttributes(cli);
+	std::cout << "n=" << n << " grain=" << grain << " reps=" << reps << "\n";
+	std::cout << "worker attributes: " << DescribeThreadAttributes(attrs) << "\n\n";
+
+	const long long expected = (static_cast<long long>(n) * (n + 1)) / 2;
+
+	StopWatch scalarWatch;
+	const long long scalar = SumRangeStd(1, n);
+	const double scalarMs = scalarWatch.ElapsedMs();
+	std::cout << "scalar (1 thread, no scheduler) " << std::fixed << std::setprecision(2) << scalarMs << " ms"
+		<< (scalar == expected ? "" : "  MISMATCH") << "\n\n";
+
+	std::vector<int> workerCounts;
+	for (int w = 1; w < maxWorkers; w *= 2)
+		workerCounts.push_back(w);
+	workerCounts.push_back(maxWorkers);
+
+	std::cout << std::left
+		<< std::setw(9) << "workers"
+		<< std::setw(14) << "steal(ms)"
+		<< std::setw(11) << "speedup"
+		<< std::setw(12) << "steals"
+		<< std::setw(14) << "global(ms)"
+		<< std::setw(11) << "speedup"
+		<< "check\n";
+
+	for (int workers : workerCounts)
+	{
+		long long wsResult = 0;
+		long long globalResult = 0;
+		double wsMs = 0.0;
+		double globalMs = 0.0;
+		std::uint64_t steals = 0;
+		{
+			WorkStealingScheduler scheduler(static_cast<unsigned>(workers), WorkStealingScheduler::QueueMode::WorkStealing, attrs);
+			wsMs = MeasureParallelSumMs(scheduler, n, grain, reps, &wsResult);
+			steals = scheduler.StealCount() / static_cast<std::uint64_t>(reps);
+		}
+		{
+			WorkStealingScheduler scheduler(static_cast<unsigned>(workers), WorkStealingScheduler::QueueMode::GlobalQueue, attrs);
+			globalMs = MeasureParallelSumMs(scheduler, n, grain, reps, &globalResult);
+		}
+
+		std::cout << std::left << std::fixed << std::setprecision(2)
+			<< std::setw(9) << workers
+			<< std::setw(14) << wsMs
+			<< std::setw(11) << scalarMs / wsMs
+			<< std::setw(12) << steals
+			<< std::setw(14) << globalMs
+			<< std::setw(11) << scalarMs / globalMs
+			<< (wsResult == expected && globalResult == expected ? "ok" : "MISMATCH") << "\n";
+	}
+	return 0;
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+// 04_ThreadResult - 재사용 결과 슬롯 (mode=result-pool, Common/ResultPool.hpp)
+//
+// 메인이 결과 통로(promise / future)를 만들어 요청을 워커에 넘기고, 나중에 결과를 get 하는 왕복을 rounds 번 반복합니다.
+// - 동시에 진행 중인 요청은 inflight 개 (메인은 inflight 개 앞의 결과를 get 한 뒤 다음 요청을 넣음)
+// - 요청은 워커마다 하나인 SpscQueue 로 넘기고, promise 는 inflight 칸짜리 배열에 두었다가 워커가 꺼내 갑니다.
+//   (큐와 배열은 미리 만들어 두므로 왕복에서 할당하는 것은 결과 통로뿐)
+// - 측정 구간 동안 AllocCountScope 로 모든 스레드의 힙 할당을 셉니다. (세는 operator new 는 04_ThreadResult.cpp 에서 Common/AllocCounter.hpp)
+//
+// 비교
+// - std::promise : 왕복마다 shared state 를 힙에 만들고(make_shared 와 비슷), 마지막 참조가 놓일 때 해제
+// - Promise<T>   : 프로젝트 Future.hpp. shared_ptr<FutureState> 를 왕복마다 만들고 해제
+// - ResultPool   : 미리 만든 슬롯을 freelist 에서 빌리고 돌려줌. 정상 상태의 할당 0 회
+
+#include "../Common/AllocCountScope.hpp" // 전역 operator new 교체는 04_ThreadResult.cpp 가 include 하는 AllocCounter.hpp
+#include "../Common/Args.hpp"
+#include "../Common/Future.hpp"
+#include "../Common/LockFreeQueue.hpp"
+#include "../Common/Locks.hpp" // SpinBackoff
+#include "../Common/ResultPool.hpp"
+#include "../Common/Timing.hpp"
+#include "LabFuture.hpp" // SetResult / GetResult / FutureOf
+#include "Std.hpp"       // SumUpToStd
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+inline void SetResult(PooledPromise<long long>& p, long long v) { p.SetValue(v); }
+inline long long GetResult(PooledFuture<long long>& f) { return f.Get(); }
+inline PooledFuture<long long> FutureOf(PooledPromise<long long>& p) { return p.GetFuture(); }
+
+struct StdResultImpl
+{
+	static constexpr const char* kName = "std::promise";
+	using PromiseT = std::promise<long long>;
+	PromiseT Make() { return PromiseT(); }
+};
+
+struct LabResultImpl
+{
+	static constexpr const char* kName = "Promise<T>";
+	using PromiseT = Promise<long long>;
+	PromiseT Make() { return PromiseT(); }
+};
+
+struct PooledResultImpl
+{
+	static constexpr const char* kName = "ResultPool";
+	using PromiseT = PooledPromise<long long>;
+	explicit PooledResultImpl(std::size_t capacity) : pool(capacity) {}
+	PromiseT Make() { return pool.Acquire(); }
+	ResultPool<long long> pool;
+};
+
+struct ResultRequest
+{
+	std::uint32_t slot = 0; // promise 배열의 칸
+	int n = 0;
+};
+
+constexpr std::uint32_t kResultRequestStop = UINT32_MAX;
+
+struct ResultPoolBenchResult
+{
+	double sec = 0.0;
+	long long rounds = 0;
+	long long allocations = 0;
+	long long bytes = 0;
+	bool ok = false;
+};
+
+// 워커: 요청을 꺼내 promise 를 배열에서 가져온 뒤(move) 결과를 채웁니다.
+// 메인은 그 칸의 결과를 get 한 뒤에야 칸을 다시 쓰므로, 꺼내 가는 것과 다시 쓰는 것이 겹치지 않습니다.
+template <typename PromiseT>
+void ResultEchoWorker(SpscQueue<ResultRequest>* inbox, std::vector<PromiseT>* promises)
+{
+	SpinBackoff backoff;
+	ResultRequest request;
+	while (true)
+	{
+		if (!inbox->TryPop(request))
+		{
+			backoff.Pause();
+			continue;
+		}
+		backoff.Reset();
+		if (request.slot == kResultRequestStop)
+			return;
+		PromiseT promise = std::move((*promises)[request.slot]);
+		SetResult(promise, SumUpToStd(request.n));
+	}
+}
+
+template <typename Impl>
+ResultPoolBenchResult RunResultRoundTrips(Impl& impl, int workers, int inflight, long long rounds, int n)
+{
+	using PromiseT = typename Impl::PromiseT;
+	using FutureT = decltype(FutureOf(std::declval<PromiseT&>()));
+
+	std::vector<PromiseT> promises(inflight);
+	std::vector<FutureT> futures(inflight);
+	std::vector<std::unique_ptr<SpscQueue<ResultRequest>>> inboxes;
+	std::vector<std::thread> threads;
+	for (int w = 0; w < workers; ++w)
+		inboxes.push_back(std::make_unique<SpscQueue<ResultRequest>>(static_cast<std::size_t>(inflight) + 1));
+	for (int w = 0; w < workers; ++w)
+		threads.emplace_back(&ResultEchoWorker<PromiseT>, inboxes[w].get(), &promises);
+
+	auto push = [](SpscQueue<ResultRequest>& inbox, const ResultRequest& request) {
+		SpinBackoff backoff;
+		while (!inbox.TryPush(request))
+			backoff.Pause();
+	};
+
+	long long sum = 0;
+	long long seq = 0;
+	// 한 번 왕복: inflight 개 앞의 결과를 받고, 그 칸에 새 통로를 만들어 요청을 넣습니다.
+	auto roundTrip = [&] {
+		const std::uint32_t slot = static_cast<std::uint32_t>(seq % inflight);
+		if (seq >= inflight)
+			sum += GetResult(futures[slot]);
+		promises[slot] = impl.Make();
+		futures[slot] = FutureOf(promises[slot]);
+		push(*inboxes[seq % workers], ResultRequest{ slot, n });
+		++seq;
+	};
+
+	// 준비: 배열 / 큐 / 풀이 모두 한 바퀴 쓰이도록 (첫 사용의 할당은 세지 않음)
+	for (int i = 0; i < inflight * 2; ++i)
+		roundTrip();
+
+	ResultPoolBenchResult r;
+	{
+		AllocCountScope count;
+		StopWatch watch;
+		for (long long i = 0; i < rounds; ++i)
+			roundTrip();
+		r.sec = watch.ElapsedSec();
+		count.Stop();
+		r.allocations = count.Allocations();
+		r.bytes = count.Bytes();
+	}
+
+	// 남은 inflight 개의 결과 (칸마다 하나씩 진행 중)
+	for (int i = 0; i < inflight; ++i)
+		sum += GetResult(futures[i]);
+	for (auto& inbox : inboxes)
+		push(*inbox, ResultRequest{ kResultRequestStop, 0 });
+	for (auto& th : threads)
+		th.join();
+
+	r.rounds = rounds;
+	r.ok = (sum == seq * SumUpToStd(n));
+	return r;
+}
+
+inline void PrintResultPoolRow(const char* name, const ResultPoolBenchResult& r)
+{
+	const std::ios::fmtflags flags = std::cout.flags();
+	const double rounds = static_cast<double>(r.rounds);
+	std::cout << std::left
+		<< std::setw(14) << name
+		<< std::setw(13) << std::scientific << std::setprecision(3) << (r.sec > 0.0 ? rounds / r.sec : 0.0)
+		<< std::setw(11) << std::fixed << std::setprecision(1) << (r.rounds > 0 ? r.sec * 1e9 / rounds : 0.0)
+		<< std::setw(12) << r.allocations
+		<< std::setw(11) << std::setprecision(2) << (r.rounds > 0 ? r.allocations / rounds : 0.0)
+		<< std::setw(11) << std::setprecision(1) << (r.rounds > 0 ? r.bytes / rounds : 0.0)
+		<< (r.ok ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - result=all|std|future|pool : 측정할 결과 통로 (기본 all)
+// - rounds=N   : 측정 구간의 submit / get 왕복 수 (기본 1000000)
+// - inflight=K : 동시에 진행 중인 요청 수 (기본 64)
+// - workers=W  : 결과를 채우는 워커 수 (기본 2)
+// - n=N        : 워커가 요청마다 더하는 1..N (기본 16)
+// - pool=N     : ResultPool 슬롯 수 (기본 inflight * 2, inflight..UINT32_MAX-1 로 제한. 남는 슬롯은 워커가 아직 놓지 않은 슬롯의 여유)
+int PooledResultMain(const LabArgs& cli)
+{
+	const std::string which = cli.Get("result", "all");
+	if (which != "all" && which != "std" && which != "future" && which != "pool")
+	{
+		std::cout << "unknown result=" << which << "\n";
+		return 1;
+	}
+	const long long rounds = cli.GetInt("rounds", 1000000);
+	const int inflight = static_cast<int>(std::max(1LL, cli.GetInt("inflight", 64)));
+	const int workers = static_cast<int>(std::max(1LL, cli.GetInt("workers", 2)));
+	const int n = static_cast<int>(cli.GetInt("n", 16));
+	// 메인이 inflight 개의 future 를 들고 있으므로 슬롯이 그보다 적으면 Acquire 가 영원히 기다립니다.
+	// 위쪽은 ResultPool 의 32비트 슬롯 번호 (UINT32_MAX 는 빈 freelist 표시)
+	const std::size_t poolSize = static_cast<std::size_t>(
+		std::clamp(cli.GetInt("pool", inflight * 2LL), static_cast<long long>(inflight), static_cast<long long>(UINT32_MAX - 1)));
+
+	std::cout << "04_ThreadResult (result channel per submit/get round trip, rounds=" << rounds << " inflight=" << inflight
+		<< " workers=" << workers << " n=" << n << " pool=" << poolSize << ")\n\n";
+	std::cout << std::left
+		<< std::setw(14) << "impl"
+		<< std::setw(13) << "rounds/sec"
+		<< std::setw(11) << "ns/round"
+		<< std::setw(12) << "allocs"
+		<< std::setw(11) << "allocs/rt"
+		<< std::setw(11) << "bytes/rt"
+		<< "check\n";
+
+	if (which == "all" || which == "std")
+	{
+		StdResultImpl impl;
+		PrintResultPoolRow(StdResultImpl::kName, RunResultRoundTrips(impl, workers, inflight, rounds, n));
+	}
+	if (which == "all" || which == "future")
+	{
+		LabResultImpl impl;
+		PrintResultPoolRow(LabResultImpl::kName, RunResultRoundTrips(impl, workers, inflight, rounds, n));
+	}
+	if (which == "all" || which == "pool")
+	{
+		PooledResultImpl impl(poolSize);
+		PrintResultPoolRow(PooledResultImpl::kName, RunResultRoundTrips(impl, workers, inflight, rounds, n));
+	}
+
+	std::cout << "\nallocs = heap allocations on all threads during the measured rounds (global operator new, Common/AllocCounter.hpp)\n";
+	return 0;
+}
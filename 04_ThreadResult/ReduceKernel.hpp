@@ -0,0 +1,217 @@
+#pragma once
+
+// 04_ThreadResult - 합 커널 (scalar / SSE2 / AVX2)
+//
+// 한 스레드가 맡은 구간을 더하는 가장 안쪽 루프입니다. Reduction.hpp 의 모든 백엔드가 이 커널을 씁니다.
+//
+// - SumArray(level, data, n) : int32 배열의 합 (int64 로 넓혀서 누적, 넘침 없음)
+// - SumRange(level, lo, hi)  : lo 부터 hi 까지 정수의 합 (SumRangeStd 의 벡터 버전)
+//
+// 명령어 집합은 실행 중에 고릅니다. (DetectSimdLevel)
+// GCC / Clang 은 함수 단위 target("avx2") 속성으로 컴파일하므로 -mavx2 없이 빌드해도 되고,
+// AVX2 가 없는 CPU 에서는 그 함수를 부르지 않습니다. x86 이 아니면 scalar 만 있습니다.
+//
+// scalar 는 비교 기준이므로 컴파일러 자동 벡터화를 끕니다. (THREADLAB_NO_VECTORIZE)
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define THREADLAB_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__clang__)
+#define THREADLAB_NO_VECTORIZE
+#define THREADLAB_SCALAR_LOOP _Pragma("clang loop vectorize(disable) interleave(disable)")
+#define THREADLAB_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__GNUC__)
+#define THREADLAB_NO_VECTORIZE __attribute__((optimize("no-tree-vectorize")))
+#define THREADLAB_SCALAR_LOOP
+#define THREADLAB_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define THREADLAB_NO_VECTORIZE
+#define THREADLAB_SCALAR_LOOP __pragma(loop(no_vector))
+#define THREADLAB_TARGET_AVX2
+#else
+#define THREADLAB_NO_VECTORIZE
+#define THREADLAB_SCALAR_LOOP
+#define THREADLAB_TARGET_AVX2
+#endif
+
+enum class SimdLevel
+{
+	Scalar,
+	Sse2,
+	Avx2,
+};
+
+inline const char* SimdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::Scalar: return "scalar";
+	case SimdLevel::Sse2:   return "sse2";
+	case SimdLevel::Avx2:   return "avx2";
+	}
+	return "?";
+}
+
+// 이 CPU(와 OS)가 실행할 수 있는 가장 넓은 명령어 집합
+inline SimdLevel DetectSimdLevel()
+{
+#if defined(THREADLAB_X86)
+#if defined(_MSC_VER)
+	int regs[4] = {};
+	__cpuid(regs, 1);
+	const bool osxsave = (regs[2] & (1 << 27)) != 0;
+	const bool avx = (regs[2] & (1 << 28)) != 0;
+	// OS 가 YMM 레지스터를 문맥 교환 때 저장해 주는지 (XCR0 의 SSE / AVX 비트)
+	const bool ymmSaved = osxsave && (_xgetbv(0) & 0x6) == 0x6;
+	__cpuidex(regs, 7, 0);
+	const bool avx2 = (regs[1] & (1 << 5)) != 0;
+	return (avx && ymmSaved && avx2) ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#endif
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+THREADLAB_NO_VECTORIZE
+inline std::int64_t SumArrayScalar(const std::int32_t* data, std::size_t n)
+{
+	std::int64_t total = 0;
+	THREADLAB_SCALAR_LOOP
+	for (std::size_t i = 0; i < n; ++i)
+		total += data[i];
+	return total;
+}
+
+THREADLAB_NO_VECTORIZE
+inline std::int64_t SumRangeScalar(std::int64_t lo, std::int64_t hi)
+{
+	std::int64_t total = 0;
+	THREADLAB_SCALAR_LOOP
+	for (std::int64_t i = lo; i <= hi; ++i)
+		total += i;
+	return total;
+}
+
+#if defined(THREADLAB_X86)
+inline std::int64_t HorizontalSum(__m128i v)
+{
+	alignas(16) std::int64_t lanes[2];
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+	return lanes[0] + lanes[1];
+}
+
+// SSE2 에는 32 -> 64비트 부호 확장 명령이 없으므로, 부호 비트를 만든 뒤 unpack 으로 붙입니다.
+inline std::int64_t SumArraySse2(const std::int32_t* data, std::size_t n)
+{
+	__m128i acc0 = _mm_setzero_si128();
+	__m128i acc1 = _mm_setzero_si128();
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		const __m128i sign = _mm_srai_epi32(v, 31);
+		acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(v, sign));
+		acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(v, sign));
+	}
+	return HorizontalSum(_mm_add_epi64(acc0, acc1)) + SumArrayScalar(data + i, n - i);
+}
+
+inline std::int64_t SumRangeSse2(std::int64_t lo, std::int64_t hi)
+{
+	if (hi < lo)
+		return 0;
+	const std::int64_t count = hi - lo + 1;
+	__m128i index = _mm_set_epi64x(lo + 1, lo);
+	const __m128i step = _mm_set1_epi64x(2);
+	__m128i acc = _mm_setzero_si128();
+	std::int64_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		acc = _mm_add_epi64(acc, index);
+		index = _mm_add_epi64(index, step);
+	}
+	return HorizontalSum(acc) + SumRangeScalar(lo + i, hi);
+}
+
+THREADLAB_TARGET_AVX2
+inline std::int64_t SumArrayAvx2(const std::int32_t* data, std::size_t n)
+{
+	// 누적기 네 개: 덧셈 지연(latency)을 가리고 load 두 개를 한 사이클에 처리하도록
+	__m256i acc0 = _mm256_setzero_si256();
+	__m256i acc1 = _mm256_setzero_si256();
+	__m256i acc2 = _mm256_setzero_si256();
+	__m256i acc3 = _mm256_setzero_si256();
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8));
+		acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)));
+		acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+		acc2 = _mm256_add_epi64(acc2, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(b)));
+		acc3 = _mm256_add_epi64(acc3, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(b, 1)));
+	}
+	const __m256i acc = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1), _mm256_add_epi64(acc2, acc3));
+	const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+	return HorizontalSum(half) + SumArrayScalar(data + i, n - i);
+}
+
+THREADLAB_TARGET_AVX2
+inline std::int64_t SumRangeAvx2(std::int64_t lo, std::int64_t hi)
+{
+	if (hi < lo)
+		return 0;
+	const std::int64_t count = hi - lo + 1;
+	__m256i index0 = _mm256_set_epi64x(lo + 3, lo + 2, lo + 1, lo);
+	__m256i index1 = _mm256_add_epi64(index0, _mm256_set1_epi64x(4));
+	const __m256i step = _mm256_set1_epi64x(8);
+	__m256i acc0 = _mm256_setzero_si256();
+	__m256i acc1 = _mm256_setzero_si256();
+	std::int64_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		acc0 = _mm256_add_epi64(acc0, index0);
+		acc1 = _mm256_add_epi64(acc1, index1);
+		index0 = _mm256_add_epi64(index0, step);
+		index1 = _mm256_add_epi64(index1, step);
+	}
+	const __m256i acc = _mm256_add_epi64(acc0, acc1);
+	const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+	return HorizontalSum(half) + SumRangeScalar(lo + i, hi);
+}
+#endif
+
+inline std::int64_t SumArray(SimdLevel level, const std::int32_t* data, std::size_t n)
+{
+#if defined(THREADLAB_X86)
+	if (level == SimdLevel::Avx2)
+		return SumArrayAvx2(data, n);
+	if (level == SimdLevel::Sse2)
+		return SumArraySse2(data, n);
+#endif
+	(void)level;
+	return SumArrayScalar(data, n);
+}
+
+inline std::int64_t SumRange(SimdLevel level, std::int64_t lo, std::int64_t hi)
+{
+#if defined(THREADLAB_X86)
+	if (level == SimdLevel::Avx2)
+		return SumRangeAvx2(lo, hi);
+	if (level == SimdLevel::Sse2)
+		return SumRangeSse2(lo, hi);
+#endif
+	(void)level;
+	return SumRangeScalar(lo, hi);
+}
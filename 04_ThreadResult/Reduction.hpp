@@ -0,0 +1,376 @@
+#pragma once
+
+// 04_ThreadResult - 병렬 리덕션 엔진 (mode=reduce)
+//
+// SumUpToStd(n) 은 워커 하나가 scalar 루프로 더합니다. 같은 "합" 을 아래 백엔드로 일반화해
+// 데이터 크기가 L1 에서 DRAM 까지 커질 때 처리량(GB/s, elements/sec)이 어떻게 변하는지 봅니다.
+//
+// | 백엔드    | 계산                                                                 |
+// |-----------|----------------------------------------------------------------------|
+// | scalar    | 워커 하나, 자동 벡터화를 끈 루프 (기준)                              |
+// | simd      | 워커 하나, AVX2 / SSE2 커널 (ReduceKernel.hpp, 실행 중 선택)         |
+// | threads   | 워커 N 개가 구간을 나눠 simd 커널로 부분합(partial)을 만들고 메인이 합침 |
+// | par-unseq | std::transform_reduce(std::execution::par_unseq) (라이브러리에 맡김)  |
+//
+// 모든 백엔드는 결과를 기존 Std 버전과 같은 통로로 돌려줍니다.
+// 부분 작업마다 std::promise 를 워커 풀에 넘기고, 메인 스레드는 std::future::get() 으로 받아 합칩니다.
+// (워커는 미리 만든 ThreadPool 이므로 측정에 스레드 생성 비용이 섞이지 않습니다)
+//
+// par-unseq 는 MSVC 는 기본 지원, libstdc++ 는 TBB 백엔드가 필요합니다. (CMake 가 TBB 를 찾으면 THREADLAB_HAS_TBB)
+
+#include "../Common/Args.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/ThreadAttributes.hpp"
+#include "../Common/ThreadPool.hpp"
+#include "../Common/Timing.hpp"
+#include "ReduceKernel.hpp"
+
+#if defined(_MSC_VER) || defined(THREADLAB_HAS_TBB)
+#define THREADLAB_PAR_UNSEQ 1
+#include <execution>
+#include <functional>
+#include <numeric>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class ReduceBackend
+{
+	Scalar,
+	Simd,
+	Threads,
+	ParUnseq,
+};
+
+constexpr ReduceBackend kAllReduceBackends[] = {
+	ReduceBackend::Scalar,
+	ReduceBackend::Simd,
+	ReduceBackend::Threads,
+	ReduceBackend::ParUnseq,
+};
+
+inline const char* ReduceBackendName(ReduceBackend backend)
+{
+	switch (backend)
+	{
+	case ReduceBackend::Scalar:   return "scalar";
+	case ReduceBackend::Simd:     return "simd";
+	case ReduceBackend::Threads:  return "threads";
+	case ReduceBackend::ParUnseq: return "par-unseq";
+	}
+	return "?";
+}
+
+inline bool ReduceBackendAvailable(ReduceBackend backend)
+{
+#if defined(THREADLAB_PAR_UNSEQ)
+	(void)backend;
+	return true;
+#else
+	return backend != ReduceBackend::ParUnseq;
+#endif
+}
+
+struct ReduceConfig
+{
+	ThreadPool* pool = nullptr;
+	SimdLevel level = SimdLevel::Scalar; // simd / threads 백엔드의 커널
+	unsigned parts = 1;                  // threads 백엔드의 부분 작업 수
+};
+
+// 부분 작업 하나: 워커 풀에서 f() 를 실행하고 결과(또는 예외)를 promise 에 채웁니다.
+template <typename F>
+std::future<std::int64_t> SubmitPartial(ThreadPool& pool, F f)
+{
+	auto promise = std::make_shared<std::promise<std::int64_t>>();
+	std::future<std::int64_t> future = promise->get_future();
+	pool.Submit([promise, f] {
+		try
+		{
+			promise->set_value(f());
+		}
+		catch (...)
+		{
+			promise->set_exception(std::current_exception());
+		}
+	});
+	return future;
+}
+
+// 부분 작업 수에 맞춰 [0, n) 을 나눕니다. 경계는 캐시 라인(int32 16개) 단위로 맞춥니다.
+inline std::size_t PartialChunk(std::size_t n, unsigned parts)
+{
+	const std::size_t chunk = (n + parts - 1) / parts;
+	return (chunk + 15) / 16 * 16;
+}
+
+inline std::int64_t ReduceArray(ReduceBackend backend, const ReduceConfig& config, const std::int32_t* data, std::size_t n)
+{
+	std::vector<std::future<std::int64_t>> partials;
+	switch (backend)
+	{
+	case ReduceBackend::Scalar:
+		partials.push_back(SubmitPartial(*config.pool, [=] { return SumArrayScalar(data, n); }));
+		break;
+
+	case ReduceBackend::Simd:
+	{
+		const SimdLevel level = config.level;
+		partials.push_back(SubmitPartial(*config.pool, [=] { return SumArray(level, data, n); }));
+		break;
+	}
+
+	case ReduceBackend::Threads:
+	{
+		const SimdLevel level = config.level;
+		const std::size_t chunk = PartialChunk(n, std::max(1u, config.parts));
+		for (std::size_t begin = 0; begin < n; begin += chunk)
+		{
+			const std::size_t count = std::min(chunk, n - begin);
+			partials.push_back(SubmitPartial(*config.pool, [=] { return SumArray(level, data + begin, count); }));
+		}
+		break;
+	}
+
+	case ReduceBackend::ParUnseq:
+#if defined(THREADLAB_PAR_UNSEQ)
+		partials.push_back(SubmitPartial(*config.pool, [=] {
+			return std::transform_reduce(std::execution::par_unseq, data, data + n, std::int64_t{ 0 },
+				std::plus<>(), [](std::int32_t v) { return static_cast<std::int64_t>(v); });
+		}));
+#endif
+		break;
+	}
+
+	std::int64_t total = 0;
+	for (auto& partial : partials)
+		total += partial.get();
+	return total;
+}
+
+// [lo, hi] 의 합 (SumUpToStd 의 일반화). par-unseq 는 배열이 필요하므로 없습니다.
+inline std::int64_t ReduceRange(ReduceBackend backend, const ReduceConfig& config, std::int64_t lo, std::int64_t hi)
+{
+	std::vector<std::future<std::int64_t>> partials;
+	const SimdLevel level = backend == ReduceBackend::Scalar ? SimdLevel::Scalar : config.level;
+	const unsigned parts = backend == ReduceBackend::Threads ? std::max(1u, config.parts) : 1u;
+	const std::int64_t count = hi - lo + 1;
+	const std::int64_t chunk = (count + parts - 1) / parts;
+	for (std::int64_t begin = lo; begin <= hi; begin += chunk)
+	{
+		const std::int64_t end = std::min(hi, begin + chunk - 1);
+		partials.push_back(SubmitPartial(*config.pool, [=] { return SumRange(level, begin, end); }));
+	}
+
+	std::int64_t total = 0;
+	for (auto& partial : partials)
+		total += partial.get();
+	return total;
+}
+
+// 데이터 / 통합 캐시의 크기 (레벨 순, KB). 알 수 없으면 빈 목록
+inline std::vector<long long> DataCacheSizesKb()
+{
+	std::vector<long long> out;
+#if defined(_WIN32)
+	DWORD bytes = 0;
+	::GetLogicalProcessorInformation(nullptr, &bytes);
+	std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(bytes / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+	if (info.empty() || !::GetLogicalProcessorInformation(info.data(), &bytes))
+		return out;
+	for (const auto& entry : info)
+	{
+		if (entry.Relationship != RelationCache || entry.Cache.Type == CacheInstruction)
+			continue;
+		const std::size_t level = entry.Cache.Level;
+		if (out.size() < level)
+			out.resize(level, 0);
+		out[level - 1] = std::max<long long>(out[level - 1], entry.Cache.Size / 1024);
+	}
+#else
+	for (int index = 0; index < 8; ++index)
+	{
+		const std::string base = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+		std::string type;
+		if (!ReadSysfsText(base + "type", &type))
+			break;
+		if (type.rfind("Instruction", 0) == 0)
+			continue;
+		const int level = ReadSysfsInt(base + "level", 0);
+		std::string size;
+		if (level <= 0 || !ReadSysfsText(base + "size", &size))
+			continue;
+		if (out.size() < static_cast<std::size_t>(level))
+			out.resize(level, 0);
+		out[level - 1] = std::atoll(size.c_str()); // "48K"
+	}
+#endif
+	return out;
+}
+
+// bytes 가 들어가는 가장 작은 캐시 레벨 이름 (L1, L2, ... 또는 DRAM)
+inline std::string FitsIn(long long bytes, const std::vector<long long>& cacheKb)
+{
+	for (std::size_t i = 0; i < cacheKb.size(); ++i)
+	{
+		if (cacheKb[i] > 0 && bytes <= cacheKb[i] * 1024)
+			return "L" + std::to_string(i + 1);
+	}
+	return cacheKb.empty() ? "?" : "DRAM";
+}
+
+inline std::string SizeLabel(long long bytes)
+{
+	if (bytes >= (1LL << 20))
+		return std::to_string(bytes >> 20) + "M";
+	return std::to_string(bytes >> 10) + "K";
+}
+
+// 한 번 호출의 시간 중앙값(ns). 적어도 5번, 합쳐서 workBytes 정도를 처리할 만큼 호출합니다.
+template <typename F>
+std::int64_t MedianCallNs(long long bytesPerCall, long long workBytes, F call)
+{
+	const long long calls = std::max(5LL, workBytes / std::max(1LL, bytesPerCall));
+	std::vector<std::int64_t> samples;
+	samples.reserve(static_cast<std::size_t>(calls));
+	for (long long i = 0; i < calls; ++i)
+	{
+		const std::int64_t t0 = NowNs();
+		call();
+		samples.push_back(NowNs() - t0);
+	}
+	return Summarize(samples).p50;
+}
+
+inline void PrintReduceHeader(bool withBytes)
+{
+	std::cout << std::left
+		<< std::setw(8) << "size"
+		<< std::setw(6) << "fits"
+		<< std::setw(11) << "backend"
+		<< std::setw(12) << "time(us)";
+	if (withBytes)
+		std::cout << std::setw(9) << "GB/s";
+	std::cout
+		<< std::setw(12) << "Gelem/s"
+		<< std::setw(10) << "speedup"
+		<< "check\n";
+}
+
+inline void PrintReduceRow(const std::string& size, const std::string& fits, ReduceBackend backend,
+	std::int64_t ns, long long elements, long long bytes, double scalarNs, bool ok)
+{
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left << std::fixed
+		<< std::setw(8) << size
+		<< std::setw(6) << fits
+		<< std::setw(11) << ReduceBackendName(backend)
+		<< std::setw(12) << std::setprecision(1) << ns / 1e3;
+	if (bytes > 0)
+		std::cout << std::setw(9) << std::setprecision(2) << (ns > 0 ? static_cast<double>(bytes) / ns : 0.0);
+	std::cout
+		<< std::setw(12) << std::setprecision(3) << (ns > 0 ? static_cast<double>(elements) / ns : 0.0)
+		<< std::setw(10) << std::setprecision(2) << (ns > 0 ? scalarNs / ns : 0.0)
+		<< (ok ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - max=MB     : 가장 큰 배열 크기 (기본 max(64, LLC x 4), 1 ~ 1024). 16KB 부터 4배씩 키워 max 까지
+// - work=MB    : 크기 / 백엔드 한 칸에서 처리할 총량 (기본 256, 1 이상). 작은 배열은 여러 번 호출해 중앙값을 씀
+// - simd=scalar|sse2|avx2 : simd / threads 백엔드의 커널 (기본 이 CPU 가 지원하는 가장 넓은 것)
+// - workers=N  : 워커 풀 크기 = threads 백엔드의 부분 작업 수 (기본 hardware_concurrency)
+// - n=N        : 범위 합 [1, n] 표의 n (기본 100000000, 0 이면 생략)
+// - cpus=, spread=1, node=, priority=, name= : 워커 속성 (Common/ThreadAttributes.hpp)
+int ReductionMain(const LabArgs& cli)
+{
+	const std::vector<long long> cacheKb = DataCacheSizesKb();
+	const long long llcMb = cacheKb.empty() ? 0 : cacheKb.back() / 1024;
+	const long long maxMb = std::clamp(cli.GetInt("max", std::max(64LL, llcMb * 4)), 1LL, 1024LL);
+	const long long workBytes = std::max(1LL, cli.GetInt("work", 256)) << 20;
+	const long long rangeN = cli.GetInt("n", 100000000);
+
+	SimdLevel level = DetectSimdLevel();
+	const std::string simdName = cli.Get("simd", SimdLevelName(level));
+	if (simdName == "scalar")
+		level = SimdLevel::Scalar;
+	else if (simdName == "sse2" && level != SimdLevel::Scalar)
+		level = SimdLevel::Sse2;
+	else if (simdName != SimdLevelName(level))
+	{
+		std::cout << "simd=" << simdName << " is not supported on this CPU (best: " << SimdLevelName(level) << ")\n";
+		return 1;
+	}
+
+	const ThreadAttributes attrs = ParseThreadAttributes(cli);
+	ThreadPool pool(static_cast<unsigned>(cli.GetInt("workers", ThreadPool::DefaultThreadCount())), attrs);
+	ReduceConfig config;
+	config.pool = &pool;
+	config.level = level;
+	config.parts = static_cast<unsigned>(pool.Size());
+
+	std::cout << "04_ThreadResult (reduction engine: scalar / simd / threads / par-unseq)\n";
+	std::cout << "simd=" << SimdLevelName(level) << " workers=" << pool.Size()
+		<< " par-unseq=" << (ReduceBackendAvailable(ReduceBackend::ParUnseq) ? "yes" : "no (needs TBB or MSVC)") << "\n";
+	std::cout << "caches:";
+	for (std::size_t i = 0; i < cacheKb.size(); ++i)
+		std::cout << " L" << (i + 1) << "=" << cacheKb[i] << "K";
+	std::cout << (cacheKb.empty() ? " unknown" : "") << "\n\n";
+
+	// 배열: 가장 큰 크기로 한 번 만들고, 작은 크기는 앞부분만 사용 (값은 -500 ~ 499)
+	const std::size_t maxElements = static_cast<std::size_t>(maxMb << 20) / sizeof(std::int32_t);
+	std::vector<std::int32_t> data(maxElements);
+	for (std::size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<std::int32_t>(i % 1000) - 500;
+
+	std::vector<long long> sizes;
+	for (long long bytes = 16 << 10; bytes < (maxMb << 20); bytes *= 4)
+		sizes.push_back(bytes);
+	sizes.push_back(maxMb << 20);
+
+	PrintReduceHeader(true);
+	for (long long bytes : sizes)
+	{
+		const std::size_t n = static_cast<std::size_t>(bytes) / sizeof(std::int32_t);
+		const std::int64_t expected = SumArrayScalar(data.data(), n);
+		double scalarNs = 0.0;
+		for (ReduceBackend backend : kAllReduceBackends)
+		{
+			if (!ReduceBackendAvailable(backend))
+				continue;
+			std::int64_t result = 0;
+			const std::int64_t ns = MedianCallNs(bytes, workBytes, [&] { result = ReduceArray(backend, config, data.data(), n); });
+			if (backend == ReduceBackend::Scalar)
+				scalarNs = static_cast<double>(ns);
+			PrintReduceRow(SizeLabel(bytes), FitsIn(bytes, cacheKb), backend, ns, static_cast<long long>(n), bytes, scalarNs, result == expected);
+		}
+	}
+
+	if (rangeN > 0)
+	{
+		std::cout << "\nrange sum [1, " << rangeN << "] (no memory traffic, SumUpToStd generalized)\n";
+		PrintReduceHeader(false);
+		const std::int64_t expected = rangeN * (rangeN + 1) / 2;
+		double scalarNs = 0.0;
+		for (ReduceBackend backend : { ReduceBackend::Scalar, ReduceBackend::Simd, ReduceBackend::Threads })
+		{
+			std::int64_t result = 0;
+			const std::int64_t ns = MedianCallNs(1, 3, [&] { result = ReduceRange(backend, config, 1, rangeN); });
+			if (backend == ReduceBackend::Scalar)
+				scalarNs = static_cast<double>(ns);
+			PrintReduceRow("-", "-", backend, ns, rangeN, 0, scalarNs, result == expected);
+		}
+	}
+
+	std::cout << "\ntime = median per call (submit -> future.get), GB/s = array bytes / time, speedup = vs scalar\n";
+	return 0;
+}
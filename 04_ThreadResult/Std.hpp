@@ -1,6 +1,9 @@
 #pragma once
 
-#include <Windows.h>
+#include "../Common/Args.hpp"
+#include "../Common/AsyncLog.hpp"
+#include "../Common/Platform.hpp"
+#include "../Common/Trace.hpp"
 
 #include <chrono>
 #include <exception>
@@ -47,6 +50,8 @@ long long SumUpToStd(int n)
 
 void PromiseWorker(std::promise<long long> promise, int n, bool shouldFail)
 {
+	TraceThreadName("PromiseWorker");
+	TraceScope scope("PromiseWorker", "lifecycle");
 	try
 	{
 		// (데모) 메인 스레드가 기다리는 상황을 보여주기 위해 잠깐 지연
@@ -60,22 +65,32 @@ void PromiseWorker(std::promise<long long> promise, int n, bool shouldFail)
 			throw std::invalid_argument("n must be >= 0");
 
 		// 정상 케이스: 계산 결과를 promise에 저장(=메인 스레드에게 전달)
-		promise.set_value(SumUpToStd(n));
+		const long long sum = SumUpToStd(n);
+		TraceInstant("set_value", "result", sum);
+		Log() << "[PromiseWorker] set_value(" << sum << ") tid=" << CurrentThreadId();
+		promise.set_value(sum);
 	}
 	catch (...)
 	{
 		// 실패 케이스: 예외를 promise에 저장(=메인 스레드 get()에서 다시 throw)
+		TraceInstant("set_exception", "result");
+		Log() << "[PromiseWorker] set_exception tid=" << CurrentThreadId();
 		promise.set_exception(std::current_exception());
 	}
 }
 
 
-int SMain()
+// 인자
+// - n=N : 1 부터 n 까지의 합을 계산 (기본 kSumN)
+// - trace=path : 워커 구간, set_value / set_exception, future.get 대기를 Chrome trace 로 기록 (main 의 TraceSession)
+// - log=sync : 워커와 [Main] 줄을 비동기 로그 싱크 대신 바로 출력 (main 의 AsyncLogSession)
+int SMain(const LabArgs& cli)
 {
-	std::cout << "04_ThreadResult (std::promise / std::future)\n";
-	std::cout << "main tid=" << ::GetCurrentThreadId() << "\n\n";
+	constexpr int kSumN = 100000;
+	const int n = static_cast<int>(cli.GetInt("n", kSumN));
 
-	constexpr int n = 100000;
+	std::cout << "04_ThreadResult (std::promise / std::future)\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n\n";
 
 	{
 		// 성공 케이스
@@ -85,22 +100,23 @@ int SMain()
 
 		std::thread worker(&PromiseWorker, std::move(promise), n, false);
 
-		std::cout << "[Main] waiting for result...\n";
+		Log() << "[Main] waiting for result...";
 		try
 		{
 			// 결과가 준비될 때까지 대기 후, 값 수신
+			TraceScope wait("future.get", "result");
 			const long long result = future.get();
-			std::cout << "[Main] result=" << result << "\n";
+			Log() << "[Main] result=" << result;
 		}
 		catch (const std::exception& e)
 		{
-			std::cout << "[Main] exception: " << e.what() << "\n";
+			Log() << "[Main] exception: " << e.what();
 		}
 
 		worker.join();
 	}
 
-	std::cout << "\n";
+	Log() << "";
 
 	{
 		// 실패 케이스
@@ -110,16 +126,17 @@ int SMain()
 
 		std::thread worker(&PromiseWorker, std::move(promise), n, true);
 
-		std::cout << "[Main] waiting for result (failure case)...\n";
+		Log() << "[Main] waiting for result (failure case)...";
 		try
 		{
 			// 워커가 set_exception()하면 여기서 예외가 발생
+			TraceScope wait("future.get", "result");
 			const long long result = future.get();
-			std::cout << "[Main] result=" << result << "\n";
+			Log() << "[Main] result=" << result;
 		}
 		catch (const std::exception& e)
 		{
-			std::cout << "[Main] exception: " << e.what() << "\n";
+			Log() << "[Main] exception: " << e.what();
 		}
 
 		worker.join();
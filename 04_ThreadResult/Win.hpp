@@ -3,6 +3,8 @@
 #include <Windows.h>
 #include <process.h> // _beginthreadex
 
+#include "../Common/Trace.hpp"
+
 #include <cerrno>
 #include <iostream>
 
@@ -27,11 +29,21 @@
 // - 이 규칙을 어기면(예: Wait 전에 value/error를 읽기) 데이터 레이스/미완성 상태 노출로 이어질 수 있습니다.
 //   즉, WinAPI는 '통로가 강제'되지 않기 때문에 오히려 실수에 더 취약해질 수 있습니다.
 // - 예외 전파는 자동으로 되지 않으므로, error code/HRESULT/예외 포인터 등으로 직접 설계해야 합니다.
+//
+// 취소 (mode=cancel 의 WinAPI 대응)
+// - 메인은 doneEvent 를 INFINITE 가 아니라 kWinResultTimeoutMs 만큼만 기다립니다.
+// - 시간이 지나면 cancelEvent 를 신호 상태로 만들고, 워커는 지연(Sleep) 대신 cancelEvent 를 기다리다가
+//   바로 ERROR_CANCELLED 로 결과를 채우고 끝납니다. (워커가 포기된 작업을 계속 붙잡지 않음)
+// - timeout=ms 로 바꿀 수 있습니다. 기본값은 지연(250ms)보다 길어서 정상 결과가 나옵니다.
 
 
+constexpr DWORD kWinWorkerDelayMs = 250;
+constexpr DWORD kWinResultTimeoutMs = 1000;
+
 struct WinResultState
 {
 	HANDLE doneEvent = nullptr; // signaled when result is ready
+	HANDLE cancelEvent = nullptr; // 메인이 결과를 포기하면 signaled
 	// 주의: 아래 value/error는 doneEvent가 signaled 된 뒤에만 읽어야 합니다.
 	// (그 전에 읽는 것은 논리적으로도 틀리고, 동기화 관점에서도 위험합니다.)
 	long long value = 0;
@@ -50,15 +62,22 @@ long long SumUpTo(int n)
 
 unsigned __stdcall WinWorkerProc(void* param)
 {
+	TraceThreadName("WinWorkerProc");
+	TraceScope scope("WinWorkerProc", "lifecycle");
 	auto* state = static_cast<WinResultState*>(param);
 	state->error = 0;
 	state->value = 0;
 
 	// (데모) 메인 스레드가 기다리는 상황을 보여주기 위해 잠깐 지연
-	::Sleep(250);
+	// Sleep 대신 cancelEvent 를 기다리므로, 그 사이에 취소되면 바로 깨어납니다.
+	const bool cancelled = ::WaitForSingleObject(state->cancelEvent, kWinWorkerDelayMs) == WAIT_OBJECT_0;
 
 	// 실패/성공 결과를 shared state에 기록
-	if (state->shouldFail)
+	if (cancelled)
+	{
+		state->error = ERROR_CANCELLED;
+	}
+	else if (state->shouldFail)
 	{
 		state->error = ERROR_GEN_FAILURE;
 	}
@@ -74,12 +93,13 @@ unsigned __stdcall WinWorkerProc(void* param)
 	// 완료 신호 publish
 	// 중요: 완료 신호는 반드시 "결과 기록이 끝난 뒤" 마지막에 보내야 합니다.
 	// (만약 SetEvent를 먼저 호출해버리면, 메인 스레드는 깨어나서 미완성 value/error를 읽을 수 있습니다.)
+	TraceInstant("SetEvent(doneEvent)", "result", state->error);
 	::SetEvent(state->doneEvent);
 	return 0;
 }
 
 
-int WMain()
+int WMain(DWORD timeoutMs = kWinResultTimeoutMs)
 {
 	std::cout << "04_ThreadResult (WinAPI: Event + shared state)\n";
 	std::cout << "main tid=" << ::GetCurrentThreadId() << "\n\n";
@@ -89,9 +109,14 @@ int WMain()
 	state.shouldFail = false;
 
 	state.doneEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
-	if (state.doneEvent == nullptr)
+	state.cancelEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
+	if (state.doneEvent == nullptr || state.cancelEvent == nullptr)
 	{
 		std::cout << "CreateEvent failed. GetLastError=" << ::GetLastError() << "\n";
+		if (state.doneEvent != nullptr)
+			::CloseHandle(state.doneEvent);
+		if (state.cancelEvent != nullptr)
+			::CloseHandle(state.cancelEvent);
 		return 1;
 	}
 
@@ -108,6 +133,7 @@ int WMain()
 	{
 		std::cout << "_beginthreadex failed. errno=" << errno << "\n";
 		::CloseHandle(state.doneEvent);
+		::CloseHandle(state.cancelEvent);
 		return 1;
 	}
 
@@ -120,7 +146,18 @@ int WMain()
 
 	std::cout << "[Main] waiting for doneEvent...\n";
 	// 완료 신호를 기다린 뒤에만 value/error를 읽습니다.
-	::WaitForSingleObject(state.doneEvent, INFINITE);
+	TraceBegin("WaitForSingleObject(doneEvent)", "result");
+	const DWORD waited = ::WaitForSingleObject(state.doneEvent, timeoutMs);
+	TraceEnd("WaitForSingleObject(doneEvent)", "result");
+	if (waited == WAIT_TIMEOUT)
+	{
+		// 시간 초과: 워커에 취소를 알리고, 워커가 결과(ERROR_CANCELLED)를 채울 때까지만 다시 기다립니다.
+		std::cout << "[Main] timed out after " << timeoutMs << " ms -> SetEvent(cancelEvent)\n";
+		TraceInstant("SetEvent(cancelEvent)", "result");
+		::SetEvent(state.cancelEvent);
+		TraceScope wait("WaitForSingleObject(doneEvent)", "result");
+		::WaitForSingleObject(state.doneEvent, INFINITE);
+	}
 
 	if (state.error == 0)
 		std::cout << "[Main] result=" << state.value << "\n";
@@ -130,5 +167,6 @@ int WMain()
 	::WaitForSingleObject(workerHandle, INFINITE);
 	::CloseHandle(workerHandle);
 	::CloseHandle(state.doneEvent);
+	::CloseHandle(state.cancelEvent);
 	return 0;
 }
@@ -0,0 +1,20 @@
+#include "Std.hpp"
+#ifdef _WIN32
+#include "Win.hpp"
+#endif
+#include "LogBench.hpp"
+
+// 예) 05_MessageQueue pc=1:1,4:4 batch=1,64 msgs=1000000
+//     05_MessageQueue api=win          (Windows: SRWLOCK + CONDITION_VARIABLE 큐)
+//     05_MessageQueue mode=log-bench threads=1,4,8 lines=100000   (std::cout vs 비동기 로그 싱크)
+int main(int argc, char** argv)
+{
+	const LabArgs cli(argc, argv);
+	if (cli.Get("mode", "") == "log-bench")
+		return LogBenchMain(cli);
+#ifdef _WIN32
+	if (cli.Get("api", "") == "win")
+		return WMain(cli);
+#endif
+	return SMain(cli); // Win 버전은 Windows 전용
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+// 05_MessageQueue - 로그 싱크 비교 (mode=log-bench, Common/AsyncLog.hpp)
+//
+// 워커 T 개가 각자 lines 줄을 씁니다. 한 줄을 쓰는 호출 하나가 걸린 시간을 모두 기록합니다.
+// - cout        : std::cout << ... << "\n" (01 / 03 / 04 워커가 하던 방식, << 마다 stdout 락)
+// - sync        : Log() 로 자기 버퍼에 포맷한 뒤 fwrite 한 번 (싱크 없이, 락은 줄마다 한 번)
+// - async-block : Log() → MPSC 큐 → flusher 스레드. 큐가 가득 차면 호출자가 기다림
+// - async-drop  : 위와 같지만 큐가 가득 차면 줄을 버림
+//
+// 측정하는 동안 fd 1(stdout)을 out= 파일로 돌려 놓으므로, 모든 싱크가 같은 대상에 씁니다. 표는 되돌린 뒤 출력합니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/AsyncLog.hpp"
+#include "../Common/Platform.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+enum class LogSinkKind
+{
+	Cout,
+	Sync,
+	AsyncBlock,
+	AsyncDrop,
+};
+
+inline const char* LogSinkName(LogSinkKind kind)
+{
+	switch (kind)
+	{
+	case LogSinkKind::Cout:       return "cout";
+	case LogSinkKind::Sync:       return "sync";
+	case LogSinkKind::AsyncBlock: return "async-block";
+	case LogSinkKind::AsyncDrop:  return "async-drop";
+	}
+	return "?";
+}
+
+constexpr LogSinkKind kLogSinkKinds[] = { LogSinkKind::Cout, LogSinkKind::Sync, LogSinkKind::AsyncBlock, LogSinkKind::AsyncDrop };
+
+// 측정 구간 동안 fd 1 을 파일로 돌립니다. std::cout 과 stdout 을 비운 뒤 바꾸고, 소멸자에서 되돌립니다.
+class StdoutRedirect
+{
+public:
+	explicit StdoutRedirect(const std::string& path)
+	{
+		std::cout.flush();
+		std::fflush(stdout);
+		target_ = std::fopen(path.c_str(), "w");
+		if (target_ == nullptr)
+			return;
+#if defined(_WIN32)
+		saved_ = _dup(_fileno(stdout));
+		ok_ = saved_ >= 0 && _dup2(_fileno(target_), _fileno(stdout)) == 0;
+#else
+		saved_ = dup(fileno(stdout));
+		ok_ = saved_ >= 0 && dup2(fileno(target_), fileno(stdout)) >= 0;
+#endif
+	}
+
+	~StdoutRedirect()
+	{
+		std::cout.flush();
+		std::fflush(stdout);
+		if (saved_ >= 0)
+		{
+#if defined(_WIN32)
+			_dup2(saved_, _fileno(stdout));
+			_close(saved_);
+#else
+			dup2(saved_, fileno(stdout));
+			close(saved_);
+#endif
+		}
+		if (target_ != nullptr)
+			std::fclose(target_);
+	}
+
+	StdoutRedirect(const StdoutRedirect&) = delete;
+	StdoutRedirect& operator=(const StdoutRedirect&) = delete;
+
+	bool Ok() const { return ok_; }
+
+private:
+	std::FILE* target_ = nullptr;
+	int saved_ = -1;
+	bool ok_ = false;
+};
+
+struct LogBenchResult
+{
+	double callerSec = 0.0; // 시작 → 모든 워커가 마지막 줄을 넘김
+	double drainSec = 0.0;  // 시작 → 마지막 줄이 출력 대상에 쓰임 (async 는 Stop 까지)
+	long long lines = 0;
+	std::uint64_t dropped = 0;
+	LatencySummary latency; // 호출 하나(한 줄)의 시간
+};
+
+// 워커 하나: 01 / 03 워커가 쓰는 것과 비슷한 한 줄을 lines 번
+inline void LogBenchWorker(LogSinkKind kind, int index, long long lines, const std::atomic<bool>* go,
+	std::vector<std::int64_t>* samples)
+{
+	samples->reserve(static_cast<std::size_t>(lines));
+	const LabThreadId tid = CurrentThreadId();
+	while (!go->load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	for (long long n = 0; n < lines; ++n)
+	{
+		const std::int64_t t0 = NowNs();
+		if (kind == LogSinkKind::Cout)
+			std::cout << "[worker " << index << "] tick=" << n << " tid=" << tid << "\n";
+		else
+			Log() << "[worker " << index << "] tick=" << n << " tid=" << tid;
+		samples->push_back(NowNs() - t0);
+	}
+}
+
+inline LogBenchResult RunLogBench(LogSinkKind kind, int threads, long long lines, std::size_t queueCapacity)
+{
+	AsyncLogger& logger = AsyncLogger::Instance();
+	const bool async = (kind == LogSinkKind::AsyncBlock || kind == LogSinkKind::AsyncDrop);
+	if (async)
+		logger.Start(stdout, false, kind == LogSinkKind::AsyncDrop ? LogOverflow::Drop : LogOverflow::Block, queueCapacity);
+
+	std::atomic<bool> go{ false };
+	std::vector<std::vector<std::int64_t>> samples(threads);
+	std::vector<std::thread> workers;
+	for (int i = 0; i < threads; ++i)
+		workers.emplace_back(&LogBenchWorker, kind, i, lines, &go, &samples[i]);
+
+	StopWatch watch;
+	go.store(true, std::memory_order_release);
+	for (auto& th : workers)
+		th.join();
+
+	LogBenchResult r;
+	r.callerSec = watch.ElapsedSec();
+	if (async)
+	{
+		r.dropped = logger.Dropped();
+		logger.Stop();
+	}
+	std::cout.flush();
+	std::fflush(stdout);
+	r.drainSec = watch.ElapsedSec();
+	r.lines = lines * threads;
+
+	std::vector<std::int64_t> all;
+	all.reserve(static_cast<std::size_t>(r.lines));
+	for (const auto& s : samples)
+		all.insert(all.end(), s.begin(), s.end());
+	r.latency = Summarize(all);
+	return r;
+}
+
+inline void PrintLogBenchRow(const char* sink, int threads, const LogBenchResult& r)
+{
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left
+		<< std::setw(13) << sink
+		<< std::setw(9) << threads
+		<< std::setw(13) << std::scientific << std::setprecision(3) << (r.callerSec > 0.0 ? r.lines / r.callerSec : 0.0)
+		<< std::setw(11) << std::fixed << std::setprecision(1) << r.callerSec * 1e3
+		<< std::setw(11) << r.drainSec * 1e3
+		<< std::setw(9) << r.latency.p50
+		<< std::setw(9) << r.latency.p99
+		<< std::setw(10) << r.latency.p999
+		<< std::setw(11) << r.latency.max
+		<< r.dropped << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - sink=all|cout|sync|async-block|async-drop (기본 all)
+// - threads=1,2,4 : 로그를 쓰는 워커 수 목록 (기본 1,2,4,8)
+// - lines=N       : 워커 하나가 쓰는 줄 수 (기본 100000, 최소 1)
+// - logqueue=N    : async 싱크의 큐 용량 (기본 kLogDefaultQueue, kLogMinQueue..kLogMaxQueue 로 제한)
+// - out=path      : 측정 중 stdout 을 돌릴 파일 (기본 /dev/null, Windows 는 NUL). 터미널이면 out=/dev/tty
+int LogBenchMain(const LabArgs& cli)
+{
+	const std::string sinkName = cli.Get("sink", "all");
+	const std::vector<int> threadList = ParseIntList(cli.Get("threads", "1,2,4,8"));
+	const long long lines = std::max(1LL, cli.GetInt("lines", 100000));
+	const std::size_t queueCapacity = LogQueueCapacity(cli);
+#if defined(_WIN32)
+	const std::string out = cli.Get("out", "NUL");
+#else
+	const std::string out = cli.Get("out", "/dev/null");
+#endif
+	if (sinkName != "all" && std::none_of(std::begin(kLogSinkKinds), std::end(kLogSinkKinds),
+		[&](LogSinkKind kind) { return sinkName == LogSinkName(kind); }))
+	{
+		std::cout << "unknown sink=" << sinkName << "\n";
+		return 1;
+	}
+	if (threadList.empty())
+	{
+		std::cout << "threads= needs a list like 1,2,4\n";
+		return 1;
+	}
+
+	std::cout << "05_MessageQueue (log sink: std::cout vs async MPSC sink, lines=" << lines
+		<< " per thread, logqueue=" << queueCapacity << ", out=" << out << ")\n\n";
+	std::cout << std::left
+		<< std::setw(13) << "sink"
+		<< std::setw(9) << "threads"
+		<< std::setw(13) << "lines/sec"
+		<< std::setw(11) << "caller(ms)"
+		<< std::setw(11) << "drain(ms)"
+		<< std::setw(9) << "p50(ns)"
+		<< std::setw(9) << "p99(ns)"
+		<< std::setw(10) << "p999(ns)"
+		<< std::setw(11) << "max(ns)"
+		<< "dropped\n";
+
+	for (int threads : threadList)
+	{
+		for (LogSinkKind kind : kLogSinkKinds)
+		{
+			if (sinkName != "all" && sinkName != LogSinkName(kind))
+				continue;
+			LogBenchResult r;
+			{
+				StdoutRedirect redirect(out);
+				if (!redirect.Ok())
+				{
+					std::cout << "cannot redirect stdout to " << out << "\n";
+					return 1;
+				}
+				r = RunLogBench(kind, threads, lines, queueCapacity);
+			}
+			PrintLogBenchRow(LogSinkName(kind), threads, r);
+		}
+	}
+	std::cout << "\nlines/sec = lines / caller time, caller = until every worker returned from its last log call\n";
+	std::cout << "drain = until the last line reached out (async: flusher stopped), p50..max = one log call on the worker\n";
+	return 0;
+}
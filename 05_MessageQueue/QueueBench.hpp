@@ -0,0 +1,242 @@
+#pragma once
+
+// 05_MessageQueue - 생산자 / 소비자 측정 틀
+//
+// 큐 타입(Queue)만 바꿔 끼워 같은 조건으로 측정합니다. Queue 는 아래 두 함수를 가져야 합니다.
+// - void        PushBatch(const QueueMessage* items, std::size_t count) : count 개를 모두 넣을 때까지 대기
+// - std::size_t PopBatch(QueueMessage* out, std::size_t max)           : 1개 이상 꺼낼 때까지 대기
+//
+// 흐름
+// 1) 생산자 P 개가 각각 batch 개씩 메시지를 만들어 넣습니다. (배치마다 보낸 시각 기록)
+// 2) 소비자 C 개가 batch 개까지 한 번에 꺼내 받은 시각 - 보낸 시각(end-to-end 지연)을 샘플링합니다.
+// 3) 생산자가 모두 끝나면 메인 스레드가 종료 메시지(poison)를 소비자 수만큼 넣습니다.
+// 4) 받은 메시지 수와 seq 합계로 잃어버리거나 중복된 메시지가 없는지 확인합니다.
+// 5) 스레드 생성부터 join 까지 프로세스 전체의 문맥 교환 횟수와 CPU 시간을 함께 기록합니다.
+
+#include "../Common/ProcessStats.hpp"
+#include "../Common/Stats.hpp"
+#include "../Common/Timing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct QueueMessage
+{
+	std::uint64_t seq = 0;		 // 생산자별 1, 2, 3, ...
+	std::int64_t sentNs = 0;	 // 넣기 직전 시각 (배치 단위)
+	std::uint32_t producer = 0;
+};
+
+constexpr std::uint64_t kPoisonSeq = std::numeric_limits<std::uint64_t>::max();
+
+// seq 가 이 값의 배수인 메시지만 지연 시간을 기록합니다.
+constexpr std::uint64_t kQueueSampleEvery = 16;
+constexpr std::size_t kQueueMaxSamplesPerConsumer = 1 << 16;
+
+struct QueueBenchConfig
+{
+	int producers = 1;
+	int consumers = 1;
+	int batch = 1;
+	long long messages = 1000000; // 전체 메시지 수 (생산자들이 나눠 보냄)
+	std::size_t capacity = 1024;
+};
+
+struct QueueBenchResult
+{
+	double sec = 0.0;
+	long long received = 0;
+	bool ok = false;
+	LatencySummary latency;
+	ProcessUsage usage; // 측정 구간의 증가분
+};
+
+struct QueueConsumerResult
+{
+	long long received = 0;
+	std::uint64_t seqSum = 0;
+	std::vector<std::int64_t> latencyNs;
+};
+
+inline long long ProducerMessageCount(const QueueBenchConfig& cfg, int producer)
+{
+	const long long base = cfg.messages / cfg.producers;
+	return producer == 0 ? base + cfg.messages % cfg.producers : base;
+}
+
+template <typename Queue>
+void QueueProducerProc(Queue* queue, const QueueBenchConfig* cfg, int producer, const std::atomic<bool>* go)
+{
+	while (!go->load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	std::vector<QueueMessage> batch(cfg->batch);
+	const long long count = ProducerMessageCount(*cfg, producer);
+	long long sent = 0;
+	while (sent < count)
+	{
+		const std::size_t n = static_cast<std::size_t>(std::min<long long>(cfg->batch, count - sent));
+		const std::int64_t now = NowNs();
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			batch[i].seq = static_cast<std::uint64_t>(sent + i + 1);
+			batch[i].sentNs = now;
+			batch[i].producer = static_cast<std::uint32_t>(producer);
+		}
+		queue->PushBatch(batch.data(), n);
+		sent += static_cast<long long>(n);
+	}
+}
+
+template <typename Queue>
+void QueueConsumerProc(Queue* queue, const QueueBenchConfig* cfg, QueueConsumerResult* result)
+{
+	result->latencyNs.reserve(kQueueMaxSamplesPerConsumer);
+	std::vector<QueueMessage> batch(cfg->batch);
+	long long received = 0;
+	std::uint64_t seqSum = 0;
+	bool done = false;
+	while (!done)
+	{
+		const std::size_t n = queue->PopBatch(batch.data(), batch.size());
+		const std::int64_t now = NowNs();
+		int extraPoison = 0;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const QueueMessage& m = batch[i];
+			if (m.seq == kPoisonSeq)
+			{
+				// 한 번에 여러 개를 꺼냈다면 남는 종료 메시지는 다른 소비자 몫이므로 돌려놓습니다.
+				if (done)
+					++extraPoison;
+				done = true;
+				continue;
+			}
+			++received;
+			seqSum += m.seq;
+			if (m.seq % kQueueSampleEvery == 0 && result->latencyNs.size() < kQueueMaxSamplesPerConsumer)
+				result->latencyNs.push_back(now - m.sentNs);
+		}
+		for (int i = 0; i < extraPoison; ++i)
+		{
+			QueueMessage poison;
+			poison.seq = kPoisonSeq;
+			queue->PushBatch(&poison, 1);
+		}
+	}
+	result->received = received;
+	result->seqSum = seqSum;
+}
+
+template <typename Queue>
+QueueBenchResult RunQueueBench(Queue& queue, const QueueBenchConfig& cfg)
+{
+	const ProcessUsage usageBefore = ReadProcessUsage();
+	std::atomic<bool> go{ false };
+	std::vector<QueueConsumerResult> consumerResults(cfg.consumers);
+	std::vector<std::thread> producers;
+	std::vector<std::thread> consumers;
+	for (int c = 0; c < cfg.consumers; ++c)
+		consumers.emplace_back(&QueueConsumerProc<Queue>, &queue, &cfg, &consumerResults[c]);
+	for (int p = 0; p < cfg.producers; ++p)
+		producers.emplace_back(&QueueProducerProc<Queue>, &queue, &cfg, p, &go);
+
+	StopWatch watch;
+	go.store(true, std::memory_order_release);
+	for (auto& th : producers)
+		th.join();
+
+	QueueMessage poison;
+	poison.seq = kPoisonSeq;
+	for (int c = 0; c < cfg.consumers; ++c)
+		queue.PushBatch(&poison, 1);
+	for (auto& th : consumers)
+		th.join();
+
+	QueueBenchResult result;
+	result.sec = watch.ElapsedSec();
+	result.usage = UsageDelta(usageBefore, ReadProcessUsage());
+
+	std::uint64_t expectedSum = 0;
+	for (int p = 0; p < cfg.producers; ++p)
+	{
+		const std::uint64_t n = static_cast<std::uint64_t>(ProducerMessageCount(cfg, p));
+		expectedSum += n * (n + 1) / 2;
+	}
+
+	std::uint64_t seqSum = 0;
+	std::vector<std::int64_t> samples;
+	for (const auto& r : consumerResults)
+	{
+		result.received += r.received;
+		seqSum += r.seqSum;
+		samples.insert(samples.end(), r.latencyNs.begin(), r.latencyNs.end());
+	}
+	result.latency = Summarize(samples);
+	result.ok = (result.received == cfg.messages && seqSum == expectedSum);
+	return result;
+}
+
+inline void PrintQueueBenchHeader()
+{
+	std::cout << std::left
+		<< std::setw(14) << "queue"
+		<< std::setw(7) << "P:C"
+		<< std::setw(7) << "batch"
+		<< std::setw(13) << "msgs/sec"
+		<< std::setw(11) << "p50(ns)"
+		<< std::setw(11) << "p99(ns)"
+		<< std::setw(12) << "p999(ns)"
+		<< std::setw(10) << "ctxsw"
+		<< std::setw(9) << "cpu(ms)"
+		<< "check\n";
+}
+
+inline void PrintQueueBenchRow(const char* name, const QueueBenchConfig& cfg, const QueueBenchResult& r)
+{
+	const std::string pc = std::to_string(cfg.producers) + ":" + std::to_string(cfg.consumers);
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left
+		<< std::setw(14) << name
+		<< std::setw(7) << pc
+		<< std::setw(7) << cfg.batch
+		<< std::setw(13) << std::scientific << std::setprecision(3) << (r.sec > 0.0 ? r.received / r.sec : 0.0)
+		<< std::setw(11) << r.latency.p50
+		<< std::setw(11) << r.latency.p99
+		<< std::setw(12) << r.latency.p999
+		<< std::setw(10) << r.usage.ContextSwitches()
+		<< std::setw(9) << std::fixed << std::setprecision(1) << r.usage.CpuNs() / 1e6
+		<< (r.ok ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
+
+// "1:1,1:4,4:1" -> {(1,1), (1,4), (4,1)}. 잘못된 항목은 건너뜁니다.
+inline std::vector<std::pair<int, int>> ParseProducerConsumerList(const std::string& text)
+{
+	std::vector<std::pair<int, int>> out;
+	std::stringstream ss(text);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		const std::size_t colon = item.find(':');
+		if (colon == std::string::npos)
+			continue;
+		const int p = std::atoi(item.substr(0, colon).c_str());
+		const int c = std::atoi(item.substr(colon + 1).c_str());
+		if (p > 0 && c > 0)
+			out.emplace_back(p, c);
+	}
+	return out;
+}
+
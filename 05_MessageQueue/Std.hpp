@@ -0,0 +1,300 @@
+#pragma once
+
+#include "../Common/Args.hpp"
+#include "../Common/LockFreeQueue.hpp"
+#include "../Common/Locks.hpp" // SpinBackoff
+#include "../Common/Platform.hpp"
+#include "QueueBench.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 깨우기 정책
+// - PerItem   : 넣은 / 꺼낸 개수만큼 반대편에 notify_one (메시지마다 알리는 단순한 방식)
+// - Coalesced : 상태가 바뀌는 순간에만 한 명을 깨웁니다.
+//   - 비어 있던 큐에 넣었을 때(빈 → 비지 않음)만 소비자 하나, 가득 찼던 큐에서 꺼냈을 때만 생산자 하나
+//   - 깨어난 쪽이 일을 마친 뒤에도 남은 것(메시지 / 빈 칸)이 있고 기다리는 같은 편이 있으면 다음 한 명을 깨웁니다. (notify_one 사슬)
+//   - 기다리는 스레드가 없으면 notify 자체를 호출하지 않습니다.
+enum class QueueWakePolicy
+{
+	PerItem,
+	Coalesced,
+};
+
+// 03_SignalWaiting 의 StdThreadControl 과 같은 재료(std::mutex + std::condition_variable)로 만든 고정 크기 큐
+// - 가득 차면 생산자가 notFull 에서, 비어 있으면 소비자가 notEmpty 에서 잠듭니다.
+// - PushBatch / PopBatch 는 락 한 번에 여러 개를 넣고 꺼냅니다.
+template <typename T>
+class LockedQueue
+{
+public:
+	explicit LockedQueue(std::size_t capacity, QueueWakePolicy policy = QueueWakePolicy::PerItem)
+		: buffer_(capacity < 1 ? 1 : capacity), policy_(policy)
+	{
+	}
+
+	void Push(const T& value) { PushBatch(&value, 1); }
+
+	// count 개를 모두 넣을 때까지 대기 (빈 칸이 생기는 만큼 나눠서 넣음)
+	void PushBatch(const T* items, std::size_t count)
+	{
+		while (count > 0)
+		{
+			std::size_t pushed = 0;
+			bool wakeConsumer = false;
+			bool wakeProducer = false;
+			{
+				std::unique_lock<std::mutex> lock(m_);
+				if (size_ == buffer_.size())
+				{
+					++waitingProducers_;
+					notFull_.wait(lock, [&] { return size_ < buffer_.size(); });
+					--waitingProducers_;
+				}
+				const bool wasEmpty = (size_ == 0);
+				while (pushed < count && size_ < buffer_.size())
+				{
+					buffer_[(head_ + size_) % buffer_.size()] = items[pushed++];
+					++size_;
+				}
+				wakeConsumer = wasEmpty && waitingConsumers_ > 0;
+				wakeProducer = size_ < buffer_.size() && waitingProducers_ > 0;
+			}
+
+			if (policy_ == QueueWakePolicy::PerItem)
+			{
+				for (std::size_t i = 0; i < pushed; ++i)
+					notEmpty_.notify_one();
+			}
+			else
+			{
+				if (wakeConsumer)
+					notEmpty_.notify_one();
+				if (wakeProducer)
+					notFull_.notify_one(); // 사슬: 빈 칸이 남았으니 다음 생산자
+			}
+			items += pushed;
+			count -= pushed;
+		}
+	}
+
+	T Pop()
+	{
+		T value;
+		PopBatch(&value, 1);
+		return value;
+	}
+
+	// 1개 이상 꺼낼 때까지 대기. 최대 max 개를 꺼내고 개수를 돌려줍니다.
+	std::size_t PopBatch(T* out, std::size_t max)
+	{
+		std::size_t popped = 0;
+		bool wakeProducer = false;
+		bool wakeConsumer = false;
+		{
+			std::unique_lock<std::mutex> lock(m_);
+			if (size_ == 0)
+			{
+				++waitingConsumers_;
+				notEmpty_.wait(lock, [&] { return size_ > 0; });
+				--waitingConsumers_;
+			}
+			const bool wasFull = (size_ == buffer_.size());
+			while (popped < max && size_ > 0)
+			{
+				out[popped++] = std::move(buffer_[head_]);
+				head_ = (head_ + 1) % buffer_.size();
+				--size_;
+			}
+			wakeProducer = wasFull && waitingProducers_ > 0;
+			wakeConsumer = size_ > 0 && waitingConsumers_ > 0;
+		}
+
+		if (policy_ == QueueWakePolicy::PerItem)
+		{
+			for (std::size_t i = 0; i < popped; ++i)
+				notFull_.notify_one();
+		}
+		else
+		{
+			if (wakeProducer)
+				notFull_.notify_one();
+			if (wakeConsumer)
+				notEmpty_.notify_one(); // 사슬: 메시지가 남았으니 다음 소비자
+		}
+		return popped;
+	}
+
+private:
+	std::mutex m_;
+	std::condition_variable notEmpty_;
+	std::condition_variable notFull_;
+	std::vector<T> buffer_;
+	std::size_t head_ = 0;
+	std::size_t size_ = 0;
+	int waitingProducers_ = 0; // m_ 보호
+	int waitingConsumers_ = 0; // m_ 보호
+	const QueueWakePolicy policy_;
+};
+
+// lock-free 큐(TryPush / TryPop) 를 측정 틀의 대기형 인터페이스로 감쌉니다.
+// 가득 차거나 비어 있으면 백오프하며 다시 시도합니다. (코어가 하나면 바로 yield)
+// SpscQueue 처럼 배치 함수가 있으면 배치로 넣고 꺼냅니다.
+template <typename Q>
+class SpinningQueue
+{
+public:
+	explicit SpinningQueue(std::size_t capacity) : queue_(capacity) {}
+
+	void PushBatch(const QueueMessage* items, std::size_t count)
+	{
+		SpinBackoff backoff;
+		while (count > 0)
+		{
+			std::size_t pushed = 0;
+			if constexpr (requires(Q& q) { q.TryPushBatch(items, count); })
+				pushed = queue_.TryPushBatch(items, count);
+			else
+				pushed = queue_.TryPush(*items) ? 1 : 0;
+
+			if (pushed == 0)
+			{
+				backoff.Pause();
+				continue;
+			}
+			backoff.Reset();
+			items += pushed;
+			count -= pushed;
+		}
+	}
+
+	std::size_t PopBatch(QueueMessage* out, std::size_t max)
+	{
+		SpinBackoff backoff;
+		while (true)
+		{
+			std::size_t popped = 0;
+			if constexpr (requires(Q& q) { q.TryPopBatch(out, max); })
+			{
+				popped = queue_.TryPopBatch(out, max);
+			}
+			else
+			{
+				while (popped < max && queue_.TryPop(out[popped]))
+					++popped;
+			}
+			if (popped > 0)
+				return popped;
+			backoff.Pause();
+		}
+	}
+
+private:
+	Q queue_;
+};
+
+enum class QueueKind
+{
+	Locked,
+	LockedCoalesced,
+	Mpmc,
+	Spsc,
+};
+
+inline const char* QueueKindName(QueueKind kind)
+{
+	switch (kind)
+	{
+	case QueueKind::Locked:          return "mutex+cv";
+	case QueueKind::LockedCoalesced: return "cv-coalesced";
+	case QueueKind::Mpmc:            return "mpmc";
+	case QueueKind::Spsc:            return "spsc";
+	}
+	return "?";
+}
+
+constexpr QueueKind kQueueKinds[] = { QueueKind::Locked, QueueKind::LockedCoalesced, QueueKind::Mpmc, QueueKind::Spsc };
+
+inline QueueBenchResult RunQueueKindStd(QueueKind kind, const QueueBenchConfig& cfg)
+{
+	switch (kind)
+	{
+	case QueueKind::Mpmc:
+	{
+		auto queue = std::make_unique<SpinningQueue<MpmcQueue<QueueMessage>>>(cfg.capacity);
+		return RunQueueBench(*queue, cfg);
+	}
+	case QueueKind::Spsc:
+	{
+		auto queue = std::make_unique<SpinningQueue<SpscQueue<QueueMessage>>>(cfg.capacity);
+		return RunQueueBench(*queue, cfg);
+	}
+	case QueueKind::LockedCoalesced:
+	{
+		auto queue = std::make_unique<LockedQueue<QueueMessage>>(cfg.capacity, QueueWakePolicy::Coalesced);
+		return RunQueueBench(*queue, cfg);
+	}
+	case QueueKind::Locked:
+		break;
+	}
+	auto queue = std::make_unique<LockedQueue<QueueMessage>>(cfg.capacity);
+	return RunQueueBench(*queue, cfg);
+}
+
+// 인자
+// - queue=all|mutex+cv|cv-coalesced|mpmc|spsc (기본 all, spsc 는 1:1 에서만)
+// - pc=P:C,...   : 생산자:소비자 조합 (기본 1:1,1:4,4:1,4:4)
+// - batch=N,...  : 한 번에 넣고 꺼내는 개수 (기본 1,16,64)
+// - msgs=N       : 조합 하나당 전체 메시지 수 (기본 1000000)
+// - capacity=N   : 큐 용량 (기본 1024)
+int SMain(const LabArgs& cli)
+{
+	const std::string queueName = cli.Get("queue", "all");
+	if (queueName != "all" && std::none_of(std::begin(kQueueKinds), std::end(kQueueKinds),
+		[&](QueueKind kind) { return queueName == QueueKindName(kind); }))
+	{
+		std::cout << "unknown queue=" << queueName << "\n";
+		return 1;
+	}
+	const std::vector<std::pair<int, int>> pcList = ParseProducerConsumerList(cli.Get("pc", "1:1,1:4,4:1,4:4"));
+	const std::vector<int> batches = ParseIntList(cli.Get("batch", "1,16,64"));
+
+	QueueBenchConfig cfg;
+	cfg.messages = cli.GetInt("msgs", 1000000);
+	cfg.capacity = static_cast<std::size_t>(cli.GetInt("capacity", 1024));
+
+	std::cout << "05_MessageQueue (std::thread producer/consumer)\n";
+	std::cout << "main tid=" << CurrentThreadId() << "\n";
+	std::cout << "hardware_concurrency=" << std::thread::hardware_concurrency()
+		<< " msgs=" << cfg.messages << " capacity=" << cfg.capacity << "\n\n";
+
+	PrintQueueBenchHeader();
+	for (const auto& [producers, consumers] : pcList)
+	{
+		for (int batch : batches)
+		{
+			cfg.producers = producers;
+			cfg.consumers = consumers;
+			cfg.batch = batch;
+			for (QueueKind kind : kQueueKinds)
+			{
+				if (queueName != "all" && queueName != QueueKindName(kind))
+					continue;
+				if (kind == QueueKind::Spsc && (producers != 1 || consumers != 1))
+					continue;
+				PrintQueueBenchRow(QueueKindName(kind), cfg, RunQueueKindStd(kind, cfg));
+			}
+		}
+	}
+	std::cout << "\nlatency = pop time - push time (1 in " << kQueueSampleEvery << " messages sampled)\n";
+	std::cout << "ctxsw = voluntary + involuntary context switches of the whole process during the run (getrusage)\n";
+	return 0;
+}
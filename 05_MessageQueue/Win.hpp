@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Windows.h>
+
+#include "../Common/Args.hpp"
+#include "QueueBench.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// LockedQueue 의 WinAPI 판: SRWLOCK + CONDITION_VARIABLE (Vista+)
+// - SleepConditionVariableSRW 는 spurious wakeup 이 있을 수 있으므로 조건을 루프에서 다시 검사합니다.
+template <typename T>
+class WinLockedQueue
+{
+public:
+	explicit WinLockedQueue(std::size_t capacity) : buffer_(capacity < 1 ? 1 : capacity)
+	{
+		::InitializeSRWLock(&lock_);
+		::InitializeConditionVariable(&notEmpty_);
+		::InitializeConditionVariable(&notFull_);
+	}
+
+	WinLockedQueue(const WinLockedQueue&) = delete;
+	WinLockedQueue& operator=(const WinLockedQueue&) = delete;
+
+	void PushBatch(const T* items, std::size_t count)
+	{
+		while (count > 0)
+		{
+			std::size_t pushed = 0;
+			::AcquireSRWLockExclusive(&lock_);
+			while (size_ == buffer_.size())
+				::SleepConditionVariableSRW(&notFull_, &lock_, INFINITE, 0);
+			while (pushed < count && size_ < buffer_.size())
+			{
+				buffer_[(head_ + size_) % buffer_.size()] = items[pushed++];
+				++size_;
+			}
+			::ReleaseSRWLockExclusive(&lock_);
+
+			if (pushed == 1)
+				::WakeConditionVariable(&notEmpty_);
+			else
+				::WakeAllConditionVariable(&notEmpty_);
+			items += pushed;
+			count -= pushed;
+		}
+	}
+
+	std::size_t PopBatch(T* out, std::size_t max)
+	{
+		std::size_t popped = 0;
+		::AcquireSRWLockExclusive(&lock_);
+		while (size_ == 0)
+			::SleepConditionVariableSRW(&notEmpty_, &lock_, INFINITE, 0);
+		while (popped < max && size_ > 0)
+		{
+			out[popped++] = buffer_[head_];
+			head_ = (head_ + 1) % buffer_.size();
+			--size_;
+		}
+		::ReleaseSRWLockExclusive(&lock_);
+
+		if (popped == 1)
+			::WakeConditionVariable(&notFull_);
+		else
+			::WakeAllConditionVariable(&notFull_);
+		return popped;
+	}
+
+private:
+	SRWLOCK lock_;
+	CONDITION_VARIABLE notEmpty_;
+	CONDITION_VARIABLE notFull_;
+	std::vector<T> buffer_;
+	std::size_t head_ = 0;
+	std::size_t size_ = 0;
+};
+
+
+// 인자는 SMain과 같습니다. (pc=P:C,..., batch=N,..., msgs=N, capacity=N)
+// WinAPI 큐(SRWLOCK + CONDITION_VARIABLE)와 lock-free MPMC 큐를 비교합니다.
+int WMain(const LabArgs& cli)
+{
+	const std::vector<std::pair<int, int>> pcList = ParseProducerConsumerList(cli.Get("pc", "1:1,1:4,4:1,4:4"));
+	const std::vector<int> batches = ParseIntList(cli.Get("batch", "1,16,64"));
+
+	QueueBenchConfig cfg;
+	cfg.messages = cli.GetInt("msgs", 1000000);
+	cfg.capacity = static_cast<std::size_t>(cli.GetInt("capacity", 1024));
+
+	std::cout << "05_MessageQueue (WinAPI SRWLOCK + CONDITION_VARIABLE)\n";
+	std::cout << "main tid=" << ::GetCurrentThreadId() << "\n\n";
+
+	PrintQueueBenchHeader();
+	for (const auto& [producers, consumers] : pcList)
+	{
+		for (int batch : batches)
+		{
+			cfg.producers = producers;
+			cfg.consumers = consumers;
+			cfg.batch = batch;
+			{
+				auto queue = std::make_unique<WinLockedQueue<QueueMessage>>(cfg.capacity);
+				PrintQueueBenchRow("srw+cv", cfg, RunQueueBench(*queue, cfg));
+			}
+			PrintQueueBenchRow(QueueKindName(QueueKind::Mpmc), cfg, RunQueueKindStd(QueueKind::Mpmc, cfg));
+		}
+	}
+	return 0;
+}
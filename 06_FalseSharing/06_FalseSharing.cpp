@@ -0,0 +1,11 @@
+#include "Std.hpp"
+
+// 예) 06_FalseSharing threads=8 ms=200
+//     06_FalseSharing layout=packed threads=1,2,4,8 cpus=0-7 spread=1
+//     06_FalseSharing perf=0                 (성능 카운터 끔)
+//     06_FalseSharing hitm=0x04d2            (HITM raw 이벤트 직접 지정)
+int main(int argc, char** argv)
+{
+	const LabArgs cli(argc, argv);
+	return SMain(cli); // 배치 비교가 목적이므로 Std 버전만 (스레드 속성은 Windows 에서도 동작)
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+// 06_FalseSharing - 스레드별 카운터의 메모리 배치
+//
+// 모든 배치에서 스레드는 "자기 카운터"만 올립니다. (shared 만 예외)
+// 논리적으로는 공유가 없는데도, 카운터들이 같은 캐시 라인에 있으면 한 스레드의 쓰기가
+// 다른 코어의 라인 사본을 무효화하므로 라인이 코어 사이를 계속 오갑니다. (false sharing)
+//
+// | 배치       | 스레드 t 의 카운터                         | 한 캐시 라인(64B)에 |
+// |------------|--------------------------------------------|---------------------|
+// | shared     | 모두 같은 atomic 하나 (fetch_add)          | 모든 스레드 (진짜 공유, 기준) |
+// | packed     | long long 배열의 t 번째 칸                 | 스레드 8개          |
+// | padded     | CacheLinePadded (alignas 64) 의 t 번째 칸  | 스레드 1개          |
+// | padded-128 | 128B 간격 (인접 라인 프리페처까지 피함)    | 스레드 1개, 옆 라인도 비움 |
+// | tls        | thread_local 변수                          | 스레드 1개 (TLS 블록은 스레드마다 따로 할당) |
+//
+// 패딩 크기는 std::hardware_destructive_interference_size 대신 Common/CacheLine.hpp 의 kCacheLineSize 를 씁니다.
+// (컴파일러마다 값이 다르고 GCC 는 헤더에서 쓰면 -Winterference-size 경고를 냅니다)
+
+#include "../Common/CacheLine.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+enum class CounterLayout
+{
+	Shared,
+	Packed,
+	Padded,
+	Padded128,
+	Tls,
+};
+
+constexpr CounterLayout kAllCounterLayouts[] = {
+	CounterLayout::Shared,
+	CounterLayout::Packed,
+	CounterLayout::Padded,
+	CounterLayout::Padded128,
+	CounterLayout::Tls,
+};
+
+inline const char* CounterLayoutName(CounterLayout layout)
+{
+	switch (layout)
+	{
+	case CounterLayout::Shared:    return "shared";
+	case CounterLayout::Packed:    return "packed";
+	case CounterLayout::Padded:    return "padded";
+	case CounterLayout::Padded128: return "padded-128";
+	case CounterLayout::Tls:       return "tls";
+	}
+	return "?";
+}
+
+inline bool ParseCounterLayout(const char* name, CounterLayout* out)
+{
+	for (CounterLayout layout : kAllCounterLayouts)
+	{
+		if (std::strcmp(name, CounterLayoutName(layout)) == 0)
+		{
+			*out = layout;
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename T>
+struct alignas(2 * kCacheLineSize) CacheLinePairPadded
+{
+	T value{};
+};
+
+// 배치마다 필요한 저장소만 할당합니다. (threadCount 칸)
+struct CounterStorage
+{
+	std::atomic<long long> shared{ 0 };
+	std::vector<std::atomic<long long>> packed;
+	std::vector<CacheLinePadded<std::atomic<long long>>> padded;
+	std::vector<CacheLinePairPadded<std::atomic<long long>>> padded128;
+	std::vector<long long> tlsResults; // tls 는 스레드가 끝날 때 자기 값을 여기에 옮겨 둠
+
+	CounterStorage(CounterLayout layout, int threadCount)
+		: packed(layout == CounterLayout::Packed ? threadCount : 0),
+		  padded(layout == CounterLayout::Padded ? threadCount : 0),
+		  padded128(layout == CounterLayout::Padded128 ? threadCount : 0),
+		  tlsResults(layout == CounterLayout::Tls ? threadCount : 0)
+	{
+	}
+
+	long long Sum() const
+	{
+		long long sum = shared.load();
+		for (const auto& c : packed)
+			sum += c.load();
+		for (const auto& c : padded)
+			sum += c.value.load();
+		for (const auto& c : padded128)
+			sum += c.value.load();
+		for (long long v : tlsResults)
+			sum += v;
+		return sum;
+	}
+};
+
+// 자기 카운터는 자기만 쓰므로 load + store 로 충분합니다. (lock 접두사 없음, 02 의 PaddedShards 와 같은 방식)
+// atomic 이라 매번 메모리에 쓰이고, 컴파일러가 레지스터에 모아 두지 못합니다.
+inline void BumpOwned(std::atomic<long long>& counter)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+inline std::atomic<long long>& TlsCounter()
+{
+	static thread_local std::atomic<long long> counter{ 0 };
+	return counter;
+}
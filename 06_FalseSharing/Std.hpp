@@ -0,0 +1,241 @@
+#pragma once
+
+#include "../Common/Args.hpp"
+#include "../Common/CacheLine.hpp"
+#include "../Common/PerfCounters.hpp"
+#include "../Common/ThreadAttributes.hpp"
+#include "../Common/Timing.hpp"
+#include "CounterLayout.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// stop 확인 사이의 증가 횟수 (stop 을 읽는 비용이 측정에 섞이지 않도록)
+constexpr int kIncrementBatch = 1024;
+
+struct FalseSharingControl
+{
+	alignas(kCacheLineSize) std::atomic<int> ready{ 0 };
+	alignas(kCacheLineSize) std::atomic<bool> go{ false };
+	std::atomic<bool> stop{ false };
+};
+
+struct FalseSharingThreadArgs
+{
+	CounterLayout layout = CounterLayout::Padded;
+	CounterStorage* storage = nullptr;
+	FalseSharingControl* control = nullptr;
+	const ThreadAttributes* attrs = nullptr;
+};
+
+template <typename Bump>
+long long IncrementUntilStop(const std::atomic<bool>& stop, Bump bump)
+{
+	long long ops = 0;
+	while (!stop.load(std::memory_order_relaxed))
+	{
+		for (int k = 0; k < kIncrementBatch; ++k)
+			bump();
+		ops += kIncrementBatch;
+	}
+	return ops;
+}
+
+// 반환값: 이 스레드가 올린 횟수
+inline long long FalseSharingThreadProc(const FalseSharingThreadArgs* args, int index)
+{
+	ApplyThreadAttributes(*args->attrs, static_cast<unsigned>(index));
+	FalseSharingControl& control = *args->control;
+	CounterStorage& storage = *args->storage;
+	control.ready.fetch_add(1);
+	while (!control.go.load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	switch (args->layout)
+	{
+	case CounterLayout::Shared:
+		return IncrementUntilStop(control.stop, [&] { storage.shared.fetch_add(1, std::memory_order_relaxed); });
+	case CounterLayout::Packed:
+		return IncrementUntilStop(control.stop, [&] { BumpOwned(storage.packed[index]); });
+	case CounterLayout::Padded:
+		return IncrementUntilStop(control.stop, [&] { BumpOwned(storage.padded[index].value); });
+	case CounterLayout::Padded128:
+		return IncrementUntilStop(control.stop, [&] { BumpOwned(storage.padded128[index].value); });
+	case CounterLayout::Tls:
+	{
+		std::atomic<long long>& counter = TlsCounter();
+		const long long ops = IncrementUntilStop(control.stop, [&] { BumpOwned(counter); });
+		storage.tlsResults[index] = counter.load(std::memory_order_relaxed); // join 으로 메인에 전달
+		return ops;
+	}
+	}
+	return 0;
+}
+
+struct FalseSharingResult
+{
+	CounterLayout layout = CounterLayout::Padded;
+	int threadCount = 0;
+	double sec = 0.0;
+	long long ops = 0;
+	std::vector<long long> counters; // PerfCounters 순서, 측정 불가면 -1
+	bool ok = false;
+};
+
+inline FalseSharingResult RunFalseSharing(CounterLayout layout, int threadCount, unsigned durationMs,
+	const ThreadAttributes& attrs, const std::vector<PerfCounterSpec>& perfSpecs)
+{
+	CounterStorage storage(layout, threadCount);
+	FalseSharingControl control;
+	FalseSharingThreadArgs args;
+	args.layout = layout;
+	args.storage = &storage;
+	args.control = &control;
+	args.attrs = &attrs;
+
+	// 카운터는 스레드를 만들기 전에 켜야 inherit 으로 워커까지 셉니다. (생성 / 대기 구간도 조금 섞임)
+	PerfCounters perf(perfSpecs);
+	perf.Start();
+
+	std::vector<long long> ops(threadCount, 0);
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (int t = 0; t < threadCount; ++t)
+		threads.emplace_back([&args, &ops, t] { ops[t] = FalseSharingThreadProc(&args, t); });
+
+	while (control.ready.load() != threadCount)
+		std::this_thread::yield();
+	StopWatch watch;
+	control.go.store(true, std::memory_order_release);
+	std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+	control.stop.store(true, std::memory_order_relaxed);
+	for (auto& th : threads)
+		th.join();
+
+	FalseSharingResult result;
+	result.sec = watch.ElapsedSec();
+	perf.Stop();
+
+	result.layout = layout;
+	result.threadCount = threadCount;
+	for (long long n : ops)
+		result.ops += n;
+	for (std::size_t i = 0; i < perf.Size(); ++i)
+		result.counters.push_back(perf.Value(i));
+	result.ok = storage.Sum() == result.ops;
+	return result;
+}
+
+// 1000 증가당 이벤트 수 (측정 불가면 "-")
+inline std::string PerKiloOps(long long events, long long ops)
+{
+	if (events < 0 || ops <= 0)
+		return "-";
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(2) << events * 1000.0 / ops;
+	return ss.str();
+}
+
+inline void PrintFalseSharingHeader(const std::vector<PerfCounterSpec>& perfSpecs)
+{
+	std::cout << std::left
+		<< std::setw(12) << "layout"
+		<< std::setw(9) << "threads"
+		<< std::setw(13) << "incr/sec"
+		<< std::setw(12) << "ns/incr"
+		<< std::setw(10) << "vs-tls";
+	for (const PerfCounterSpec& spec : perfSpecs)
+		std::cout << std::setw(15) << (spec.name + "/k");
+	std::cout << "check\n";
+}
+
+// ns/incr : 한 스레드가 증가 한 번에 쓴 시간 (측정 시간 x 스레드 수 / 전체 증가 횟수)
+// vs-tls  : 같은 스레드 수의 tls 대비 ns/incr 배율 (false sharing 이 없는 기준)
+inline void PrintFalseSharingRow(const FalseSharingResult& r, double tlsNsPerIncr)
+{
+	const double nsPerIncr = r.ops > 0 ? r.sec * 1e9 * r.threadCount / r.ops : 0.0;
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left
+		<< std::setw(12) << CounterLayoutName(r.layout)
+		<< std::setw(9) << r.threadCount
+		<< std::setw(13) << std::scientific << std::setprecision(3) << r.ops / r.sec
+		<< std::setw(12) << std::fixed << std::setprecision(2) << nsPerIncr
+		<< std::setw(10) << (tlsNsPerIncr > 0.0 ? nsPerIncr / tlsNsPerIncr : 0.0);
+	for (long long events : r.counters)
+		std::cout << std::setw(15) << PerKiloOps(events, r.ops);
+	std::cout << (r.ok ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
+
+// 인자
+// - layout=all|shared|packed|padded|padded-128|tls (기본 all)
+// - threads=N 또는 threads=1,2,8 : 최대 스레드 수(1 부터 2배씩) 또는 목록 (기본 max(4, hardware_concurrency))
+// - ms=N : 칸 하나당 측정 시간 (기본 200)
+// - perf=0 : 성능 카운터를 끔 (기본 1, Linux 만)
+// - hitm=0xRAW : HITM raw 이벤트 (기본 Intel 이면 0x04d2, 0 이면 끔)
+// - cpus=, spread=1, node=, priority=, name= : 워커 스레드 속성 (Common/ThreadAttributes.hpp)
+int SMain(const LabArgs& cli)
+{
+	const std::string layoutName = cli.Get("layout", "all");
+	CounterLayout only = CounterLayout::Padded;
+	if (layoutName != "all" && !ParseCounterLayout(layoutName.c_str(), &only))
+	{
+		std::cout << "unknown layout=" << layoutName << "\n";
+		return 1;
+	}
+
+	const int hw = static_cast<int>(std::thread::hardware_concurrency());
+	const std::vector<int> threadCounts = cli.GetCountList("threads", std::max(4, hw));
+	const unsigned durationMs = static_cast<unsigned>(cli.GetInt("ms", 200));
+	const ThreadAttributes attrs = ParseThreadAttributes(cli);
+
+	std::vector<PerfCounterSpec> perfSpecs;
+	if (cli.GetInt("perf", 1) != 0)
+	{
+		const std::uint64_t hitm = cli.Has("hitm")
+			? std::strtoull(cli.Get("hitm", "0").c_str(), nullptr, 0)
+			: HitmRawEvent();
+		perfSpecs = CacheCounterSpecs(hitm);
+	}
+
+	std::cout << "06_FalseSharing (per-thread counters, ms=" << durationMs << ", hardware_concurrency=" << hw
+		<< ", cache line=" << kCacheLineSize << "B)\n";
+	std::cout << "thread attributes: " << DescribeThreadAttributes(attrs) << "\n";
+	if (!perfSpecs.empty())
+	{
+		PerfCounters probe(perfSpecs);
+		if (!probe.Error().empty())
+			std::cout << "perf counters: unavailable (" << probe.Error() << "), shown as -\n";
+	}
+	std::cout << "\n";
+	PrintFalseSharingHeader(perfSpecs);
+
+	for (int threads : threadCounts)
+	{
+		std::vector<FalseSharingResult> rows;
+		double tlsNsPerIncr = 0.0;
+		for (CounterLayout layout : kAllCounterLayouts)
+		{
+			// vs-tls 기준을 얻기 위해 tls 는 항상 실행합니다.
+			if (layoutName != "all" && layout != only && layout != CounterLayout::Tls)
+				continue;
+			rows.push_back(RunFalseSharing(layout, threads, durationMs, attrs, perfSpecs));
+			if (layout == CounterLayout::Tls && rows.back().ops > 0)
+				tlsNsPerIncr = rows.back().sec * 1e9 * threads / rows.back().ops;
+		}
+		for (const FalseSharingResult& r : rows)
+			PrintFalseSharingRow(r, tlsNsPerIncr);
+	}
+
+	std::cout << "\nns/incr = per-thread time per increment, vs-tls = ns/incr relative to tls (no sharing)\n";
+	std::cout << "<event>/k = hardware events per 1000 increments (all threads, user mode)\n";
+	return 0;
+}
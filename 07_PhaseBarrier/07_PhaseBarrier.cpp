@@ -0,0 +1,10 @@
+#include "Std.hpp"
+
+// 예) 07_PhaseBarrier threads=1,2,4,8 phases=1000 max=10000
+//     07_PhaseBarrier mode=crossing threads=16 crossings=100000
+//     07_PhaseBarrier barrier=dissemination
+int main(int argc, char** argv)
+{
+	const LabArgs cli(argc, argv);
+	return SMain(cli); // 장벽 비교가 목적이므로 Std 버전만 (Common/Barrier.hpp 는 Windows 에서도 동작)
+}
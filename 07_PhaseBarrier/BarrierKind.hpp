@@ -0,0 +1,98 @@
+#pragma once
+
+// 07_PhaseBarrier - 비교할 단계 동기화 방식
+//
+// - spawn         : 단계마다 스레드를 만들고 join (02_MutualExclusion 의 방식, 장벽 없음)
+// - sense         : Common/Barrier.hpp 의 SenseBarrier (중앙 카운터 + sense 반전)
+// - dissemination : Common/Barrier.hpp 의 DisseminationBarrier (log2 N 라운드, 공유 카운터 없음)
+// - std           : std::barrier<> (기준)
+//
+// 장벽 타입마다 모양이 다르므로 같은 모양의 어댑터로 감쌉니다.
+//   Adapter adapter(threads);
+//   Adapter::Local local;                 // 스레드마다
+//   adapter.ArriveAndWait(index, local);
+
+#include "../Common/Barrier.hpp"
+
+#include <barrier>
+#include <cstdint>
+#include <cstring>
+
+enum class BarrierKind
+{
+	Spawn,
+	Sense,
+	Dissemination,
+	Std,
+};
+
+constexpr BarrierKind kAllBarrierKinds[] = {
+	BarrierKind::Spawn,
+	BarrierKind::Sense,
+	BarrierKind::Dissemination,
+	BarrierKind::Std,
+};
+
+inline const char* BarrierKindName(BarrierKind kind)
+{
+	switch (kind)
+	{
+	case BarrierKind::Spawn:         return "spawn";
+	case BarrierKind::Sense:         return "sense";
+	case BarrierKind::Dissemination: return "dissemination";
+	case BarrierKind::Std:           return "std";
+	}
+	return "?";
+}
+
+// 이름으로 방식 찾기. 모르는 이름이면 false
+inline bool ParseBarrierKind(const char* name, BarrierKind* out)
+{
+	for (BarrierKind kind : kAllBarrierKinds)
+	{
+		if (std::strcmp(name, BarrierKindName(kind)) == 0)
+		{
+			*out = kind;
+			return true;
+		}
+	}
+	return false;
+}
+
+struct SenseBarrierAdapter
+{
+	struct Local
+	{
+		bool sense = false;
+	};
+
+	explicit SenseBarrierAdapter(int threads) : barrier(static_cast<std::uint32_t>(threads)) {}
+	void ArriveAndWait(int, Local& local) { barrier.ArriveAndWait(local.sense); }
+
+	SenseBarrier barrier;
+};
+
+struct DisseminationBarrierAdapter
+{
+	struct Local
+	{
+		std::uint32_t episode = 0;
+	};
+
+	explicit DisseminationBarrierAdapter(int threads) : barrier(static_cast<std::uint32_t>(threads)) {}
+	void ArriveAndWait(int index, Local& local) { barrier.ArriveAndWait(static_cast<std::uint32_t>(index), local.episode); }
+
+	DisseminationBarrier barrier;
+};
+
+struct StdBarrierAdapter
+{
+	struct Local
+	{
+	};
+
+	explicit StdBarrierAdapter(int threads) : barrier(threads) {}
+	void ArriveAndWait(int, Local&) { barrier.arrive_and_wait(); }
+
+	std::barrier<> barrier;
+};
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "../Common/Args.hpp"
+#include "../Common/Barrier.hpp"
+#include "../Common/CacheLine.hpp"
+#include "../Common/Timing.hpp"
+#include "BarrierKind.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 단계 하나에서 스레드 하나가 하는 일: 02 의 LocalPartial 처럼 1..max 를 지역 변수에 누적
+// (phase 를 섞어 컴파일러가 루프를 닫힌 식으로 바꾸거나 단계 사이에서 재사용하지 못하게 함)
+inline long long PhasePartial(int max, int phase)
+{
+	long long partial = 0;
+	for (int i = 1; i <= max; ++i)
+		partial += i ^ (phase & 1);
+	return partial;
+}
+
+struct PhaseResult
+{
+	BarrierKind kind = BarrierKind::Spawn;
+	int threadCount = 0;
+	int phases = 0;
+	double sec = 0.0;
+	long long total = 0;
+	long long expected = 0;
+};
+
+// 두 벌의 부분합 슬롯: 단계 p 는 slots[p & 1] 에 쓰고, 스레드 0 이 장벽 뒤에 합산합니다.
+// 다른 스레드는 그동안 다음 단계를 slots[(p + 1) & 1] 에 쓰므로 단계마다 장벽 하나로 충분합니다.
+// (slots[p & 1] 을 다시 쓰는 단계 p + 2 는 스레드 0 이 합산을 마치고 도착해야 열리는 장벽 p + 1 뒤)
+struct PhaseSlots
+{
+	explicit PhaseSlots(int threads) : partial{ std::vector<CacheLinePadded<long long>>(threads), std::vector<CacheLinePadded<long long>>(threads) } {}
+
+	long long Sum(int phase) const
+	{
+		long long sum = 0;
+		for (const auto& slot : partial[phase & 1])
+			sum += slot.value;
+		return sum;
+	}
+
+	std::vector<CacheLinePadded<long long>> partial[2];
+};
+
+// 기존 방식: 단계마다 스레드 N개를 만들고 join 한 뒤 메인이 합산
+inline PhaseResult RunSpawnPhases(int threadCount, int phases, int max)
+{
+	PhaseResult r;
+	r.kind = BarrierKind::Spawn;
+	r.threadCount = threadCount;
+	r.phases = phases;
+	PhaseSlots slots(threadCount);
+
+	StopWatch watch;
+	for (int p = 0; p < phases; ++p)
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+		for (int t = 0; t < threadCount; ++t)
+			threads.emplace_back([&slots, t, p, max] { slots.partial[p & 1][t].value = PhasePartial(max, p); });
+		for (auto& th : threads)
+			th.join();
+		r.total += slots.Sum(p);
+	}
+	r.sec = watch.ElapsedSec();
+	return r;
+}
+
+// 스레드 N개를 한 번만 만들고, 단계 사이는 장벽으로 맞춥니다.
+template <typename Adapter>
+PhaseResult RunBarrierPhases(BarrierKind kind, int threadCount, int phases, int max)
+{
+	PhaseResult r;
+	r.kind = kind;
+	r.threadCount = threadCount;
+	r.phases = phases;
+	PhaseSlots slots(threadCount);
+	Adapter barrier(threadCount);
+	Latch start(static_cast<std::uint32_t>(threadCount) + 1); // 모든 스레드가 만들어진 뒤 동시에 시작
+
+	long long total = 0; // 스레드 0 만 씀, join 으로 메인에 전달
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (int t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([&, t] {
+			typename Adapter::Local local;
+			start.ArriveAndWait();
+			for (int p = 0; p < phases; ++p)
+			{
+				slots.partial[p & 1][t].value = PhasePartial(max, p);
+				barrier.ArriveAndWait(t, local);
+				if (t == 0)
+					total += slots.Sum(p);
+			}
+		});
+	}
+
+	start.ArriveAndWait();
+	StopWatch watch;
+	for (auto& th : threads)
+		th.join();
+	r.sec = watch.ElapsedSec();
+	r.total = total;
+	return r;
+}
+
+inline PhaseResult RunPhases(BarrierKind kind, int threadCount, int phases, int max)
+{
+	PhaseResult r;
+	switch (kind)
+	{
+	case BarrierKind::Spawn:         r = RunSpawnPhases(threadCount, phases, max); break;
+	case BarrierKind::Sense:         r = RunBarrierPhases<SenseBarrierAdapter>(kind, threadCount, phases, max); break;
+	case BarrierKind::Dissemination: r = RunBarrierPhases<DisseminationBarrierAdapter>(kind, threadCount, phases, max); break;
+	case BarrierKind::Std:           r = RunBarrierPhases<StdBarrierAdapter>(kind, threadCount, phases, max); break;
+	}
+	for (int p = 0; p < phases; ++p)
+		r.expected += PhasePartial(max, p) * threadCount;
+	return r;
+}
+
+inline void PrintPhaseHeader()
+{
+	std::cout << std::left
+		<< std::setw(15) << "barrier"
+		<< std::setw(9) << "threads"
+		<< std::setw(8) << "phases"
+		<< std::setw(11) << "wall(ms)"
+		<< std::setw(13) << "us/phase"
+		<< "check\n";
+}
+
+inline void PrintPhaseRow(const PhaseResult& r)
+{
+	const std::ios::fmtflags flags = std::cout.flags();
+	std::cout << std::left << std::fixed << std::setprecision(2)
+		<< std::setw(15) << BarrierKindName(r.kind)
+		<< std::setw(9) << r.threadCount
+		<< std::setw(8) << r.phases
+		<< std::setw(11) << r.sec * 1e3
+		<< std::setw(13) << r.sec * 1e6 / r.phases
+		<< (r.total == r.expected ? "ok" : "MISMATCH") << "\n";
+	std::cout.flags(flags);
+}
+
+// 장벽 통과(crossing) 지연: 작업 없이 crossings 번 연속으로 통과한 시간 / crossings
+// spawn 은 "빈 스레드 N개를 만들고 join" 한 번을 한 번의 통과로 봅니다.
+inline double MeasureCrossingNs(BarrierKind kind, int threadCount, int crossings)
+{
+	const PhaseResult r = RunPhases(kind, threadCount, crossings, 0);
+	return r.sec * 1e9 / crossings;
+}
+
+// 인자
+// - mode=all|phases|crossing : 단계 누적 표, 장벽 통과 지연 표, 또는 둘 다 (기본 all)
+// - barrier=all|spawn|sense|dissemination|std (기본 all)
+// - threads=N 또는 threads=1,2,8 : 최대 스레드 수(1 부터 2배씩) 또는 목록 (기본 max(4, hardware_concurrency))
+// - phases=K    : 단계 수 (기본 1000)
+// - max=N       : 단계마다 스레드 하나가 더하는 1..N (기본 10000)
+// - crossings=R : 통과 지연 측정 횟수 (기본 10000, spawn 은 최대 1000)
+int SMain(const LabArgs& cli)
+{
+	const std::string mode = cli.Get("mode", "all");
+	if (mode != "all" && mode != "phases" && mode != "crossing")
+	{
+		std::cout << "unknown mode=" << mode << "\n";
+		return 1;
+	}
+	const std::string barrierName = cli.Get("barrier", "all");
+	BarrierKind only = BarrierKind::Sense;
+	if (barrierName != "all" && !ParseBarrierKind(barrierName.c_str(), &only))
+	{
+		std::cout << "unknown barrier=" << barrierName << "\n";
+		return 1;
+	}
+
+	const int hw = static_cast<int>(std::thread::hardware_concurrency());
+	const std::vector<int> threadCounts = cli.GetCountList("threads", std::max(4, hw));
+	const int phases = static_cast<int>(std::max(1LL, cli.GetInt("phases", 1000)));
+	const int max = static_cast<int>(std::max(0LL, cli.GetInt("max", 10000)));
+	const int crossings = static_cast<int>(std::max(1LL, cli.GetInt("crossings", 10000)));
+
+	std::cout << "07_PhaseBarrier (02 accumulation as phases on persistent threads, hardware_concurrency=" << hw << ")\n";
+
+	if (mode != "crossing")
+	{
+		std::cout << "\n[phases] phases=" << phases << " max=" << max << "\n";
+		PrintPhaseHeader();
+		for (int threads : threadCounts)
+		{
+			for (BarrierKind kind : kAllBarrierKinds)
+			{
+				if (barrierName == "all" || kind == only)
+					PrintPhaseRow(RunPhases(kind, threads, phases, max));
+			}
+		}
+	}
+
+	if (mode != "phases")
+	{
+		std::cout << "\n[crossing] ns per barrier crossing (no work), crossings=" << crossings << "\n";
+		std::cout << std::left << std::setw(9) << "threads";
+		for (BarrierKind kind : kAllBarrierKinds)
+		{
+			if (barrierName == "all" || kind == only)
+				std::cout << std::setw(15) << BarrierKindName(kind);
+		}
+		std::cout << "\n";
+		for (int threads : threadCounts)
+		{
+			std::cout << std::left << std::setw(9) << threads;
+			for (BarrierKind kind : kAllBarrierKinds)
+			{
+				if (barrierName != "all" && kind != only)
+					continue;
+				const int n = kind == BarrierKind::Spawn ? std::min(crossings, 1000) : crossings;
+				const std::ios::fmtflags flags = std::cout.flags();
+				std::cout << std::setw(15) << std::fixed << std::setprecision(0) << MeasureCrossingNs(kind, threads, n);
+				std::cout.flags(flags);
+			}
+			std::cout << "\n";
+		}
+	}
+
+	std::cout << "\nus/phase = wall time / phases (work + synchronization), spawn = create + join threads every phase\n";
+	return 0;
+}
@@ -0,0 +1,9 @@
+#include "Driver.hpp"
+
+// 예) Bench list=1
+//     Bench filter=02/ reps=10 threads=64 max=100000
+//     Bench format=json out=bench.json
+int main(int argc, char** argv)
+{
+	return BenchMain(LabArgs(argc, argv), argv[0]);
+}
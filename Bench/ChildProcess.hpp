@@ -0,0 +1,132 @@
+#pragma once
+
+// Bench - 랩 실행 파일을 자식 프로세스로 한 번 실행하고 자원 사용량을 잽니다.
+//
+// 랩들은 각자 SMain / WMain / 전역 변수를 가진 독립 실행 파일이므로, 한 프로세스에 합치지 않고
+// 자식 프로세스로 띄웁니다. 그러면 실행 한 번의 CPU 시간 / 문맥 교환 / peak RSS 를
+// 드라이버 자신의 사용량과 섞이지 않게 OS 에서 그대로 받을 수 있습니다.
+// - Linux  : posix_spawn + wait4 (자식의 rusage)
+// - Windows: CreateProcess + GetProcessTimes / GetProcessMemoryInfo (자식 핸들)
+
+#include "../Common/ProcessStats.hpp"
+#include "../Common/Timing.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ChildRunResult
+{
+	bool started = false;
+	int exitCode = -1;      // 시그널로 끝나면 128 + 시그널 번호
+	std::int64_t wallNs = 0; // 생성 요청부터 종료 회수까지
+	ProcessUsage usage;      // 자식 프로세스 하나의 CPU 시간 / 문맥 교환
+	long long peakRssKb = -1;
+};
+
+// exe 를 args 로 실행하고 끝날 때까지 기다립니다.
+// stdin 은 항상 닫힌 입력(/dev/null, NUL)으로 연결합니다. (키 입력을 기다리는 랩은 바로 종료)
+// showOutput 이 false 면 stdout / stderr 도 버립니다.
+inline ChildRunResult RunChildProcess(const std::string& exe, const std::vector<std::string>& args, bool showOutput)
+{
+	ChildRunResult r;
+#if defined(_WIN32)
+	std::string cmdLine = "\"" + exe + "\"";
+	for (const std::string& a : args)
+		cmdLine += " \"" + a + "\"";
+
+	SECURITY_ATTRIBUTES sa{ sizeof(sa), nullptr, TRUE }; // 자식이 상속할 수 있는 핸들
+	const HANDLE nulIn = ::CreateFileA("NUL", GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, &sa, OPEN_EXISTING, 0, nullptr);
+	const HANDLE nulOut = ::CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, &sa, OPEN_EXISTING, 0, nullptr);
+
+	STARTUPINFOA si{};
+	si.cb = sizeof(si);
+	si.dwFlags = STARTF_USESTDHANDLES;
+	si.hStdInput = nulIn;
+	si.hStdOutput = showOutput ? ::GetStdHandle(STD_OUTPUT_HANDLE) : nulOut;
+	si.hStdError = showOutput ? ::GetStdHandle(STD_ERROR_HANDLE) : nulOut;
+
+	PROCESS_INFORMATION pi{};
+	StopWatch watch;
+	const BOOL created = ::CreateProcessA(exe.c_str(), cmdLine.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr, &si, &pi);
+	if (created)
+	{
+		::WaitForSingleObject(pi.hProcess, INFINITE);
+		r.wallNs = watch.ElapsedNs();
+		r.started = true;
+
+		DWORD code = 0;
+		::GetExitCodeProcess(pi.hProcess, &code);
+		r.exitCode = static_cast<int>(code);
+
+		FILETIME creation{};
+		FILETIME exit{};
+		FILETIME kernel{};
+		FILETIME user{};
+		if (::GetProcessTimes(pi.hProcess, &creation, &exit, &kernel, &user))
+		{
+			r.usage.userNs = FileTimeToNs(user);
+			r.usage.sysNs = FileTimeToNs(kernel);
+		}
+		PROCESS_MEMORY_COUNTERS pmc{};
+		if (::GetProcessMemoryInfo(pi.hProcess, &pmc, sizeof(pmc)))
+			r.peakRssKb = static_cast<long long>(pmc.PeakWorkingSetSize / 1024);
+
+		::CloseHandle(pi.hThread);
+		::CloseHandle(pi.hProcess);
+	}
+	if (nulIn != INVALID_HANDLE_VALUE)
+		::CloseHandle(nulIn);
+	if (nulOut != INVALID_HANDLE_VALUE)
+		::CloseHandle(nulOut);
+#else
+	std::vector<char*> argv;
+	argv.push_back(const_cast<char*>(exe.c_str()));
+	for (const std::string& a : args)
+		argv.push_back(const_cast<char*>(a.c_str()));
+	argv.push_back(nullptr);
+
+	posix_spawn_file_actions_t actions;
+	::posix_spawn_file_actions_init(&actions);
+	::posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+	if (!showOutput)
+	{
+		::posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+		::posix_spawn_file_actions_adddup2(&actions, 1, 2);
+	}
+
+	pid_t pid = 0;
+	StopWatch watch;
+	const int err = ::posix_spawn(&pid, exe.c_str(), &actions, nullptr, argv.data(), environ);
+	::posix_spawn_file_actions_destroy(&actions);
+	if (err == 0)
+	{
+		int status = 0;
+		rusage usage{};
+		if (::wait4(pid, &status, 0, &usage) == pid)
+		{
+			r.wallNs = watch.ElapsedNs();
+			r.started = true;
+			r.exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+			r.usage = UsageFromRusage(usage);
+			r.peakRssKb = usage.ru_maxrss; // Linux: KB
+		}
+	}
+#endif
+	return r;
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+// Bench - 랩 변형을 반복 실행하고 통계를 냅니다.
+//
+// 흐름 (변형마다)
+// 1) warmup 회 실행하고 버립니다. (페이지 캐시, CPU 클럭, 동적 링크 준비)
+// 2) reps 회 실행하며 자식 프로세스 단위로 wall / CPU 시간 / 문맥 교환 / peak RSS 를 모읍니다.
+// 3) wall 은 min / median / p99, CPU 와 문맥 교환은 median, RSS 는 max 로 요약합니다.
+//
+// 표(table)는 사람이 보는 용도, csv / json 은 다른 머신 / 컴파일러 결과와 비교하는 용도입니다.
+// 진행 상황은 stderr 로 내보내므로 stdout 을 그대로 파일로 저장할 수 있습니다.
+
+#include "../Common/Args.hpp"
+#include "../Common/Stats.hpp"
+#include "ChildProcess.hpp"
+#include "LabRegistry.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct VariantStats
+{
+	const LabVariant* variant = nullptr;
+	std::vector<std::string> args; // 실제로 넘긴 인자
+	int runs = 0;
+	int failures = 0;              // 실행 실패 또는 exit code != 0
+	LatencySummary wallNs;
+	LatencySummary cpuNs;
+	LatencySummary contextSwitches; // Windows 는 측정 불가 (count == 0)
+	long long peakRssKb = -1;
+};
+
+inline std::string CompilerName()
+{
+#if defined(__clang__)
+	return std::string("clang ") + __clang_version__;
+#elif defined(_MSC_VER)
+	return "msvc " + std::to_string(_MSC_FULL_VER);
+#elif defined(__GNUC__)
+	return std::string("gcc ") + __VERSION__;
+#else
+	return "unknown";
+#endif
+}
+
+inline std::string DirectoryOf(const std::string& path)
+{
+	const std::size_t slash = path.find_last_of("/\\");
+	return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+}
+
+inline std::string LabExecutablePath(const std::string& binDir, const std::string& lab)
+{
+#if defined(_WIN32)
+	return binDir + "\\" + lab + ".exe";
+#else
+	return binDir + "/" + lab;
+#endif
+}
+
+// 고정 인자에 드라이버 명령줄의 params 값을 덮어씁니다. (LabArgs 는 앞쪽 값을 쓰므로 같은 키는 교체)
+inline std::vector<std::string> ResolveVariantArgs(const LabVariant& v, const LabArgs& cli)
+{
+	std::vector<std::string> args = v.args;
+	for (const std::string& key : v.params)
+	{
+		if (!cli.Has(key.c_str()))
+			continue;
+		const std::string prefix = key + "=";
+		args.erase(std::remove_if(args.begin(), args.end(),
+			[&](const std::string& a) { return a.rfind(prefix, 0) == 0; }), args.end());
+		args.push_back(prefix + cli.Get(key.c_str(), ""));
+	}
+	return args;
+}
+
+// filter=a,b : 이름에 a 또는 b 가 들어간 변형만
+inline bool MatchesFilter(const std::string& name, const std::string& filter)
+{
+	if (filter.empty())
+		return true;
+	std::stringstream ss(filter);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		if (!item.empty() && name.find(item) != std::string::npos)
+			return true;
+	}
+	return false;
+}
+
+inline VariantStats RunVariant(const LabVariant& v, const LabArgs& cli, const std::string& binDir, int warmup, int reps, bool showOutput)
+{
+	VariantStats s;
+	s.variant = &v;
+	s.args = ResolveVariantArgs(v, cli);
+	const std::string exe = LabExecutablePath(binDir, v.lab);
+
+	for (int i = 0; i < warmup; ++i)
+		RunChildProcess(exe, s.args, showOutput);
+
+	std::vector<std::int64_t> wall;
+	std::vector<std::int64_t> cpu;
+	std::vector<std::int64_t> cs;
+	for (int i = 0; i < reps; ++i)
+	{
+		const ChildRunResult r = RunChildProcess(exe, s.args, showOutput);
+		++s.runs;
+		if (!r.started || r.exitCode != 0)
+		{
+			++s.failures;
+			continue;
+		}
+		wall.push_back(r.wallNs);
+		cpu.push_back(r.usage.CpuNs());
+		if (r.usage.ContextSwitches() >= 0)
+			cs.push_back(r.usage.ContextSwitches());
+		s.peakRssKb = std::max(s.peakRssKb, r.peakRssKb);
+	}
+	s.wallNs = Summarize(wall);
+	s.cpuNs = Summarize(cpu);
+	s.contextSwitches = Summarize(cs);
+	return s;
+}
+
+inline std::string JoinArgs(const std::vector<std::string>& args)
+{
+	std::string out;
+	for (const std::string& a : args)
+		out += (out.empty() ? "" : " ") + a;
+	return out;
+}
+
+// " 와 \ 앞에 \, 0x20 미만의 제어 문자는 \u00XX
+inline std::string JsonEscape(const std::string& text)
+{
+	static constexpr char kHex[] = "0123456789abcdef";
+	std::string out;
+	for (char c : text)
+	{
+		const unsigned char u = static_cast<unsigned char>(c);
+		if (u < 0x20)
+		{
+			out += "\\u00";
+			out += kHex[u >> 4];
+			out += kHex[u & 0xf];
+			continue;
+		}
+		if (c == '"' || c == '\\')
+			out += '\\';
+		out += c;
+	}
+	return out;
+}
+
+inline void PrintStatsTable(std::ostream& os, const std::vector<VariantStats>& all)
+{
+	os << std::left
+		<< std::setw(24) << "variant"
+		<< std::setw(6) << "runs"
+		<< std::setw(11) << "wall min"
+		<< std::setw(11) << "wall p50"
+		<< std::setw(11) << "wall p99"
+		<< std::setw(11) << "cpu p50"
+		<< std::setw(10) << "ctxsw p50"
+		<< std::setw(10) << "rss(KB)"
+		<< "fail\n";
+	const std::ios::fmtflags flags = os.flags();
+	for (const VariantStats& s : all)
+	{
+		os << std::left << std::fixed << std::setprecision(2)
+			<< std::setw(24) << s.variant->name
+			<< std::setw(6) << s.runs
+			<< std::setw(11) << s.wallNs.min / 1e6
+			<< std::setw(11) << s.wallNs.p50 / 1e6
+			<< std::setw(11) << s.wallNs.p99 / 1e6
+			<< std::setw(11) << s.cpuNs.p50 / 1e6
+			<< std::setw(10) << (s.contextSwitches.count > 0 ? std::to_string(s.contextSwitches.p50) : "-")
+			<< std::setw(10) << s.peakRssKb
+			<< s.failures << "\n";
+	}
+	os.flags(flags);
+	os << "\ntimes are ms per process run (wall = spawn -> exit, cpu = user + sys)\n";
+}
+
+inline void PrintStatsCsv(std::ostream& os, const std::vector<VariantStats>& all)
+{
+	os << "variant,lab,args,runs,failures,wall_min_ns,wall_p50_ns,wall_p99_ns,cpu_p50_ns,ctxsw_p50,peak_rss_kb\n";
+	for (const VariantStats& s : all)
+	{
+		os << s.variant->name << ','
+			<< s.variant->lab << ','
+			<< '"' << JoinArgs(s.args) << "\","
+			<< s.runs << ','
+			<< s.failures << ','
+			<< s.wallNs.min << ','
+			<< s.wallNs.p50 << ','
+			<< s.wallNs.p99 << ','
+			<< s.cpuNs.p50 << ','
+			<< (s.contextSwitches.count > 0 ? s.contextSwitches.p50 : -1) << ','
+			<< s.peakRssKb << "\n";
+	}
+}
+
+inline void PrintStatsJson(std::ostream& os, const std::vector<VariantStats>& all, int warmup, int reps)
+{
+	os << "{\n";
+	os << "  \"machine\": { \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+		<< ", \"compiler\": \"" << JsonEscape(CompilerName()) << "\" },\n";
+	os << "  \"config\": { \"warmup\": " << warmup << ", \"reps\": " << reps << " },\n";
+	os << "  \"results\": [\n";
+	for (std::size_t i = 0; i < all.size(); ++i)
+	{
+		const VariantStats& s = all[i];
+		os << "    { \"variant\": \"" << JsonEscape(s.variant->name) << "\""
+			<< ", \"lab\": \"" << s.variant->lab << "\""
+			<< ", \"args\": \"" << JsonEscape(JoinArgs(s.args)) << "\""
+			<< ", \"runs\": " << s.runs
+			<< ", \"failures\": " << s.failures
+			<< ", \"wall_ns\": { \"min\": " << s.wallNs.min << ", \"p50\": " << s.wallNs.p50 << ", \"p99\": " << s.wallNs.p99 << " }"
+			<< ", \"cpu_ns_p50\": " << s.cpuNs.p50
+			<< ", \"ctxsw_p50\": " << (s.contextSwitches.count > 0 ? s.contextSwitches.p50 : -1)
+			<< ", \"peak_rss_kb\": " << s.peakRssKb
+			<< " }" << (i + 1 < all.size() ? "," : "") << "\n";
+	}
+	os << "  ]\n}\n";
+}
+
+// 인자
+// - list=1            : 등록된 변형과 인자만 출력
+// - filter=a,b        : 이름에 a 또는 b 가 들어간 변형만 (예: filter=02/,05/mpmc)
+// - warmup=N          : 버리는 실행 횟수 (기본 1)
+// - reps=N            : 측정 실행 횟수 (기본 5)
+// - format=table|csv|json (기본 table)
+// - out=path          : 결과를 파일로 저장 (기본 stdout)
+// - bin=dir           : 랩 실행 파일 위치 (기본 Bench 와 같은 디렉터리)
+// - show-output=1     : 랩의 출력을 그대로 보여줌
+// - 그 밖의 key=value : 변형의 params 에 있으면 랩에 넘김 (threads, max, n, msgs, ms, ...)
+int BenchMain(const LabArgs& cli, const char* self)
+{
+	const std::vector<LabVariant> variants = AllLabVariants();
+	const std::string filter = cli.Get("filter", "");
+	const std::string binDir = cli.Get("bin", DirectoryOf(self));
+	const int warmup = static_cast<int>(std::max(0LL, cli.GetInt("warmup", 1)));
+	const int reps = static_cast<int>(std::max(1LL, cli.GetInt("reps", 5)));
+	const std::string format = cli.Get("format", "table");
+	const bool showOutput = cli.GetInt("show-output", 0) != 0;
+	if (format != "table" && format != "csv" && format != "json")
+	{
+		std::cout << "unknown format=" << format << "\n";
+		return 1;
+	}
+
+	if (cli.GetInt("list", 0) != 0)
+	{
+		for (const LabVariant& v : variants)
+		{
+			if (MatchesFilter(v.name, filter))
+				std::cout << std::left << std::setw(24) << v.name << v.lab << " " << JoinArgs(ResolveVariantArgs(v, cli)) << "\n";
+		}
+		return 0;
+	}
+
+	std::vector<const LabVariant*> selected;
+	for (const LabVariant& v : variants)
+	{
+		if (MatchesFilter(v.name, filter))
+			selected.push_back(&v);
+	}
+	if (selected.empty())
+	{
+		std::cout << "no variant matches filter=" << filter << "\n";
+		return 1;
+	}
+
+	std::vector<VariantStats> all;
+	for (std::size_t i = 0; i < selected.size(); ++i)
+	{
+		std::cerr << "[" << (i + 1) << "/" << selected.size() << "] " << selected[i]->name << "\n";
+		all.push_back(RunVariant(*selected[i], cli, binDir, warmup, reps, showOutput));
+	}
+
+	std::ofstream file;
+	const std::string outPath = cli.Get("out", "");
+	if (!outPath.empty())
+	{
+		file.open(outPath);
+		if (!file)
+		{
+			std::cout << "cannot open out=" << outPath << "\n";
+			return 1;
+		}
+	}
+	std::ostream& os = outPath.empty() ? std::cout : file;
+
+	if (format == "csv")
+		PrintStatsCsv(os, all);
+	else if (format == "json")
+		PrintStatsJson(os, all, warmup, reps);
+	else
+		PrintStatsTable(os, all);
+
+	int failures = 0;
+	for (const VariantStats& s : all)
+		failures += s.failures;
+	return failures == 0 ? 0 : 2;
+}
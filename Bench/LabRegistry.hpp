@@ -0,0 +1,102 @@
+#pragma once
+
+// Bench - 측정 대상 목록
+//
+// 변형(variant) 하나 = 랩 실행 파일 + 고정 인자입니다.
+// params 에 적힌 키는 드라이버 명령줄에서 바꿀 수 있습니다. (예: Bench threads=64 max=100000)
+// 고정 인자는 반복 측정에 알맞도록 기본값보다 작게 잡아 두었습니다.
+//
+// 03_SignalWaiting 의 Tick/Tock 버전은 키 입력을 기다리므로, stdin 을 닫아 바로 종료시키고
+// "워커 시작 → 종료 요청 → join" 비용을 잽니다. Windows 는 _kbhit 이 stdin 이 아닌 콘솔을 보므로 제외합니다.
+
+#include <string>
+#include <vector>
+
+struct LabVariant
+{
+	std::string name;                // "02/atomic-spawn"
+	std::string lab;                 // 실행 파일 이름 (확장자 제외)
+	std::vector<std::string> args;   // 고정 인자 "key=value"
+	std::vector<std::string> params; // 드라이버에서 덮어쓸 수 있는 키
+};
+
+inline std::vector<LabVariant> AllLabVariants()
+{
+	std::vector<LabVariant> v;
+
+	// 01_ThreadLifeCycle
+	v.push_back({ "01/std-thread", "01_ThreadLifeCycle", { "api=std", "ms=100" }, { "ms" } });
+	v.push_back({ "01/lifecycle", "01_ThreadLifeCycle", { "mode=lifecycle", "iterations=500" }, { "iterations", "stack" } });
+#if defined(_WIN32)
+	v.push_back({ "01/win-thread", "01_ThreadLifeCycle", { "api=win" }, {} });
+#endif
+
+	// 02_MutualExclusion - 누적 전략 x 실행 방식
+	for (const char* mode : { "global-lock", "atomic", "padded-shards", "local-partial" })
+	{
+		for (const char* exec : { "spawn", "pool" })
+		{
+			v.push_back({ std::string("02/") + mode + "-" + exec, "02_MutualExclusion",
+				{ std::string("mode=") + mode, std::string("exec=") + exec, "threads=1000", "max=10000" },
+				{ "threads", "max", "lock", "workers", "profile" } });
+		}
+#if defined(_WIN32)
+		v.push_back({ std::string("02/win-") + mode, "02_MutualExclusion",
+			{ "api=win", std::string("mode=") + mode, "exec=spawn", "threads=1000", "max=10000" },
+			{ "threads", "max" } });
+#endif
+	}
+	v.push_back({ "02/lock-bench", "02_MutualExclusion", { "mode=lock-bench", "ms=20" }, { "lock", "threads", "cs", "ms", "profile" } });
+	v.push_back({ "02/global-lock-profiled", "02_MutualExclusion",
+		{ "mode=global-lock", "exec=spawn", "threads=1000", "max=10000", "profile=1" }, { "threads", "max", "lock", "holdsample" } });
+	v.push_back({ "02/read-mostly", "02_MutualExclusion", { "mode=read-mostly", "ms=50" }, { "rw", "reads", "threads", "ms" } });
+	v.push_back({ "02/topology", "02_MutualExclusion", { "mode=topology", "ms=50" }, { "lock", "threads", "ms" } });
+
+	// 03_SignalWaiting
+#if !defined(_WIN32)
+	v.push_back({ "03/cv", "03_SignalWaiting", { "gate=cv" }, {} });
+	v.push_back({ "03/rungate", "03_SignalWaiting", { "gate=rungate" }, {} });
+	v.push_back({ "03/coroutine", "03_SignalWaiting", { "mode=coroutine" }, { "pool" } });
+	v.push_back({ "03/timer", "03_SignalWaiting", { "mode=timer" }, { "period", "poll" } });
+	v.push_back({ "03/epoch", "03_SignalWaiting", { "gate=epoch" }, { "workers" } });
+	v.push_back({ "03/input-bench", "03_SignalWaiting", { "mode=input-bench", "commands=50", "idle=500" }, { "commands", "idle" } });
+#endif
+	v.push_back({ "03/gate-bench", "03_SignalWaiting", { "mode=gate-bench", "ms=100", "cycles=200" }, { "ms", "cycles" } });
+	v.push_back({ "03/coro-bench", "03_SignalWaiting", { "mode=coro-bench", "workers=1,100,1000", "ticks=10" }, { "workers", "pool", "period", "ticks" } });
+	v.push_back({ "03/timer-bench", "03_SignalWaiting", { "mode=timer-bench", "timers=1,1000,100000", "ms=500", "max-threads=1000" }, { "timers", "period", "ms", "max-threads" } });
+	v.push_back({ "03/broadcast-bench", "03_SignalWaiting", { "mode=broadcast-bench", "workers=1,16,256", "rounds=5" }, { "workers", "rounds", "work", "sleep" } });
+
+	// 04_ThreadResult
+	v.push_back({ "04/promise", "04_ThreadResult", { "api=std" }, { "n" } });
+#if defined(_WIN32)
+	v.push_back({ "04/win-event", "04_ThreadResult", { "api=win" }, {} });
+#endif
+	v.push_back({ "04/parallel-sum", "04_ThreadResult", { "mode=parallel-sum", "n=100000000", "reps=1" }, { "n", "grain", "workers" } });
+	v.push_back({ "04/lab-future", "04_ThreadResult", { "mode=lab-future", "iterations=20000" }, { "iterations" } });
+	v.push_back({ "04/reduce", "04_ThreadResult", { "mode=reduce", "max=16", "work=32", "n=10000000" }, { "max", "work", "simd", "workers", "n" } });
+	v.push_back({ "04/cancel", "04_ThreadResult", { "mode=cancel", "iterations=100", "ms=300" }, { "iterations", "workers", "service", "load", "deadline", "ms" } });
+	v.push_back({ "04/coroutine", "04_ThreadResult", { "mode=coroutine" }, { "n", "pool" } });
+	v.push_back({ "04/result-pool", "04_ThreadResult", { "mode=result-pool", "rounds=200000" }, { "result", "rounds", "inflight", "workers", "n", "pool" } });
+
+	// 05_MessageQueue
+	for (const char* queue : { "mutex+cv", "cv-coalesced", "mpmc", "spsc" })
+	{
+		const bool spsc = std::string(queue) == "spsc";
+		v.push_back({ std::string("05/") + queue, "05_MessageQueue",
+			{ std::string("queue=") + queue, spsc ? "pc=1:1" : "pc=4:4", "batch=16", "msgs=200000" },
+			{ "pc", "batch", "msgs", "capacity" } });
+	}
+	v.push_back({ "05/log-bench", "05_MessageQueue", { "mode=log-bench", "threads=1,4", "lines=50000" }, { "sink", "threads", "lines", "logqueue", "out" } });
+#if defined(_WIN32)
+	v.push_back({ "05/win-srw", "05_MessageQueue", { "api=win", "pc=4:4", "batch=16", "msgs=200000" }, { "pc", "batch", "msgs", "capacity" } });
+#endif
+
+	// 06_FalseSharing
+	v.push_back({ "06/false-sharing", "06_FalseSharing", { "ms=50", "threads=4" }, { "layout", "threads", "ms", "perf" } });
+
+	// 07_PhaseBarrier
+	v.push_back({ "07/phases", "07_PhaseBarrier", { "mode=phases", "threads=1,2,4", "phases=200" }, { "barrier", "threads", "phases", "max" } });
+	v.push_back({ "07/crossing", "07_PhaseBarrier", { "mode=crossing", "threads=4", "crossings=2000" }, { "barrier", "threads", "crossings" } });
+
+	return v;
+}
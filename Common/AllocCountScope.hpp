@@ -0,0 +1,47 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 힙 할당 횟수 세기 (카운터와 측정 구간)
+//
+// 이 헤더는 카운터만 정의하므로 어디서 include 해도 됩니다. 실제로 세려면 프로그램의 main 이 있는 .cpp 가
+// Common/AllocCounter.hpp 를 include 해서 전역 operator new 를 바꿔야 합니다. (아니면 항상 0)
+
+#include <atomic>
+#include <cstddef>
+
+struct AllocCounter
+{
+	static inline std::atomic<bool> enabled{ false };
+	static inline std::atomic<long long> allocations{ 0 };
+	static inline std::atomic<long long> bytes{ 0 };
+
+	static void Count(std::size_t size)
+	{
+		if (!enabled.load(std::memory_order_relaxed))
+			return;
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+	}
+};
+
+// 열려 있는 동안 센 할당 (중첩하지 않습니다)
+class AllocCountScope
+{
+public:
+	AllocCountScope()
+	{
+		AllocCounter::allocations.store(0, std::memory_order_relaxed);
+		AllocCounter::bytes.store(0, std::memory_order_relaxed);
+		AllocCounter::enabled.store(true, std::memory_order_seq_cst);
+	}
+
+	~AllocCountScope() { Stop(); }
+
+	AllocCountScope(const AllocCountScope&) = delete;
+	AllocCountScope& operator=(const AllocCountScope&) = delete;
+
+	// 세기를 멈춥니다. 이후의 할당(결과 출력 등)은 세지 않습니다.
+	void Stop() { AllocCounter::enabled.store(false, std::memory_order_seq_cst); }
+
+	long long Allocations() const { return AllocCounter::allocations.load(std::memory_order_relaxed); }
+	long long Bytes() const { return AllocCounter::bytes.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 힙 할당 횟수 세기
+//
+// 전역 operator new / delete 를 바꿔서, AllocCountScope 가 열려 있는 동안 모든 스레드의 할당 횟수와 바이트를 셉니다.
+// "이 구간은 정상 상태에서 할당이 0 회" 같은 주장을 숫자로 확인할 때 씁니다. (04 mode=result-pool)
+//
+// 주의
+// - 전역 함수를 정의하므로 프로그램에서 한 번, main 이 있는 .cpp 에서만 include 합니다. (랩은 .cpp 하나)
+//   바뀐 operator new 는 그 프로그램의 모든 모드에 적용됩니다. 측정 코드(랩 헤더)는 AllocCountScope.hpp 만 include 합니다.
+// - 세지 않을 때도 바뀐 operator new 를 지나므로, 할당마다 atomic load 한 번이 더 듭니다.
+// - 배열 / nothrow 형태의 기본 구현은 아래 함수를 부르므로 따로 바꾸지 않습니다.
+
+#include "AllocCountScope.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h> // _aligned_malloc
+#endif
+
+// GCC 12 는 이 operator delete 가 인라인된 곳에서 free 가 operator new 의 짝이 아니라고 잘못 판단합니다.
+// (-Wmismatched-new-delete, 교체한 new 는 malloc 으로 할당하므로 짝이 맞음)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+	AllocCounter::Count(size);
+	if (void* p = std::malloc(size == 0 ? 1 : size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+	AllocCounter::Count(size);
+	const std::size_t a = static_cast<std::size_t>(align);
+#if defined(_WIN32)
+	if (void* p = _aligned_malloc(size == 0 ? 1 : size, a))
+		return p;
+#else
+	// aligned_alloc 은 크기가 정렬의 배수여야 합니다.
+	const std::size_t rounded = (size + a - 1) / a * a;
+	if (void* p = std::aligned_alloc(a, rounded == 0 ? a : rounded))
+		return p;
+#endif
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+#if defined(_WIN32)
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { operator delete(p, align); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
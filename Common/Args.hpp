@@ -0,0 +1,96 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 명령줄 인자
+//
+// 랩 실행 파일은 "key=value" 형태의 인자를 받습니다. (앞의 "--"는 생략 가능)
+//   ./02_MutualExclusion mode=atomic threads=8 max=1000000
+// 지정하지 않은 값은 각 랩의 기본값(kThreadCount, kMax 등)을 사용합니다.
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// "1,16,64" -> {1, 16, 64}. 0 이하이거나 숫자가 아닌 항목은 건너뜁니다.
+inline std::vector<int> ParseIntList(const std::string& text)
+{
+	std::vector<int> out;
+	std::stringstream ss(text);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		const int v = std::atoi(item.c_str());
+		if (v > 0)
+			out.push_back(v);
+	}
+	return out;
+}
+
+// 1 부터 maxCount 까지 2배씩, 마지막은 maxCount (6 -> {1, 2, 4, 6})
+inline std::vector<int> DoublingCounts(int maxCount)
+{
+	std::vector<int> out;
+	for (int n = 1; n < maxCount; n *= 2)
+		out.push_back(n);
+	out.push_back(maxCount < 1 ? 1 : maxCount);
+	return out;
+}
+
+class LabArgs
+{
+public:
+	LabArgs(int argc, char** argv) : argc_(argc), argv_(argv) {}
+
+	bool Has(const char* key) const { return Find(key) != nullptr; }
+
+	std::string Get(const char* key, const std::string& fallback) const
+	{
+		const char* v = Find(key);
+		return v ? std::string(v) : fallback;
+	}
+
+	long long GetInt(const char* key, long long fallback) const
+	{
+		const char* v = Find(key);
+		return v ? std::strtoll(v, nullptr, 10) : fallback;
+	}
+
+	double GetDouble(const char* key, double fallback) const
+	{
+		const char* v = Find(key);
+		return v ? std::strtod(v, nullptr) : fallback;
+	}
+
+	// key=1,2,8 처럼 목록이면 그 목록, key=N 이면 DoublingCounts(N), 없으면 DoublingCounts(fallbackMax)
+	// (스레드 수 목록 threads= 에 씁니다. 목록에 쓸 수 있는 값이 없으면 없는 것과 같음)
+	std::vector<int> GetCountList(const char* key, long long fallbackMax) const
+	{
+		const std::string text = Get(key, "");
+		if (text.find(',') != std::string::npos)
+		{
+			std::vector<int> list = ParseIntList(text);
+			if (!list.empty())
+				return list;
+			return DoublingCounts(static_cast<int>(fallbackMax));
+		}
+		return DoublingCounts(static_cast<int>(GetInt(key, fallbackMax)));
+	}
+
+private:
+	// "key=value" 또는 "--key=value" 에서 value 부분을 찾습니다.
+	const char* Find(const char* key) const
+	{
+		const std::string k(key);
+		for (int i = 1; i < argc_; ++i)
+		{
+			std::string a = argv_[i];
+			std::size_t offset = (a.rfind("--", 0) == 0) ? 2 : 0;
+			if (a.compare(offset, k.size(), k) == 0 && a.size() > offset + k.size() && a[offset + k.size()] == '=')
+				return argv_[i] + offset + k.size() + 1;
+		}
+		return nullptr;
+	}
+
+	int argc_;
+	char** argv_;
+};
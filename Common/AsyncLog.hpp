@@ -0,0 +1,374 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 비동기 로그 싱크
+//
+// 워커 스레드가 std::cout 에 직접 쓰면 스트림(stdio) 락과 콘솔 쓰기가 숨은 직렬화 지점이 됩니다.
+// 한 스레드가 콘솔에 쓰는 동안 다른 워커는 모두 그 락 앞에서 기다립니다.
+//
+// - 포맷: 호출한 스레드가 자기 스택의 LogRecord(고정 크기 문자 버퍼)에 std::to_chars 로 씁니다. (할당, locale 없음)
+// - 수집: 완성된 레코드를 lock-free MPMC 큐(LockFreeQueue.hpp)에 넣습니다. 소비자는 flusher 하나뿐이므로 MPSC 로 씁니다.
+// - 출력: flusher 스레드 하나가 큐를 비우며 레코드를 모아 fwrite 한 번으로 stdout 또는 파일에 씁니다.
+// - 큐가 가득 차면 정책에 따라
+//   - Block : flusher 가 자리를 만들 때까지 호출한 스레드가 futex 에서 기다림 (줄을 잃지 않음, 랩 기본값)
+//   - Drop  : 그 줄을 버리고 개수만 셈. flusher 가 "[log] dropped N lines" 를 대신 씁니다. (호출자는 절대 기다리지 않음)
+// - 큐가 비면 flusher 는 kLogFlushNapNs 동안 혼자 졸고, 그래도 비어 있으면 futex 에서 깊이 잠듭니다.
+//   생산자는 flusher 가 깊이 잠들어 있을 때만 깨우기 시스템 콜을 부르므로, 줄이 계속 들어오는 동안에는 호출자가 시스템 콜을 하지 않습니다.
+//   단, 넣기에 실패했거나 큐가 고수위(용량의 절반)를 넘으면 낮잠 중인 flusher 도 깨웁니다. (낮잠 동안 큐가 넘쳐 줄을 잃지 않도록)
+//
+//   int main(int argc, char** argv)
+//   {
+//       const LabArgs cli(argc, argv);
+//       AsyncLogSession log(cli);                // log=async|sync, logfile=, logpolicy=drop|block, logqueue=N
+//       ...
+//   }
+//   Log() << "[worker " << index << "] tick=" << n;   // 줄 끝의 '\n' 은 자동. 문장이 끝날 때(임시 객체 소멸) 큐에 넣음
+//
+// 세션이 없거나 log=sync 이면 Log() 는 한 줄을 fwrite 한 번으로 바로 씁니다.
+// 같은 출력으로 가는 메인 스레드의 std::cout 과 순서를 맞추려면, 워커 출력과 순서가 중요한 메인의 줄도 Log() 로 씁니다.
+
+#include "Args.hpp"
+#include "Futex.hpp"
+#include "LockFreeQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 레코드 한 줄의 최대 길이 ('\n' 포함). 넘치면 잘라서 끝을 "..." 으로 바꿉니다.
+constexpr std::size_t kLogRecordText = 240;
+constexpr std::size_t kLogDefaultQueue = 4096;
+// logqueue= 의 허용 범위 (레코드 하나가 kLogRecordText 바이트이므로 상한은 메모리 보호용)
+constexpr long long kLogMinQueue = 2;
+constexpr long long kLogMaxQueue = 1LL << 20;
+// flusher 가 fwrite 한 번에 모으는 최대 레코드 수
+constexpr std::size_t kLogFlushBatch = 256;
+// 큐가 비면 flusher 는 이만큼 혼자 졸다가 다시 봅니다. 그래도 비어 있을 때만 parked_ 를 세우고 깊이 잠듭니다.
+constexpr std::int64_t kLogFlushNapNs = 1000000;
+
+enum class LogOverflow
+{
+	Block,
+	Drop,
+};
+
+struct LogRecord
+{
+	std::uint32_t length = 0;
+	char text[kLogRecordText];
+};
+
+class AsyncLogger
+{
+public:
+	static AsyncLogger& Instance()
+	{
+		static AsyncLogger logger;
+		return logger;
+	}
+
+	AsyncLogger(const AsyncLogger&) = delete;
+	AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+	~AsyncLogger() { Stop(); }
+
+	// out 은 stdout 또는 열린 파일. ownsFile 이면 Stop 에서 닫습니다.
+	void Start(std::FILE* out, bool ownsFile, LogOverflow policy, std::size_t queueCapacity)
+	{
+		Stop();
+		out_ = out;
+		ownsFile_ = ownsFile;
+		policy_ = policy;
+		queue_ = std::make_unique<MpmcQueue<LogRecord>>(queueCapacity);
+		highWater_ = queue_->Capacity() / 2;
+		dropped_.store(0, std::memory_order_relaxed);
+		reportedDropped_ = 0;
+		stop_.store(false, std::memory_order_relaxed);
+		flusher_ = std::thread([this] { FlusherLoop(); });
+		running_.store(true, std::memory_order_release);
+	}
+
+	// 남은 레코드를 모두 쓴 뒤 flusher 를 끝냅니다. (Start 한 스레드에서 호출)
+	void Stop()
+	{
+		if (!running_.exchange(false, std::memory_order_acq_rel))
+			return;
+		stop_.store(true, std::memory_order_seq_cst);
+		WakeFlusher(true);
+		flusher_.join();
+		std::fflush(out_);
+		if (ownsFile_)
+			std::fclose(out_);
+		out_ = stdout;
+		ownsFile_ = false;
+	}
+
+	bool Running() const { return running_.load(std::memory_order_acquire); }
+	std::uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+	LogOverflow Policy() const { return policy_; }
+
+	// 레코드 한 줄 제출. 세션이 없으면 바로 씁니다.
+	void Submit(const LogRecord& record)
+	{
+		if (!Running())
+		{
+			std::fwrite(record.text, 1, record.length, stdout);
+			return;
+		}
+
+		while (!queue_->TryPush(record))
+		{
+			if (policy_ == LogOverflow::Drop)
+			{
+				dropped_.fetch_add(1, std::memory_order_relaxed);
+				WakeFlusher(false);
+				return;
+			}
+			// Block: flusher 가 레코드를 꺼낼 때마다 freed_ 를 올립니다. 값을 읽은 뒤 다시 시도해 보고 기다립니다.
+			const std::uint32_t freed = freed_.load(std::memory_order_acquire);
+			if (queue_->TryPush(record))
+				break;
+			blockedWaiters_.fetch_add(1, std::memory_order_seq_cst);
+			WakeFlusher(true);
+			FutexWait(&freed_, freed);
+			blockedWaiters_.fetch_sub(1, std::memory_order_relaxed);
+		}
+		// 레코드 공개(큐의 release store) 뒤 flusher 의 parked_ 를 읽기 전에 전체 펜스: 잠들려는 flusher 와 엇갈려도 깨우기를 놓치지 않음
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (parked_.load(std::memory_order_relaxed) || queue_->ApproxSize() >= highWater_)
+			WakeFlusher(false);
+	}
+
+private:
+	AsyncLogger() = default;
+
+	// flusher 가 깊이 잠들었거나 낮잠 중이면 깨웁니다. force 이면 어느 쪽도 아니어도 wake_ 를 올립니다. (Stop, Block)
+	// 고수위 경로에서는 flusher 가 깨어 있는 동안 매번 불리므로, 플래그를 먼저 읽어 세워져 있을 때만 exchange 합니다.
+	void WakeFlusher(bool force)
+	{
+		bool wake = force;
+		if (parked_.load(std::memory_order_relaxed) && parked_.exchange(false, std::memory_order_acq_rel))
+			wake = true;
+		if (napping_.load(std::memory_order_relaxed) && napping_.exchange(false, std::memory_order_acq_rel))
+			wake = true;
+		if (wake)
+		{
+			wake_.fetch_add(1, std::memory_order_release);
+			FutexWakeOne(&wake_);
+		}
+	}
+
+	void FlusherLoop()
+	{
+		std::vector<char> batch;
+		batch.reserve(kLogFlushBatch * kLogRecordText);
+		LogRecord record;
+		bool napped = false;
+		while (true)
+		{
+			std::size_t n = 0;
+			while (n < kLogFlushBatch && queue_->TryPop(record))
+			{
+				batch.insert(batch.end(), record.text, record.text + record.length);
+				++n;
+			}
+			if (n > 0)
+				NotifyFreed();
+			AppendDroppedNotice(batch);
+			if (!batch.empty())
+			{
+				std::fwrite(batch.data(), 1, batch.size(), out_);
+				std::fflush(out_);
+				batch.clear();
+				napped = false;
+				continue;
+			}
+
+			if (stop_.load(std::memory_order_acquire))
+				return;
+
+			// 줄이 계속 들어오는 동안에는 짧은 낮잠만 잡니다. parked_ 를 세우지 않으므로 생산자는 큐가 고수위를 넘거나 가득 찰 때만 깨웁니다.
+			if (!napped)
+			{
+				const std::uint32_t w = wake_.load(std::memory_order_acquire);
+				napping_.store(true, std::memory_order_seq_cst);
+				FutexWaitFor(&wake_, w, kLogFlushNapNs);
+				napping_.store(false, std::memory_order_relaxed);
+				napped = true;
+				continue;
+			}
+			napped = false;
+
+			// 잠들기: parked_ 를 세운 뒤 큐를 한 번 더 확인합니다. 그 뒤에 들어온 레코드는 생산자가 parked_ 를 보고 깨웁니다.
+			const std::uint32_t w = wake_.load(std::memory_order_acquire);
+			parked_.store(true, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (queue_->TryPop(record))
+			{
+				parked_.store(false, std::memory_order_relaxed);
+				batch.insert(batch.end(), record.text, record.text + record.length);
+				NotifyFreed();
+				continue;
+			}
+			if (stop_.load(std::memory_order_acquire))
+				return;
+			FutexWait(&wake_, w);
+			parked_.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	// Block 정책에서 기다리는 생산자가 있을 때만 깨웁니다. (생산자: waiters 증가 → freed_ 확인, 여기: freed_ 증가 → waiters 확인)
+	void NotifyFreed()
+	{
+		freed_.fetch_add(1, std::memory_order_seq_cst);
+		if (blockedWaiters_.load(std::memory_order_seq_cst) > 0)
+			FutexWakeAll(&freed_);
+	}
+
+	void AppendDroppedNotice(std::vector<char>& batch)
+	{
+		const std::uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+		if (dropped == reportedDropped_)
+			return;
+		char line[64];
+		const int len = std::snprintf(line, sizeof(line), "[log] dropped %llu lines\n",
+			static_cast<unsigned long long>(dropped - reportedDropped_));
+		batch.insert(batch.end(), line, line + len);
+		reportedDropped_ = dropped;
+	}
+
+	std::FILE* out_ = stdout;
+	bool ownsFile_ = false;
+	LogOverflow policy_ = LogOverflow::Block;
+	std::unique_ptr<MpmcQueue<LogRecord>> queue_;
+	std::thread flusher_;
+	std::atomic<bool> running_{ false };
+	std::atomic<bool> stop_{ false };
+	std::atomic<bool> parked_{ false };      // flusher 가 잠들었거나 잠들려는 중
+	std::atomic<bool> napping_{ false };     // flusher 가 kLogFlushNapNs 낮잠 중 (고수위, 넣기 실패 때만 깨움)
+	std::size_t highWater_ = 0;             // 이만큼 차 있으면 낮잠 중인 flusher 도 깨움 (용량의 절반)
+	FutexWord wake_{ 0 };                   // flusher 를 깨울 때 올림
+	FutexWord freed_{ 0 };                  // flusher 가 자리를 만들 때마다 올림 (Block 대기용)
+	std::atomic<std::uint32_t> blockedWaiters_{ 0 };
+	std::atomic<std::uint64_t> dropped_{ 0 };
+	std::uint64_t reportedDropped_ = 0;     // flusher 전용
+};
+
+// 한 줄을 호출한 스레드에서 포맷하고, 소멸할 때 '\n' 을 붙여 제출합니다.
+class LogLine
+{
+public:
+	LogLine() = default;
+	~LogLine()
+	{
+		if (record_.length >= kLogRecordText)
+			record_.length = kLogRecordText - 1;
+		record_.text[record_.length++] = '\n';
+		AsyncLogger::Instance().Submit(record_);
+	}
+
+	LogLine(const LogLine&) = delete;
+	LogLine& operator=(const LogLine&) = delete;
+
+	LogLine& operator<<(std::string_view s)
+	{
+		Append(s.data(), s.size());
+		return *this;
+	}
+
+	LogLine& operator<<(const char* s) { return *this << std::string_view(s); }
+	LogLine& operator<<(const std::string& s) { return *this << std::string_view(s); }
+
+	LogLine& operator<<(char c)
+	{
+		Append(&c, 1);
+		return *this;
+	}
+
+	LogLine& operator<<(bool b) { return *this << (b ? "true" : "false"); }
+
+	template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+	LogLine& operator<<(T value)
+	{
+		char digits[32];
+		std::to_chars_result r;
+		// 실수는 std::cout 기본값과 같이 유효 숫자 6자리 (%g)
+		if constexpr (std::is_floating_point_v<T>)
+			r = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+		else
+			r = std::to_chars(digits, digits + sizeof(digits), value);
+		if (r.ec == std::errc())
+			Append(digits, static_cast<std::size_t>(r.ptr - digits));
+		return *this;
+	}
+
+private:
+	// '\n' 자리 하나를 남겨 둡니다. 넘치면 끝 세 글자를 "..." 으로
+	void Append(const char* s, std::size_t n)
+	{
+		constexpr std::size_t limit = kLogRecordText - 1;
+		const std::size_t room = limit - record_.length;
+		const std::size_t take = n < room ? n : room;
+		std::memcpy(record_.text + record_.length, s, take);
+		record_.length += static_cast<std::uint32_t>(take);
+		if (take < n)
+			std::memcpy(record_.text + limit - 3, "...", 3);
+	}
+
+	LogRecord record_;
+};
+
+inline LogLine Log() { return LogLine(); }
+
+// logqueue= 를 읽어 kLogMinQueue..kLogMaxQueue 로 제한합니다. (음수나 아주 큰 값이 size_t 로 넘어가 2의 거듭제곱 올림에서 넘치지 않도록)
+inline std::size_t LogQueueCapacity(const LabArgs& cli)
+{
+	const long long n = cli.GetInt("logqueue", static_cast<long long>(kLogDefaultQueue));
+	return static_cast<std::size_t>(std::clamp(n, kLogMinQueue, kLogMaxQueue));
+}
+
+// main 에 하나: 인자에 따라 AsyncLogger 를 시작하고, 소멸자(main 끝)에서 남은 줄을 모두 씁니다.
+// - log=async|sync     : 비동기 싱크(기본) 또는 호출한 스레드에서 바로 쓰기
+// - logfile=path       : stdout 대신 파일
+// - logpolicy=block|drop : 큐가 가득 찼을 때 (기본 block)
+// - logqueue=N         : 큐 용량 (레코드 수, 기본 kLogDefaultQueue, kLogMinQueue..kLogMaxQueue 로 제한)
+class AsyncLogSession
+{
+public:
+	explicit AsyncLogSession(const LabArgs& cli)
+	{
+		const std::string mode = cli.Get("log", "async");
+		if (mode != "async")
+			return;
+		std::FILE* out = stdout;
+		const std::string path = cli.Get("logfile", "");
+		if (!path.empty())
+		{
+			out = std::fopen(path.c_str(), "w");
+			if (out == nullptr)
+			{
+				std::cout << "[log] cannot open " << path << ", using stdout\n";
+				out = stdout;
+			}
+		}
+		const LogOverflow policy = cli.Get("logpolicy", "block") == "drop" ? LogOverflow::Drop : LogOverflow::Block;
+		// 세션 시작 전에 std::cout 에 쓴 내용이 먼저 나가도록
+		std::cout.flush();
+		AsyncLogger::Instance().Start(out, out != stdout, policy, LogQueueCapacity(cli));
+	}
+
+	~AsyncLogSession() { AsyncLogger::Instance().Stop(); }
+
+	AsyncLogSession(const AsyncLogSession&) = delete;
+	AsyncLogSession& operator=(const AsyncLogSession&) = delete;
+};
@@ -0,0 +1,234 @@
+#pragma once
+
+// ThreadLab 공용 코어 - Latch / Barrier
+//
+// 지금까지의 랩은 "모두 끝날 때까지" 를 join / WaitForMultipleObjects 로만 기다립니다.
+// 같은 스레드들이 단계(phase)를 여러 번 반복하는 계산에서는 단계마다 스레드를 만들고 없애는 대신,
+// 살아 있는 스레드들이 단계 끝에서 서로를 기다리는 장벽(barrier)을 씁니다.
+//
+// - Latch                : 한 번 쓰는 카운트다운. CountDown 으로 0 이 되면 Wait 하던 스레드가 모두 풀림
+// - SenseBarrier         : 중앙 카운터 + sense 반전. 마지막 도착자가 카운터를 되돌리고 전역 sense 를 뒤집음
+//                          (도착마다 모든 스레드가 카운터 라인 하나에 fetch_sub → 스레드가 많으면 라인 경합)
+// - DisseminationBarrier : ceil(log2 N) 라운드. 라운드 k 에서 스레드 i 는 (i + 2^k) mod N 에게 신호를 보내고
+//                          자기에게 오는 신호만 기다림. 공유 카운터가 없고 각 플래그는 자기 캐시 라인에 있음
+//
+// 기다리는 방법 (세 타입 공통)
+// - 코어가 둘 이상이면(SpinWaitUseful) 잠깐 스핀하고, 코어가 하나면 몇 번 yield 한 뒤, 그래도 안 풀리면 futex(Futex.hpp)에서 잠듭니다.
+// - 잠들기 전에 워드에 kParkedBit 를 남기므로, 신호를 보내는 쪽은 잠든 스레드가 있을 때만 깨우기 시스템 콜을 부릅니다.
+
+#include "CacheLine.hpp"
+#include "Futex.hpp"
+#include "Platform.hpp" // CpuRelax, SpinWaitUseful
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// 잠들기 전에 스핀하는 횟수 (pause 한 번 = 수십 ns)
+constexpr int kBarrierSpinCount = 4000;
+// 코어가 하나뿐이면 스핀 대신 양보하는 횟수 (아직 도착하지 않은 스레드가 바로 실행되도록)
+constexpr int kBarrierYieldCount = 8;
+
+// ready() 가 참이 될 때까지 잠깐 스핀(코어가 하나면 yield)합니다. 그 안에 참이 되면 true
+template <typename Ready>
+bool SpinThenYield(Ready ready)
+{
+	if (SpinWaitUseful())
+	{
+		for (int i = 0; i < kBarrierSpinCount; ++i)
+		{
+			if (ready())
+				return true;
+			CpuRelax();
+		}
+		return false;
+	}
+	for (int i = 0; i < kBarrierYieldCount; ++i)
+	{
+		if (ready())
+			return true;
+		std::this_thread::yield();
+	}
+	return false;
+}
+
+class Latch
+{
+public:
+	// 워드의 최상위 비트는 잠든 스레드 표시, 나머지 31비트가 남은 카운트
+	static constexpr std::uint32_t kParkedBit = 1u << 31;
+	static constexpr std::uint32_t kCountMask = kParkedBit - 1;
+
+	explicit Latch(std::uint32_t count) : count_(count & kCountMask) {}
+
+	Latch(const Latch&) = delete;
+	Latch& operator=(const Latch&) = delete;
+
+	// 카운트가 n 이상일 때만 호출합니다. (빌리기가 kParkedBit 까지 넘어가지 않음)
+	void CountDown(std::uint32_t n = 1)
+	{
+		const std::uint32_t old = count_.fetch_sub(n, std::memory_order_acq_rel);
+		if ((old & kCountMask) == n && (old & kParkedBit))
+			FutexWakeAll(&count_);
+	}
+
+	bool TryWait() const { return (count_.load(std::memory_order_acquire) & kCountMask) == 0; }
+
+	void Wait()
+	{
+		if (SpinThenYield([&] { return TryWait(); }))
+			return;
+		std::uint32_t c = count_.load(std::memory_order_acquire);
+		while ((c & kCountMask) != 0)
+		{
+			if (!(c & kParkedBit))
+			{
+				if (!count_.compare_exchange_weak(c, c | kParkedBit, std::memory_order_acq_rel, std::memory_order_acquire))
+					continue;
+				c |= kParkedBit;
+			}
+			FutexWait(&count_, c);
+			c = count_.load(std::memory_order_acquire);
+		}
+	}
+
+	void ArriveAndWait()
+	{
+		CountDown();
+		Wait();
+	}
+
+private:
+	FutexWord count_;
+};
+
+// 중앙 집중형 sense 반전 장벽
+//
+//   SenseBarrier barrier(n);
+//   bool sense = false;                 // 스레드마다 지역 sense
+//   barrier.ArriveAndWait(sense);       // 단계마다
+class SenseBarrier
+{
+public:
+	static constexpr std::uint32_t kSenseBit = 1;
+	static constexpr std::uint32_t kParkedBit = 2;
+
+	explicit SenseBarrier(std::uint32_t threads) : threads_(threads), remaining_(threads) {}
+
+	SenseBarrier(const SenseBarrier&) = delete;
+	SenseBarrier& operator=(const SenseBarrier&) = delete;
+
+	// localSense 는 스레드마다 하나씩, 처음에는 false. 호출마다 뒤집힙니다.
+	void ArriveAndWait(bool& localSense)
+	{
+		localSense = !localSense;
+		const std::uint32_t want = localSense ? kSenseBit : 0;
+		if (remaining_.value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			// 마지막 도착자: 다음 단계를 위해 카운터를 먼저 되돌린 뒤 sense 를 뒤집어 모두를 풉니다.
+			remaining_.value.store(threads_, std::memory_order_relaxed);
+			if (sense_.value.exchange(want, std::memory_order_acq_rel) & kParkedBit)
+				FutexWakeAll(&sense_.value);
+			return;
+		}
+
+		if (SpinThenYield([&] { return (sense_.value.load(std::memory_order_acquire) & kSenseBit) == want; }))
+			return;
+		while (true)
+		{
+			std::uint32_t s = sense_.value.load(std::memory_order_acquire);
+			if ((s & kSenseBit) == want)
+				return;
+			if (!(s & kParkedBit))
+			{
+				if (!sense_.value.compare_exchange_weak(s, s | kParkedBit, std::memory_order_acq_rel))
+					continue;
+				s |= kParkedBit;
+			}
+			FutexWait(&sense_.value, s);
+		}
+	}
+
+	std::uint32_t Threads() const { return threads_; }
+
+private:
+	const std::uint32_t threads_;
+	CacheLinePadded<std::atomic<std::uint32_t>> remaining_;
+	CacheLinePadded<FutexWord> sense_; // 도착 카운터와 다른 라인: 대기자의 반복 load 가 fetch_sub 를 방해하지 않음
+};
+
+// 분산형 dissemination 장벽 (Hensgen, Finkel, Manber)
+//
+//   DisseminationBarrier barrier(n);
+//   std::uint32_t episode = 0;              // 스레드마다
+//   barrier.ArriveAndWait(index, episode);  // index = 0 .. n-1
+//
+// 플래그에는 sense / parity 대신 단조 증가하는 episode 번호를 씁니다.
+// 빠른 이웃이 다음 episode 신호를 먼저 덮어써도 ">= episode" 로 비교하므로 신호를 잃지 않습니다.
+class DisseminationBarrier
+{
+public:
+	explicit DisseminationBarrier(std::uint32_t threads) : threads_(threads)
+	{
+		while ((1u << rounds_) < threads_)
+			++rounds_;
+		flags_ = std::make_unique<CacheLinePadded<FutexWord>[]>(static_cast<std::size_t>(threads_) * (rounds_ > 0 ? rounds_ : 1));
+		for (std::size_t i = 0; i < static_cast<std::size_t>(threads_) * rounds_; ++i)
+			flags_[i].value.store(0, std::memory_order_relaxed);
+	}
+
+	DisseminationBarrier(const DisseminationBarrier&) = delete;
+	DisseminationBarrier& operator=(const DisseminationBarrier&) = delete;
+
+	void ArriveAndWait(std::uint32_t index, std::uint32_t& episode)
+	{
+		++episode;
+		const std::uint32_t tagged = episode << 1; // 최하위 비트는 kParkedBit
+		for (std::uint32_t k = 0; k < rounds_; ++k)
+		{
+			const std::uint32_t partner = (index + (1u << k)) % threads_;
+			FutexWord& out = Flag(partner, k);
+			if (out.exchange(tagged, std::memory_order_acq_rel) & kParkedBit)
+				FutexWakeOne(&out);
+			WaitAtLeast(Flag(index, k), tagged);
+		}
+	}
+
+	std::uint32_t Threads() const { return threads_; }
+	std::uint32_t Rounds() const { return rounds_; }
+
+private:
+	static constexpr std::uint32_t kParkedBit = 1;
+
+	FutexWord& Flag(std::uint32_t thread, std::uint32_t round) { return flags_[static_cast<std::size_t>(thread) * rounds_ + round].value; }
+
+	// 31bit episode 를 wrap-around 까지 고려해 비교 (차이가 2^30 보다 작다고 가정)
+	static bool Reached(std::uint32_t flag, std::uint32_t tagged)
+	{
+		return static_cast<std::int32_t>((flag & ~kParkedBit) - tagged) >= 0;
+	}
+
+	static void WaitAtLeast(FutexWord& flag, std::uint32_t tagged)
+	{
+		if (SpinThenYield([&] { return Reached(flag.load(std::memory_order_acquire), tagged); }))
+			return;
+		while (true)
+		{
+			std::uint32_t f = flag.load(std::memory_order_acquire);
+			if (Reached(f, tagged))
+				return;
+			if (!(f & kParkedBit))
+			{
+				if (!flag.compare_exchange_weak(f, f | kParkedBit, std::memory_order_acq_rel))
+					continue;
+				f |= kParkedBit;
+			}
+			FutexWait(&flag, f);
+		}
+	}
+
+	const std::uint32_t threads_;
+	std::uint32_t rounds_ = 0;
+	std::unique_ptr<CacheLinePadded<FutexWord>[]> flags_;
+};
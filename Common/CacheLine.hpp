@@ -0,0 +1,18 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 캐시 라인 크기
+//
+// std::hardware_destructive_interference_size는 컴파일러/ABI마다 값이 다르고
+// (GCC는 -Winterference-size 경고까지 냅니다) 헤더 간 ABI가 흔들릴 수 있으므로,
+// 랩에서는 x86-64 / ARM64 공통값인 64바이트를 고정으로 사용합니다.
+
+#include <cstddef>
+
+constexpr std::size_t kCacheLineSize = 64;
+
+// 캐시 라인 하나를 통째로 차지하는 값 슬롯 (인접 슬롯과 false sharing 방지)
+template <typename T>
+struct alignas(kCacheLineSize) CacheLinePadded
+{
+	T value{};
+};
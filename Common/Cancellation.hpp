@@ -0,0 +1,207 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 협력적 취소(stop token)와 deadline
+//
+// std::jthread 의 stop_source / stop_token 과 같은 역할에, 작업의 deadline 을 함께 담습니다.
+//
+//   StopSource source;                          // 취소하는 쪽 (메인)
+//   StopToken token = source.Token();           // 취소를 확인하는 쪽 (워커)
+//   while (...) { if (token.StopRequested()) return; ... }
+//   source.RequestStop();
+//
+// 결과 API 와의 연결 (SubmitCancellable)
+// - 작업을 실행기(ThreadPool 등)에 넣을 때 Promise / Future 와 StopSource 를 함께 만듭니다.
+// - 워커가 작업을 꺼낸 시점에 이미 취소됐거나 deadline 이 지났으면, 실행하지 않고 바로 OperationCancelled 로
+//   결과를 채웁니다. (과부하 때 늦은 작업을 버려서(shed) 큐가 계속 쌓이지 않게 함)
+// - 실행 중에는 작업이 token 을 주기적으로 확인하고, 멈춰야 하면 ThrowIfStopRequested() 로 빠져나옵니다.
+// - CancellableFuture::GetFor / GetUntil 이 시간 초과로 끝나면 작업을 취소하므로, 기다리던 쪽이 포기한 작업이
+//   워커를 계속 붙잡지 않습니다.
+//
+// deadline 확인은 NowNs() 한 번이므로(수십 ns) 아주 짧은 루프에서는 몇 번에 한 번만 확인합니다.
+
+#include "Future.hpp"
+#include "Timing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+enum class StopReason
+{
+	None,
+	Cancelled,        // RequestStop()
+	DeadlineExceeded, // deadline 이 지남
+};
+
+inline const char* StopReasonName(StopReason reason)
+{
+	switch (reason)
+	{
+	case StopReason::None:             return "none";
+	case StopReason::Cancelled:        return "cancelled";
+	case StopReason::DeadlineExceeded: return "deadline exceeded";
+	}
+	return "?";
+}
+
+// 취소되거나 deadline 이 지난 작업의 결과 (Future::Get 에서 다시 throw 됨)
+class OperationCancelled : public std::exception
+{
+public:
+	explicit OperationCancelled(StopReason reason) : reason_(reason) {}
+	StopReason Reason() const { return reason_; }
+	const char* what() const noexcept override { return StopReasonName(reason_); }
+
+private:
+	StopReason reason_;
+};
+
+struct StopState
+{
+	static constexpr std::int64_t kNoDeadline = INT64_MAX;
+
+	std::atomic<bool> stopRequested{ false };
+	std::atomic<std::int64_t> deadlineNs{ kNoDeadline }; // NowNs 기준
+};
+
+class StopToken
+{
+public:
+	StopToken() = default; // 취소될 수 없는 토큰
+	explicit StopToken(std::shared_ptr<const StopState> state) : state_(std::move(state)) {}
+
+	StopReason Reason() const
+	{
+		if (!state_)
+			return StopReason::None;
+		if (state_->stopRequested.load(std::memory_order_acquire))
+			return StopReason::Cancelled;
+		const std::int64_t deadline = state_->deadlineNs.load(std::memory_order_relaxed);
+		if (deadline != StopState::kNoDeadline && NowNs() >= deadline)
+			return StopReason::DeadlineExceeded;
+		return StopReason::None;
+	}
+
+	bool StopRequested() const { return Reason() != StopReason::None; }
+
+	void ThrowIfStopRequested() const
+	{
+		const StopReason reason = Reason();
+		if (reason != StopReason::None)
+			throw OperationCancelled(reason);
+	}
+
+	std::int64_t DeadlineNs() const { return state_ ? state_->deadlineNs.load(std::memory_order_relaxed) : StopState::kNoDeadline; }
+
+private:
+	std::shared_ptr<const StopState> state_;
+};
+
+class StopSource
+{
+public:
+	StopSource() : state_(std::make_shared<StopState>()) {}
+
+	StopToken Token() const { return StopToken(state_); }
+
+	// 처음 요청한 호출만 true
+	bool RequestStop() { return !state_->stopRequested.exchange(true, std::memory_order_acq_rel); }
+	bool StopRequested() const { return state_->stopRequested.load(std::memory_order_acquire); }
+
+	void SetDeadlineNs(std::int64_t deadlineNs) { state_->deadlineNs.store(deadlineNs, std::memory_order_relaxed); }
+
+	template <typename Rep, typename Period>
+	void SetTimeout(std::chrono::duration<Rep, Period> timeout)
+	{
+		SetDeadlineNs(NowNs() + std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+	}
+
+private:
+	std::shared_ptr<StopState> state_;
+};
+
+// Future 와 그 작업을 멈출 StopSource 의 묶음
+template <typename T>
+class CancellableFuture
+{
+public:
+	CancellableFuture(Future<T> future, StopSource source) : future_(std::move(future)), source_(std::move(source)) {}
+
+	bool Valid() const { return future_.Valid(); }
+	bool IsReady() const { return future_.IsReady(); }
+
+	// 작업에 멈추라고 알립니다. 결과(OperationCancelled 또는 먼저 끝난 값)는 Get 으로 받습니다.
+	bool Cancel() { return source_.RequestStop(); }
+
+	T Get() { return future_.Get(); }
+
+	// 시간 안에 끝나지 않으면 작업을 취소하고 std::nullopt. (워커는 다음 확인 지점에서 풀려남)
+	template <typename Rep, typename Period>
+	std::optional<T> GetFor(std::chrono::duration<Rep, Period> timeout)
+	{
+		std::optional<T> value = future_.GetFor(timeout);
+		if (!value)
+			Cancel();
+		return value;
+	}
+
+	std::optional<T> GetUntil(LabClock::time_point deadline)
+	{
+		std::optional<T> value = future_.GetUntil(deadline);
+		if (!value)
+			Cancel();
+		return value;
+	}
+
+	Future<T>& Result() { return future_; }
+
+private:
+	Future<T> future_;
+	StopSource source_;
+};
+
+// fn(StopToken) 의 결과 타입. void 는 Unit (ThenResultT / CoResultT 와 같음)
+template <typename F>
+using CancellableResultT = std::conditional_t<std::is_void_v<std::invoke_result_t<std::decay_t<F>&, const StopToken&>>, Unit,
+	std::invoke_result_t<std::decay_t<F>&, const StopToken&>>;
+
+// executor.Submit(std::function<void()>) 로 fn(StopToken) 을 실행합니다.
+// deadlineNs 가 있으면 워커가 꺼낸 시점에 이미 지난 작업은 실행하지 않습니다. (shed)
+// fn 이 void 를 반환하면 CancellableFuture<Unit> 이 됩니다.
+template <typename Executor, typename F>
+auto SubmitCancellable(Executor& executor, F&& fn, std::int64_t deadlineNs = StopState::kNoDeadline)
+	-> CancellableFuture<CancellableResultT<F>>
+{
+	using T = CancellableResultT<F>;
+	using R = std::invoke_result_t<std::decay_t<F>&, const StopToken&>;
+	StopSource source;
+	source.SetDeadlineNs(deadlineNs);
+	auto promise = std::make_shared<Promise<T>>();
+	Future<T> future = promise->GetFuture();
+
+	executor.Submit([promise, token = source.Token(), f = std::forward<F>(fn)]() mutable {
+		try
+		{
+			token.ThrowIfStopRequested(); // 시작 전에 확인: 늦은 작업은 워커를 쓰지 않고 버림
+			if constexpr (std::is_void_v<R>)
+			{
+				f(token);
+				promise->SetValue(Unit{});
+			}
+			else
+			{
+				promise->SetValue(f(token));
+			}
+		}
+		catch (...)
+		{
+			promise->SetException(std::current_exception());
+		}
+	});
+	return CancellableFuture<T>(std::move(future), std::move(source));
+}
@@ -0,0 +1,510 @@
+#pragma once
+
+// ThreadLab 공용 코어 - C++20 코루틴 (Task<T>, 스케줄러, 타이머, 일시정지 게이트)
+//
+// 스레드 버전의 워커는 sleep_for / cv.wait 동안 OS 스레드 하나(스택 수 MB 예약)를 통째로 붙잡습니다.
+// 코루틴 버전은 기다리는 동안 프레임(수백 B)만 남기고 스레드를 내주므로,
+// 워커 수천 개를 작은 고정 풀(CoScheduler) 위에 다중화할 수 있습니다.
+//
+//   CoScheduler scheduler(2);                      // OS 스레드 2개
+//   CoGate gate(scheduler);
+//
+//   Task<void> TickTock(CoScheduler& s, CoGate& gate)
+//   {
+//       while (co_await gate.Pass())               // 일시정지면 여기서 멈춤 (스레드는 다른 코루틴 실행)
+//           co_await s.SleepFor(std::chrono::seconds(1)); // sleep_for 대신 타이머에 등록하고 내려놓음
+//   }
+//
+//   Spawn(scheduler, TickTock(scheduler, gate));   // 결과 없이 실행 (예외는 std::thread 처럼 terminate)
+//   Future<long long> f = StartOn(scheduler, SumTask(n)); // 결과 / 예외를 Future 로 받음
+//
+// 구성
+// - Task<T>     : 지연 시작(lazy) 코루틴. co_await 하면 시작하고, 끝나면 기다리던 코루틴을 바로 이어서 실행합니다.
+//                 (symmetric transfer: 재귀적으로 resume 하지 않으므로 체인이 길어도 스택이 자라지 않음)
+// - CoScheduler : 준비 큐(deque) + 타이머 힙(deadline 순) + mutex 하나 + condition_variable 하나.
+//                 워커는 준비된 코루틴을 resume 하고, 할 일이 없으면 가장 이른 deadline 까지 wait_until 합니다.
+// - CoGate      : RunGate 의 코루틴 버전. 실행 중이면 atomic load 한 번으로 통과하고,
+//                 일시정지 중에는 대기 목록에 넣어 두었다가 Resume / RequestExit 때 한꺼번에 준비 큐로 옮깁니다.
+//
+// 규칙
+// - 스케줄러를 파괴하기 전에 Spawn / StartOn 한 코루틴이 모두 끝나야 합니다. (타이머에 남은 코루틴은 resume 되지 않음)
+// - 프레임 할당량은 CoFrames() 로 셉니다. (코루틴 하나당 메모리 측정용)
+
+#include "Future.hpp"
+#include "ThreadAttributes.hpp"
+#include "ThreadPool.hpp" // ThreadPool::DefaultThreadCount
+#include "Timing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 살아 있는 코루틴 프레임 수 / 바이트 (Task 와 Spawn / StartOn 의 래퍼 프레임 포함)
+struct CoFrameStats
+{
+	std::atomic<long long> frames{ 0 };
+	std::atomic<long long> bytes{ 0 };
+};
+
+inline CoFrameStats& CoFrames()
+{
+	static CoFrameStats stats;
+	return stats;
+}
+
+// promise_type 이 상속하면 코루틴 프레임 할당이 이 operator new / delete 로 옵니다.
+struct CoFrameAllocation
+{
+	static void* operator new(std::size_t size)
+	{
+		CoFrames().frames.fetch_add(1, std::memory_order_relaxed);
+		CoFrames().bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+		return ::operator new(size);
+	}
+
+	static void operator delete(void* p, std::size_t size) noexcept
+	{
+		CoFrames().frames.fetch_sub(1, std::memory_order_relaxed);
+		CoFrames().bytes.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+		::operator delete(p);
+	}
+};
+
+class CoScheduler
+{
+public:
+	explicit CoScheduler(unsigned threadCount = ThreadPool::DefaultThreadCount(), const ThreadAttributes& attrs = ThreadAttributes())
+		: attrs_(attrs)
+	{
+		if (threadCount == 0)
+			threadCount = 1;
+		workers_.reserve(threadCount);
+		for (unsigned i = 0; i < threadCount; ++i)
+			workers_.emplace_back(&CoScheduler::WorkerLoop, this, i);
+	}
+
+	~CoScheduler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+		for (auto& worker : workers_)
+			worker.join();
+	}
+
+	CoScheduler(const CoScheduler&) = delete;
+	CoScheduler& operator=(const CoScheduler&) = delete;
+
+	unsigned Size() const { return static_cast<unsigned>(workers_.size()); }
+
+	void Schedule(std::coroutine_handle<> handle)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			ready_.push_back(handle);
+		}
+		wake_.notify_one();
+	}
+
+	// 여러 개를 한 번의 lock 으로 넣습니다. (게이트 Resume 처럼 한꺼번에 깨울 때)
+	void Schedule(const std::vector<std::coroutine_handle<>>& handles)
+	{
+		if (handles.empty())
+			return;
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			ready_.insert(ready_.end(), handles.begin(), handles.end());
+		}
+		wake_.notify_all();
+	}
+
+	// deadlineNs (NowNs 기준) 가 되면 handle 을 준비 큐로 옮깁니다.
+	void ScheduleAtNs(std::int64_t deadlineNs, std::coroutine_handle<> handle)
+	{
+		bool earliest = false;
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			earliest = timers_.empty() || deadlineNs < timers_.top().deadlineNs;
+			timers_.push({ deadlineNs, handle });
+		}
+		// 가장 이른 deadline 이 바뀌었을 때만 잠든 워커가 기다릴 시각을 다시 계산하게 합니다.
+		if (earliest)
+			wake_.notify_one();
+	}
+
+	// co_await scheduler.Enter() : 이 코루틴을 풀의 워커로 옮겨 이어서 실행
+	struct EnterAwaiter
+	{
+		CoScheduler& scheduler;
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { scheduler.Schedule(handle); }
+		void await_resume() const noexcept {}
+	};
+
+	// co_await scheduler.SleepFor(d) : 스레드를 재우지 않고 타이머에 등록한 뒤 내려놓음
+	struct SleepAwaiter
+	{
+		CoScheduler& scheduler;
+		std::int64_t deadlineNs;
+		bool await_ready() const { return NowNs() >= deadlineNs; }
+		void await_suspend(std::coroutine_handle<> handle) { scheduler.ScheduleAtNs(deadlineNs, handle); }
+		void await_resume() const noexcept {}
+	};
+
+	EnterAwaiter Enter() { return EnterAwaiter{ *this }; }
+
+	SleepAwaiter SleepUntilNs(std::int64_t deadlineNs) { return SleepAwaiter{ *this, deadlineNs }; }
+
+	template <typename Rep, typename Period>
+	SleepAwaiter SleepFor(std::chrono::duration<Rep, Period> duration)
+	{
+		return SleepUntilNs(NowNs() + std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+	}
+
+private:
+	struct Timer
+	{
+		std::int64_t deadlineNs;
+		std::coroutine_handle<> handle;
+		bool operator>(const Timer& other) const { return deadlineNs > other.deadlineNs; }
+	};
+
+	void WorkerLoop(unsigned index)
+	{
+		ApplyThreadAttributes(attrs_, index);
+		std::unique_lock<std::mutex> lock(m_);
+		while (true)
+		{
+			if (!timers_.empty())
+			{
+				const std::int64_t now = NowNs();
+				while (!timers_.empty() && timers_.top().deadlineNs <= now)
+				{
+					ready_.push_back(timers_.top().handle);
+					timers_.pop();
+				}
+			}
+
+			if (!ready_.empty())
+			{
+				const std::coroutine_handle<> handle = ready_.front();
+				ready_.pop_front();
+				const bool more = !ready_.empty();
+				lock.unlock();
+				// 준비된 코루틴이 더 있으면 잠든 워커를 하나 더 깨워 나눠 실행합니다.
+				if (more)
+					wake_.notify_one();
+				handle.resume();
+				lock.lock();
+				continue;
+			}
+
+			// 종료 요청이 와도 준비 큐에 남은 코루틴은 끝까지 실행합니다.
+			if (stopping_)
+				return;
+			if (timers_.empty())
+				wake_.wait(lock);
+			else
+				wake_.wait_until(lock, LabClock::time_point(std::chrono::duration_cast<LabClock::duration>(
+					std::chrono::nanoseconds(timers_.top().deadlineNs))));
+		}
+	}
+
+	std::mutex m_;
+	std::condition_variable wake_;
+	std::deque<std::coroutine_handle<>> ready_;
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+	bool stopping_ = false;
+	const ThreadAttributes attrs_;
+	std::vector<std::thread> workers_;
+};
+
+template <typename T = void>
+class Task;
+
+struct TaskPromiseBase : CoFrameAllocation
+{
+	// 끝나면 기다리던 코루틴으로 바로 넘어갑니다. (없으면 noop: resume 한 쪽으로 돌아감)
+	struct FinalAwaiter
+	{
+		bool await_ready() const noexcept { return false; }
+
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+		{
+			return handle.promise().continuation;
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	std::suspend_always initial_suspend() const noexcept { return {}; }
+	FinalAwaiter final_suspend() const noexcept { return {}; }
+	void unhandled_exception() noexcept { error = std::current_exception(); }
+
+	std::coroutine_handle<> continuation = std::noop_coroutine();
+	std::exception_ptr error;
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase
+{
+	Task<T> get_return_object() noexcept;
+	void return_value(T v) { value.emplace(std::move(v)); }
+
+	T TakeResult()
+	{
+		if (error)
+			std::rethrow_exception(error);
+		return std::move(*value);
+	}
+
+	std::optional<T> value;
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase
+{
+	Task<void> get_return_object() noexcept;
+	void return_void() const noexcept {}
+
+	void TakeResult() const
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+};
+
+// 지연 시작 코루틴. co_await 로 시작해 결과(또는 예외)를 받습니다. Task 가 파괴되면 프레임도 해제됩니다.
+template <typename T>
+class Task
+{
+public:
+	using promise_type = TaskPromise<T>;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	Task() = default;
+	explicit Task(Handle handle) : handle_(handle) {}
+
+	Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+	Task& operator=(Task&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (handle_)
+				handle_.destroy();
+			handle_ = std::exchange(other.handle_, {});
+		}
+		return *this;
+	}
+
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	~Task()
+	{
+		if (handle_)
+			handle_.destroy();
+	}
+
+	bool Valid() const { return static_cast<bool>(handle_); }
+	bool Done() const { return handle_ && handle_.done(); }
+
+	bool await_ready() const noexcept { return handle_.done(); }
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+	{
+		handle_.promise().continuation = awaiting;
+		return handle_;
+	}
+
+	T await_resume() { return handle_.promise().TakeResult(); }
+
+private:
+	Handle handle_;
+};
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+	return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+	return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// 누구도 기다리지 않는 최상위 코루틴 (끝나면 프레임이 스스로 해제됨)
+struct DetachedCoroutine
+{
+	struct promise_type : CoFrameAllocation
+	{
+		DetachedCoroutine get_return_object() const noexcept { return {}; }
+		std::suspend_never initial_suspend() const noexcept { return {}; }
+		std::suspend_never final_suspend() const noexcept { return {}; }
+		void return_void() const noexcept {}
+		void unhandled_exception() const noexcept { std::terminate(); }
+	};
+};
+
+// GCC 12 는 인라인된 Spawn / RunToPromise 의 프레임 해제 경로에서 CoFrameAllocation 의 operator new / delete 를
+// 짝이 맞지 않는다고 잘못 판단합니다. (-Wmismatched-new-delete, 두 함수 모두 같은 클래스의 멤버)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// task 를 스케줄러 워커에서 실행합니다. 예외가 빠져나오면 std::thread 처럼 terminate 합니다.
+inline DetachedCoroutine Spawn(CoScheduler& scheduler, Task<void> task)
+{
+	co_await scheduler.Enter();
+	co_await task;
+}
+
+template <typename T>
+using CoResultT = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+template <typename T>
+DetachedCoroutine RunToPromise(CoScheduler& scheduler, Task<T> task, Promise<CoResultT<T>> promise)
+{
+	co_await scheduler.Enter();
+	std::exception_ptr error;
+	try
+	{
+		if constexpr (std::is_void_v<T>)
+		{
+			co_await task;
+			promise.SetValue(Unit{});
+		}
+		else
+		{
+			promise.SetValue(co_await task);
+		}
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	if (error)
+	{
+		// 예외 객체를 붙잡고 있는 Task 프레임과 catch 블록을 먼저 정리한 뒤에 알립니다.
+		// (기다리던 쪽이 깨어난 뒤에 이 스레드가 예외의 참조 수를 건드리지 않도록)
+		task = Task<T>();
+		promise.SetException(std::move(error));
+	}
+}
+
+// task 를 스케줄러 워커에서 실행하고 결과 / 예외를 Future 로 돌려줍니다. (void 는 Future<Unit>)
+template <typename T>
+Future<CoResultT<T>> StartOn(CoScheduler& scheduler, Task<T> task)
+{
+	Promise<CoResultT<T>> promise;
+	Future<CoResultT<T>> future = promise.GetFuture();
+	RunToPromise(scheduler, std::move(task), std::move(promise));
+	return future;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// 코루틴이 아닌 곳(main 등)에서 task 가 끝날 때까지 기다립니다.
+template <typename T>
+CoResultT<T> SyncWait(CoScheduler& scheduler, Task<T> task)
+{
+	return StartOn(scheduler, std::move(task)).Get();
+}
+
+// RunGate 의 코루틴 버전: co_await gate.Pass() 가 실행 중이면 true, 종료 요청이면 false.
+// 일시정지 중이면 스레드를 막지 않고 코루틴만 멈춰 두었다가 Resume 때 스케줄러에서 이어 실행합니다.
+class CoGate
+{
+public:
+	static constexpr std::uint32_t kRunning = 0;
+	static constexpr std::uint32_t kPaused = 1;
+	static constexpr std::uint32_t kExit = 2;
+
+	explicit CoGate(CoScheduler& scheduler, bool startPaused = false)
+		: scheduler_(scheduler), state_(startPaused ? kPaused : kRunning) {}
+
+	CoGate(const CoGate&) = delete;
+	CoGate& operator=(const CoGate&) = delete;
+
+	struct PassAwaiter
+	{
+		CoGate& gate;
+		bool await_ready() const noexcept { return gate.state_.load(std::memory_order_acquire) == kRunning; }
+		bool await_suspend(std::coroutine_handle<> handle) { return gate.Park(handle); }
+		bool await_resume() const noexcept { return gate.state_.load(std::memory_order_acquire) != kExit; }
+	};
+
+	PassAwaiter Pass() { return PassAwaiter{ *this }; }
+
+	void Pause()
+	{
+		std::lock_guard<std::mutex> lock(m_);
+		if (state_.load(std::memory_order_relaxed) == kRunning)
+			state_.store(kPaused, std::memory_order_release);
+	}
+
+	void Resume() { Release(kRunning); }
+
+	// 종료는 별도 상태: 이후의 Pause / Resume 으로 되돌릴 수 없습니다.
+	void RequestExit() { Release(kExit); }
+
+	bool IsPaused() const { return state_.load(std::memory_order_acquire) == kPaused; }
+
+	// 게이트에서 멈춰 있는 코루틴 수 - 측정용
+	std::size_t Waiters() const
+	{
+		std::lock_guard<std::mutex> lock(m_);
+		return waiters_.size();
+	}
+
+private:
+	// 상태 확인과 대기 목록 추가를 같은 lock 안에서 해야, 그 사이의 Resume 을 놓치지 않습니다.
+	bool Park(std::coroutine_handle<> handle)
+	{
+		std::lock_guard<std::mutex> lock(m_);
+		if (state_.load(std::memory_order_relaxed) != kPaused)
+			return false; // 그 사이에 풀렸으면 멈추지 않고 이어서 실행
+		waiters_.push_back(handle);
+		return true;
+	}
+
+	void Release(std::uint32_t next)
+	{
+		std::vector<std::coroutine_handle<>> woken;
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			const std::uint32_t s = state_.load(std::memory_order_relaxed);
+			if (s == kExit || s == next)
+				return;
+			state_.store(next, std::memory_order_release);
+			woken.swap(waiters_);
+		}
+		scheduler_.Schedule(woken);
+	}
+
+	CoScheduler& scheduler_;
+	std::atomic<std::uint32_t> state_;
+	mutable std::mutex m_;
+	std::vector<std::coroutine_handle<>> waiters_;
+};
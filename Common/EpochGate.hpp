@@ -0,0 +1,138 @@
+#pragma once
+
+// ThreadLab 공용 코어 - EpochGate (N 워커 일괄 Pause / Resume + 확인 장벽)
+//
+// RunGate 는 Pause 를 "요청"만 합니다. 워커 수백 개를 멈출 때 컨트롤러는 모두가 실제로 멈췄는지 알 수 없고,
+// condition_variable::notify_all 로 풀면 깨어난 워커가 모두 같은 mutex 를 다시 잡으려고 몰립니다(wake storm).
+//
+// EpochGate
+// - 상태 워드 하나에 세대(epoch) 번호를 둡니다. 짝수 = 실행, 홀수 = 일시정지, 최상위 비트 = 종료
+// - 컨트롤러의 Pause / Resume 은 epoch 를 하나 올려 방송(broadcast)하고, 워커 N개가 모두 새 epoch 를
+//   확인(ack)할 때까지 기다렸다가 돌아옵니다. Pause() 가 돌아오면 모든 워커가 게이트 안에 멈춰 있습니다.
+// - 워커는 자신이 마지막으로 본 epoch 를 들고 다닙니다. 실행 중이고 epoch 가 그대로면 atomic load 한 번으로 통과
+// - 일시정지 epoch 를 보면 ack 한 뒤 그 워드 값으로 futex 에서 잠듭니다. Resume 의 FutexWakeAll 에는 mutex 가 없으므로
+//   깨어난 워커가 서로를 기다리지 않고 각자 ack 만 하고 진행합니다.
+// - ack 카운터가 N 이 되는 마지막 워커만 컨트롤러를 깨웁니다.
+//
+//   EpochGate gate(workers);
+//   // 워커                                   // 컨트롤러 (한 스레드)
+//   std::uint32_t seen = gate.Start();         gate.Pause();   // 모두 멈출 때까지 대기
+//   while (gate.Pass(seen)) Work();            gate.Resume();  // 모두 다시 돌 때까지 대기
+//
+// 제약: 워커 N개가 모두 RequestExit 전까지 Pass 를 계속 호출해야 합니다. (한 워커가 오래 Pass 에 오지 않으면
+// 그동안 Pause / Resume 이 기다립니다) Pause / Resume / RequestExit 은 한 컨트롤러 스레드에서만 호출합니다.
+
+#include "Futex.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+class EpochGate
+{
+public:
+	static constexpr std::uint32_t kExitBit = 0x80000000u;
+	static constexpr std::uint32_t kEpochMask = kExitBit - 1;
+
+	explicit EpochGate(unsigned workers) : workers_(workers) {}
+
+	EpochGate(const EpochGate&) = delete;
+	EpochGate& operator=(const EpochGate&) = delete;
+
+	// 워커가 처음 Pass 전에 받아 두는 epoch
+	// 늦게 시작한 워커도 항상 0 에서 출발합니다. 첫 전환은 모든 워커의 ack 없이 끝나지 않으므로,
+	// 워커가 아직 보지 못한 epoch 는 많아야 하나이고 첫 Pass 에서 그 epoch 를 ack 합니다.
+	static constexpr std::uint32_t Start() { return 0; }
+
+	// 워커가 반복마다 호출: 실행 중이면 true, 종료 요청이면 false. 일시정지 중이면 ack 한 뒤 풀릴 때까지 잠듭니다.
+	bool Pass(std::uint32_t& seen)
+	{
+		const std::uint32_t w = word_.load(std::memory_order_acquire);
+		if (w == seen && (w & 1) == 0)
+			return true;
+		return PassSlow(seen, w);
+	}
+
+	// 모든 워커가 게이트 안에서 멈출 때까지 기다린 뒤 돌아옵니다. 이미 멈춰 있으면 바로 돌아옴
+	void Pause()
+	{
+		if (!IsPaused())
+			Advance();
+	}
+
+	// 모든 워커가 깨어나 다시 실행 epoch 를 확인할 때까지 기다린 뒤 돌아옵니다.
+	void Resume()
+	{
+		if (IsPaused())
+			Advance();
+	}
+
+	// 확인을 기다리지 않습니다. 이후의 Pause / Resume 은 아무 일도 하지 않습니다.
+	void RequestExit()
+	{
+		word_.fetch_or(kExitBit, std::memory_order_acq_rel);
+		FutexWakeAll(&word_);
+	}
+
+	bool IsPaused() const
+	{
+		const std::uint32_t w = word_.load(std::memory_order_acquire);
+		return (w & kExitBit) == 0 && (w & 1) != 0;
+	}
+
+	unsigned Workers() const { return workers_; }
+
+private:
+	bool PassSlow(std::uint32_t& seen, std::uint32_t w)
+	{
+		while (true)
+		{
+			if (w & kExitBit)
+				return false;
+			if (w != seen)
+			{
+				seen = w;
+				Ack();
+			}
+			if ((w & 1) == 0)
+				return true;
+			// 그 사이 epoch 가 바뀌었으면 커널이 바로 돌려보냅니다. (spurious wakeup 도 루프에서 다시 검사)
+			FutexWait(&word_, w);
+			w = word_.load(std::memory_order_acquire);
+		}
+	}
+
+	void Ack()
+	{
+		if (acks_.fetch_add(1, std::memory_order_acq_rel) + 1 == workers_)
+			FutexWakeAll(&acks_);
+	}
+
+	// epoch 를 하나 올리고 (짝수 <-> 홀수) 워커 N개의 ack 를 기다립니다.
+	void Advance()
+	{
+		// 이전 전환의 ack 는 모두 끝났으므로 카운터를 먼저 비워도 섞이지 않습니다.
+		acks_.store(0, std::memory_order_relaxed);
+		std::uint32_t w = word_.load(std::memory_order_relaxed);
+		if (w & kExitBit)
+			return;
+		while (!word_.compare_exchange_weak(w, (w + 1) & kEpochMask, std::memory_order_acq_rel))
+		{
+			if (w & kExitBit)
+				return;
+		}
+		// 일시정지 epoch 에는 잠든 워커가 없지만(모두 실행 중), 실행 epoch 로 바꿀 때는 모두 잠들어 있습니다.
+		if ((w & 1) != 0)
+			FutexWakeAll(&word_);
+
+		std::uint32_t acked = acks_.load(std::memory_order_acquire);
+		while (acked < workers_)
+		{
+			FutexWait(&acks_, acked);
+			acked = acks_.load(std::memory_order_acquire);
+		}
+	}
+
+	FutexWord word_{ 0 };
+	FutexWord acks_{ 0 };
+	const unsigned workers_;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 주소 기반 대기 (futex / WaitOnAddress)
+//
+// 32bit atomic 워드의 값이 expected 인 동안만 잠들고, 다른 스레드가 값을 바꾼 뒤 Wake 로 깨웁니다.
+// - Linux  : futex(FUTEX_WAIT_PRIVATE / FUTEX_WAKE_PRIVATE)
+// - Windows: WaitOnAddress / WakeByAddressSingle / WakeByAddressAll (Synchronization.lib)
+// - 그 외  : std::atomic::wait / notify_one / notify_all
+//
+// FutexWaitFor 는 시간 제한이 있는 대기입니다. (Get 의 deadline, 취소 가능한 대기 등)
+//
+// 잠들기 직전에 값을 커널이 다시 비교하므로 "검사 후 잠들기" 사이에 바뀐 값을 놓치지 않습니다.
+// 대신 spurious wakeup 이 있을 수 있으므로 호출하는 쪽은 항상 루프에서 값을 다시 검사해야 합니다.
+
+#include "Platform.hpp"
+
+#if defined(_WIN32)
+#pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <cerrno>
+#include <ctime>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+using FutexWord = std::atomic<std::uint32_t>;
+
+// futex / WaitOnAddress 는 워드의 주소를 그대로 사용하므로 lock-free 32bit 여야 합니다.
+static_assert(FutexWord::is_always_lock_free, "futex word needs a lock-free 32-bit atomic");
+static_assert(sizeof(FutexWord) == sizeof(std::uint32_t), "futex word must be a plain 32-bit word");
+
+inline void FutexWait(FutexWord* word, std::uint32_t expected)
+{
+#if defined(_WIN32)
+	::WaitOnAddress(word, &expected, sizeof(expected), INFINITE);
+#elif defined(__linux__)
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+	word->wait(expected, std::memory_order_acquire);
+#endif
+}
+
+// FutexWait 와 같지만 timeoutNs 가 지나면 돌아옵니다. 시간 초과면 false
+// (깨어났거나 값이 이미 달랐거나 spurious wakeup 이면 true. 호출하는 쪽은 값과 남은 시간을 다시 검사합니다)
+inline bool FutexWaitFor(FutexWord* word, std::uint32_t expected, std::int64_t timeoutNs)
+{
+	if (timeoutNs <= 0)
+		return false;
+#if defined(_WIN32)
+	const DWORD ms = static_cast<DWORD>((timeoutNs + 999999) / 1000000); // 올림: 0ms 로 바쁜 대기가 되지 않도록
+	if (::WaitOnAddress(word, &expected, sizeof(expected), ms))
+		return true;
+	return ::GetLastError() != ERROR_TIMEOUT;
+#elif defined(__linux__)
+	timespec ts;
+	ts.tv_sec = static_cast<time_t>(timeoutNs / 1000000000);
+	ts.tv_nsec = static_cast<long>(timeoutNs % 1000000000);
+	const long rc = ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+	return !(rc == -1 && errno == ETIMEDOUT);
+#else
+	// std::atomic::wait 에는 시간 제한이 없으므로 짧게 자며 다시 봅니다.
+	if (word->load(std::memory_order_acquire) != expected)
+		return true;
+	std::this_thread::sleep_for(std::chrono::nanoseconds(std::min<std::int64_t>(timeoutNs, 1000000)));
+	return true;
+#endif
+}
+
+inline void FutexWakeOne(FutexWord* word)
+{
+#if defined(_WIN32)
+	::WakeByAddressSingle(word);
+#elif defined(__linux__)
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+	word->notify_one();
+#endif
+}
+
+inline void FutexWakeAll(FutexWord* word)
+{
+#if defined(_WIN32)
+	::WakeByAddressAll(word);
+#elif defined(__linux__)
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+	word->notify_all();
+#endif
+}
@@ -0,0 +1,459 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 가벼운 Future / Promise
+//
+// std::promise / std::future 와 같은 역할이지만 shared state 를 직접 구현합니다.
+//
+// Shared state
+// - 상태는 atomic 32비트 워드 하나의 비트로 관리합니다. (mutex / condition_variable 없음)
+//   - kReady           : 값 또는 예외가 채워짐
+//   - kHasContinuation : Then() 으로 후속 작업이 등록됨
+//   - kWaiting         : 누군가 잠들어서(park) 기다리는 중 -> 이때만 notify 합니다.
+// - 값/예외를 먼저 기록하고 마지막에 kReady 를 세우므로(release), kReady 를 본 쪽은(acquire) 완성된 결과만 봅니다.
+//
+// 대기 (spin-then-park)
+// - 결과가 곧 올 가능성이 높으므로 먼저 짧게 스핀(CpuRelax)하고, (코어가 하나면 스핀 생략)
+//   그래도 준비되지 않으면 kWaiting 을 세운 뒤 상태 워드에서 잠듭니다. (Futex.hpp: Linux futex, Windows WaitOnAddress)
+// - WaitFor / WaitUntil / GetFor / GetUntil 은 deadline 이 지나면 결과 없이 돌아옵니다. (Future 는 그대로 유효)
+//
+// 후속 작업 (Then)
+// - Then(f)     : 결과가 채워지는 스레드에서 바로 f 실행 (이미 준비돼 있으면 Then 을 호출한 스레드에서 실행)
+// - Then(ex, f) : ex.Submit(...) 으로 실행기(예: ThreadPool)에 넘겨 실행
+// - 원본이 예외로 끝나면 f 는 호출되지 않고 예외가 그대로 다음 Future 로 전파됩니다.
+// - f 가 void 를 반환하면 Future<Unit> 이 됩니다.
+//
+// 조합
+// - WhenAll(futures) : 모두 끝나면 결과 vector, 하나라도 예외면 첫 번째 예외
+// - WhenAny(futures) : 가장 먼저 끝난 것의 {index, 값} (또는 그 예외)
+//
+// std::promise 와 같은 규칙
+// - Get() 은 한 번만 호출할 수 있습니다. (호출 후 Valid() == false)
+// - 값을 채우지 않고 Promise 가 소멸하면 future_error(broken_promise) 가 전달됩니다.
+
+#include "Futex.hpp"
+#include "Platform.hpp" // CpuRelax, SpinWaitUseful
+#include "Timing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future> // std::future_error
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// void 결과를 값처럼 다루기 위한 빈 타입
+struct Unit
+{
+};
+
+template <typename T>
+class FutureState
+{
+public:
+	static constexpr std::uint32_t kReady = 1u << 0;
+	static constexpr std::uint32_t kHasContinuation = 1u << 1;
+	static constexpr std::uint32_t kWaiting = 1u << 2;
+
+	// 스핀 횟수: futex 로 잠들었다 깨는 비용(수 us)보다 짧은 구간만 스핀합니다.
+	static constexpr int kSpinCount = 128;
+	static constexpr std::int64_t kNoDeadline = INT64_MAX;
+
+	bool IsReady() const { return (state_.load(std::memory_order_acquire) & kReady) != 0; }
+
+	template <typename... Args>
+	void SetValue(Args&&... args)
+	{
+		value_.emplace(std::forward<Args>(args)...);
+		Publish();
+	}
+
+	void SetException(std::exception_ptr error)
+	{
+		error_ = std::move(error);
+		Publish();
+	}
+
+	void Wait() { WaitUntilNs(kNoDeadline); }
+
+	// deadlineNs (NowNs 기준) 까지 기다립니다. 준비되면 true, 시간이 지나면 false
+	bool WaitUntilNs(std::int64_t deadlineNs)
+	{
+		const int spins = SpinWaitUseful() ? kSpinCount : 0;
+		for (int i = 0; i < spins; ++i)
+		{
+			if (IsReady())
+				return true;
+			CpuRelax();
+		}
+
+		std::uint32_t s = state_.load(std::memory_order_acquire);
+		while ((s & kReady) == 0)
+		{
+			if ((s & kWaiting) == 0)
+			{
+				if (!state_.compare_exchange_weak(s, s | kWaiting, std::memory_order_acq_rel, std::memory_order_acquire))
+					continue;
+				s |= kWaiting;
+			}
+			if (deadlineNs == kNoDeadline)
+			{
+				FutexWait(&state_, s);
+			}
+			else
+			{
+				const std::int64_t remaining = deadlineNs - NowNs();
+				if (remaining <= 0 || !FutexWaitFor(&state_, s, remaining))
+					return IsReady();
+			}
+			s = state_.load(std::memory_order_acquire);
+		}
+		return true;
+	}
+
+	// Wait() 이후 또는 준비된 것을 확인한 뒤에만 호출합니다.
+	T Take()
+	{
+		if (error_)
+			std::rethrow_exception(error_);
+		return std::move(*value_);
+	}
+
+	std::exception_ptr Error() const { return error_; }
+
+	// 결과가 이미 있으면 호출한 스레드에서 바로 실행합니다. (등록은 한 번만)
+	void SetContinuation(std::function<void()> fn)
+	{
+		continuation_ = std::move(fn);
+		const std::uint32_t old = state_.fetch_or(kHasContinuation, std::memory_order_acq_rel);
+		if (old & kReady)
+			RunContinuation();
+	}
+
+private:
+	void Publish()
+	{
+		const std::uint32_t old = state_.fetch_or(kReady, std::memory_order_acq_rel);
+		if (old & kWaiting)
+			FutexWakeAll(&state_);
+		if (old & kHasContinuation)
+			RunContinuation();
+	}
+
+	void RunContinuation()
+	{
+		// 후속 작업이 이 state 를 소유(shared_ptr)하고 있을 수 있으므로, 먼저 꺼내서 순환 참조를 끊습니다.
+		std::function<void()> fn = std::move(continuation_);
+		fn();
+	}
+
+	FutexWord state_{ 0 };
+	std::optional<T> value_;
+	std::exception_ptr error_;
+	std::function<void()> continuation_;
+};
+
+template <typename T>
+class Future;
+
+template <typename F, typename T>
+using ThenResultT = std::conditional_t<std::is_void_v<std::invoke_result_t<F&, T>>, Unit, std::invoke_result_t<F&, T>>;
+
+// src 의 결과로 fn 을 실행해서 next 를 채웁니다. src 가 예외면 fn 없이 예외만 전달합니다.
+template <typename T, typename U, typename F>
+void RunThen(FutureState<T>& src, FutureState<U>& next, F& fn)
+{
+	try
+	{
+		if constexpr (std::is_void_v<std::invoke_result_t<F&, T>>)
+		{
+			fn(src.Take());
+			next.SetValue(Unit{});
+		}
+		else
+		{
+			next.SetValue(fn(src.Take()));
+		}
+	}
+	catch (...)
+	{
+		next.SetException(std::current_exception());
+	}
+}
+
+template <typename T>
+class Future
+{
+public:
+	Future() = default;
+	explicit Future(std::shared_ptr<FutureState<T>> state) : state_(std::move(state)) {}
+
+	bool Valid() const { return state_ != nullptr; }
+	bool IsReady() const { return state_ && state_->IsReady(); }
+
+	void Wait() const { state_->Wait(); }
+
+	// 결과가 준비되면 true, deadline 이 먼저 오면 false
+	template <typename Rep, typename Period>
+	bool WaitFor(std::chrono::duration<Rep, Period> timeout) const
+	{
+		return state_->WaitUntilNs(NowNs() + std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+	}
+
+	bool WaitUntil(LabClock::time_point deadline) const
+	{
+		return state_->WaitUntilNs(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count());
+	}
+
+	// 결과가 준비될 때까지 기다린 뒤 값을 꺼냅니다. 예외가 저장돼 있으면 다시 throw 합니다.
+	T Get()
+	{
+		std::shared_ptr<FutureState<T>> state = std::move(state_);
+		state->Wait();
+		return state->Take();
+	}
+
+	// Get 과 같지만 timeout 이 지나면 std::nullopt 를 돌려주고, Future 는 유효한 채로 남습니다. (다시 기다릴 수 있음)
+	template <typename Rep, typename Period>
+	std::optional<T> GetFor(std::chrono::duration<Rep, Period> timeout)
+	{
+		if (!WaitFor(timeout))
+			return std::nullopt;
+		return Get();
+	}
+
+	std::optional<T> GetUntil(LabClock::time_point deadline)
+	{
+		if (!WaitUntil(deadline))
+			return std::nullopt;
+		return Get();
+	}
+
+	// 인라인 후속 작업. 이 Future 는 무효가 됩니다.
+	template <typename F>
+	Future<ThenResultT<F, T>> Then(F&& fn)
+	{
+		using U = ThenResultT<F, T>;
+		auto next = std::make_shared<FutureState<U>>();
+		std::shared_ptr<FutureState<T>> src = std::move(state_);
+		FutureState<T>* raw = src.get();
+		raw->SetContinuation([src, next, f = std::forward<F>(fn)]() mutable { RunThen(*src, *next, f); });
+		return Future<U>(next);
+	}
+
+	// 실행기(Submit(std::function<void()>) 를 가진 타입, 예: ThreadPool)에서 실행하는 후속 작업
+	template <typename Executor, typename F>
+	Future<ThenResultT<F, T>> Then(Executor& executor, F&& fn)
+	{
+		using U = ThenResultT<F, T>;
+		auto next = std::make_shared<FutureState<U>>();
+		std::shared_ptr<FutureState<T>> src = std::move(state_);
+		FutureState<T>* raw = src.get();
+		auto shared = std::make_shared<std::decay_t<F>>(std::forward<F>(fn));
+		raw->SetContinuation([&executor, src, next, shared]() {
+			executor.Submit([src, next, shared]() { RunThen(*src, *next, *shared); });
+		});
+		return Future<U>(next);
+	}
+
+private:
+	template <typename U>
+	friend std::shared_ptr<FutureState<U>> StateOf(Future<U>& future);
+
+	std::shared_ptr<FutureState<T>> state_;
+};
+
+template <typename T>
+std::shared_ptr<FutureState<T>> StateOf(Future<T>& future)
+{
+	return std::move(future.state_);
+}
+
+template <typename T>
+class Promise
+{
+public:
+	Promise() : state_(std::make_shared<FutureState<T>>()) {}
+
+	Promise(Promise&& other) noexcept
+		: state_(std::move(other.state_)), satisfied_(other.satisfied_), futureRetrieved_(other.futureRetrieved_) {}
+
+	Promise& operator=(Promise&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Abandon();
+			state_ = std::move(other.state_);
+			satisfied_ = other.satisfied_;
+			futureRetrieved_ = other.futureRetrieved_;
+		}
+		return *this;
+	}
+
+	Promise(const Promise&) = delete;
+	Promise& operator=(const Promise&) = delete;
+
+	~Promise() { Abandon(); }
+
+	Future<T> GetFuture()
+	{
+		if (!state_)
+			throw std::future_error(std::future_errc::no_state);
+		if (futureRetrieved_)
+			throw std::future_error(std::future_errc::future_already_retrieved);
+		futureRetrieved_ = true;
+		return Future<T>(state_);
+	}
+
+	template <typename... Args>
+	void SetValue(Args&&... args)
+	{
+		CheckSettable();
+		satisfied_ = true;
+		state_->SetValue(std::forward<Args>(args)...);
+	}
+
+	void SetException(std::exception_ptr error)
+	{
+		CheckSettable();
+		satisfied_ = true;
+		state_->SetException(std::move(error));
+	}
+
+private:
+	void CheckSettable() const
+	{
+		if (!state_)
+			throw std::future_error(std::future_errc::no_state);
+		if (satisfied_)
+			throw std::future_error(std::future_errc::promise_already_satisfied);
+	}
+
+	// 값을 채우지 않고 버려지면 broken_promise 를 전달합니다.
+	void Abandon()
+	{
+		if (state_ && !satisfied_)
+		{
+			satisfied_ = true;
+			state_->SetException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+		}
+		state_.reset();
+	}
+
+	std::shared_ptr<FutureState<T>> state_;
+	bool satisfied_ = false;
+	bool futureRetrieved_ = false;
+};
+
+template <typename T>
+Future<std::decay_t<T>> MakeReadyFuture(T&& value)
+{
+	auto state = std::make_shared<FutureState<std::decay_t<T>>>();
+	state->SetValue(std::forward<T>(value));
+	return Future<std::decay_t<T>>(state);
+}
+
+template <typename T>
+Future<std::vector<T>> WhenAll(std::vector<Future<T>> futures)
+{
+	struct Context
+	{
+		std::vector<std::optional<T>> results;
+		std::atomic<std::size_t> remaining{ 0 };
+		std::atomic<bool> failed{ false };
+		std::exception_ptr firstError; // failed 를 먼저 세운 쪽만 기록
+		Promise<std::vector<T>> promise;
+	};
+
+	auto ctx = std::make_shared<Context>();
+	Future<std::vector<T>> result = ctx->promise.GetFuture();
+	if (futures.empty())
+	{
+		ctx->promise.SetValue(std::vector<T>{});
+		return result;
+	}
+
+	ctx->results.resize(futures.size());
+	ctx->remaining.store(futures.size(), std::memory_order_relaxed);
+	for (std::size_t i = 0; i < futures.size(); ++i)
+	{
+		std::shared_ptr<FutureState<T>> state = StateOf(futures[i]);
+		FutureState<T>* raw = state.get();
+		raw->SetContinuation([ctx, state, i]() {
+			try
+			{
+				ctx->results[i].emplace(state->Take());
+			}
+			catch (...)
+			{
+				if (!ctx->failed.exchange(true, std::memory_order_acq_rel))
+					ctx->firstError = std::current_exception();
+			}
+
+			// 마지막으로 끝난 쪽이 결과를 만듭니다. (acq_rel 로 다른 결과 기록이 모두 보임)
+			if (ctx->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				return;
+			if (ctx->failed.load(std::memory_order_acquire))
+			{
+				ctx->promise.SetException(ctx->firstError);
+				return;
+			}
+			std::vector<T> values;
+			values.reserve(ctx->results.size());
+			for (auto& r : ctx->results)
+				values.push_back(std::move(*r));
+			ctx->promise.SetValue(std::move(values));
+		});
+	}
+	return result;
+}
+
+template <typename T>
+struct WhenAnyResult
+{
+	std::size_t index = 0;
+	T value;
+};
+
+template <typename T>
+Future<WhenAnyResult<T>> WhenAny(std::vector<Future<T>> futures)
+{
+	struct Context
+	{
+		std::atomic<bool> decided{ false };
+		Promise<WhenAnyResult<T>> promise;
+	};
+
+	auto ctx = std::make_shared<Context>();
+	Future<WhenAnyResult<T>> result = ctx->promise.GetFuture();
+	if (futures.empty())
+	{
+		ctx->promise.SetException(std::make_exception_ptr(std::future_error(std::future_errc::no_state)));
+		return result;
+	}
+
+	for (std::size_t i = 0; i < futures.size(); ++i)
+	{
+		std::shared_ptr<FutureState<T>> state = StateOf(futures[i]);
+		FutureState<T>* raw = state.get();
+		raw->SetContinuation([ctx, state, i]() {
+			// 가장 먼저 끝난 하나만 결과를 채웁니다.
+			if (ctx->decided.exchange(true, std::memory_order_acq_rel))
+				return;
+			try
+			{
+				ctx->promise.SetValue(WhenAnyResult<T>{ i, state->Take() });
+			}
+			catch (...)
+			{
+				ctx->promise.SetException(std::current_exception());
+			}
+		});
+	}
+	return result;
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 키 입력 / 워커 종료를 함께 기다리는 대기 집합
+//
+// 03_SignalWaiting 의 메인 루프는 KeyHit() 을 확인하고 30ms 씩 잠드는 폴링이라,
+// 명령마다 최대 30ms 가 늦고 아무 입력이 없어도 1초에 약 33번 깨어납니다.
+// InputWaitSet 은 입력과 종료 신호를 커널의 대기 집합 하나에 넣고, 둘 중 하나가 올 때만 깨어납니다.
+//
+//   InputWaitSet input;                       // 기본 입력: 표준 입력 (터미널이면 raw 모드로 바꿈)
+//   std::thread worker([&] { Work(); input.SignalExit(); });
+//   while (input.Wait() == InputWait::Key)
+//       Handle(ReadKey());
+//
+// 구현
+// - Linux  : epoll 에 입력 fd 와 eventfd(종료 신호)를 등록
+// - 그 외  : poll 에 입력 fd 와 self-pipe(종료 신호)
+// - Windows: WaitForMultipleObjects(콘솔 입력 핸들, 종료 Event, [워커 스레드 핸들])
+//            콘솔 핸들은 마우스 / 포커스 / key-up 레코드에도 신호가 되므로, 그런 레코드는 읽어서 버리고 다시 기다립니다.
+//
+// 종료 신호는 manual-reset Event 처럼 한 번 세우면 계속 켜져 있습니다. (Wait 이 계속 Exit 을 돌려줌)
+// 입력이 닫혀도(EOF) Key 로 깨어나며, 이어서 읽으면 kKeyEof 가 나옵니다.
+
+#include "Platform.hpp"
+
+#if !defined(_WIN32)
+#include <cerrno>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+#endif
+
+#include <cstdint>
+
+enum class InputWait
+{
+	Key,     // 읽을 입력이 있음 (또는 입력이 닫힘)
+	Exit,    // SignalExit() 또는 등록한 워커 스레드가 끝남
+	Timeout,
+	Error,
+};
+
+class InputWaitSet
+{
+public:
+#if defined(_WIN32)
+	explicit InputWaitSet(HANDLE input = ::GetStdHandle(STD_INPUT_HANDLE)) : input_(input)
+	{
+		exitEvent_ = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
+		ok_ = exitEvent_ != nullptr && input_ != nullptr && input_ != INVALID_HANDLE_VALUE;
+	}
+
+	~InputWaitSet()
+	{
+		if (exitEvent_)
+			::CloseHandle(exitEvent_);
+	}
+
+	// 워커 스레드 핸들을 대기 집합에 추가: 스레드가 끝나면(signaled) Exit
+	void WatchThread(HANDLE thread) { thread_ = thread; }
+#else
+	explicit InputWaitSet(int inputFd = STDIN_FILENO) : inputFd_(inputFd)
+	{
+		if (inputFd_ == STDIN_FILENO)
+			TerminalRawMode::Instance().Enable(); // canonical 모드면 Enter 전까지 읽을 수 있는 상태가 되지 않음
+#if defined(__linux__)
+		epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+		exitFd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if (epollFd_ < 0 || exitFd_ < 0)
+			return;
+		epoll_event exitEv{};
+		exitEv.events = EPOLLIN;
+		exitEv.data.fd = exitFd_;
+		epoll_event inputEv{};
+		inputEv.events = EPOLLIN;
+		inputEv.data.fd = inputFd_;
+		if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, exitFd_, &exitEv) != 0)
+			return;
+		if (::epoll_ctl(epollFd_, EPOLL_CTL_ADD, inputFd_, &inputEv) != 0)
+		{
+			// 일반 파일(< file 리다이렉트)은 epoll 에 넣을 수 없지만 항상 읽을 수 있는 상태입니다.
+			if (errno != EPERM)
+				return;
+			inputAlwaysReady_ = true;
+		}
+		ok_ = true;
+#else
+		int fds[2];
+		if (::pipe(fds) != 0)
+			return;
+		exitReadFd_ = fds[0];
+		exitFd_ = fds[1];
+		ok_ = true;
+#endif
+	}
+
+	~InputWaitSet()
+	{
+#if defined(__linux__)
+		if (epollFd_ >= 0)
+			::close(epollFd_);
+#else
+		if (exitReadFd_ >= 0)
+			::close(exitReadFd_);
+#endif
+		if (exitFd_ >= 0)
+			::close(exitFd_);
+	}
+#endif
+
+	InputWaitSet(const InputWaitSet&) = delete;
+	InputWaitSet& operator=(const InputWaitSet&) = delete;
+
+	// 대기 집합을 만들지 못했으면 false
+	bool Ok() const { return ok_; }
+
+	// 어느 스레드에서나 호출 가능. 여러 번 불러도 됩니다.
+	void SignalExit()
+	{
+#if defined(_WIN32)
+		::SetEvent(exitEvent_);
+#else
+#if defined(__linux__)
+		const std::uint64_t one = 1;
+		[[maybe_unused]] const ssize_t n = ::write(exitFd_, &one, sizeof(one));
+#else
+		const char one = 1;
+		[[maybe_unused]] const ssize_t n = ::write(exitFd_, &one, 1);
+#endif
+#endif
+	}
+
+	// 입력 또는 종료 신호가 올 때까지 잠듭니다. timeoutMs < 0 이면 무한 대기
+	// 둘 다 준비되어 있으면 Exit 이 먼저입니다.
+	InputWait Wait(int timeoutMs = -1)
+	{
+		while (true)
+		{
+			++wakeups_;
+			const InputWait w = WaitOnce(timeoutMs);
+			if (w != InputWait::Timeout || timeoutMs >= 0)
+				return w;
+		}
+	}
+
+	// Wait 이 커널 대기에서 돌아온 횟수 (유휴 중 깨어남 측정용)
+	long long Wakeups() const { return wakeups_; }
+
+private:
+#if defined(_WIN32)
+	InputWait WaitOnce(int timeoutMs)
+	{
+		// 입력 핸들은 항상 마지막. 앞쪽 핸들이 먼저 보고되므로 종료가 우선입니다.
+		HANDLE waits[3] = { exitEvent_, thread_, input_ };
+		DWORD count = 3;
+		if (thread_ == nullptr)
+		{
+			waits[1] = input_;
+			count = 2;
+		}
+		const DWORD w = ::WaitForMultipleObjects(count, waits, FALSE, timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs));
+		if (w == WAIT_TIMEOUT)
+			return InputWait::Timeout;
+		if (w == WAIT_FAILED)
+			return InputWait::Error;
+		if (w == WAIT_OBJECT_0 + count - 1)
+			return DropNonKeyRecords() ? InputWait::Key : InputWait::Timeout;
+		return InputWait::Exit;
+	}
+
+	// 콘솔 입력 버퍼 앞쪽의 key-down 이 아닌 레코드를 버립니다. _getch 로 읽을 키가 남았으면 true
+	bool DropNonKeyRecords()
+	{
+		DWORD mode = 0;
+		if (!::GetConsoleMode(input_, &mode))
+			return true; // 콘솔이 아님 (리다이렉트된 파일): 그대로 Key 로 취급
+		INPUT_RECORD record{};
+		DWORD read = 0;
+		while (::PeekConsoleInput(input_, &record, 1, &read) && read == 1)
+		{
+			if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown && record.Event.KeyEvent.uChar.AsciiChar != 0)
+				return true;
+			::ReadConsoleInput(input_, &record, 1, &read);
+		}
+		return false;
+	}
+
+	HANDLE input_ = nullptr;
+	HANDLE exitEvent_ = nullptr;
+	HANDLE thread_ = nullptr;
+#else
+	InputWait WaitOnce(int timeoutMs)
+	{
+#if defined(__linux__)
+		epoll_event events[2];
+		const int n = ::epoll_wait(epollFd_, events, 2, inputAlwaysReady_ ? 0 : timeoutMs);
+		if (n < 0)
+			return errno == EINTR ? InputWait::Timeout : InputWait::Error;
+		for (int i = 0; i < n; ++i)
+		{
+			if (events[i].data.fd == exitFd_)
+				return InputWait::Exit;
+		}
+		return (n > 0 || inputAlwaysReady_) ? InputWait::Key : InputWait::Timeout;
+#else
+		pollfd fds[2] = { { exitReadFd_, POLLIN, 0 }, { inputFd_, POLLIN, 0 } };
+		const int n = ::poll(fds, 2, timeoutMs);
+		if (n < 0)
+			return errno == EINTR ? InputWait::Timeout : InputWait::Error;
+		if (fds[0].revents != 0)
+			return InputWait::Exit;
+		return n > 0 ? InputWait::Key : InputWait::Timeout;
+#endif
+	}
+
+	int inputFd_ = -1;
+	int exitFd_ = -1; // Linux: eventfd, 그 외: self-pipe 쓰기 쪽
+#if defined(__linux__)
+	int epollFd_ = -1;
+	bool inputAlwaysReady_ = false;
+#else
+	int exitReadFd_ = -1;
+#endif
+#endif
+	bool ok_ = false;
+	long long wakeups_ = 0;
+};
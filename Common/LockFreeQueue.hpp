@@ -0,0 +1,210 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 고정 크기 lock-free 큐
+//
+// - MpmcQueue<T> : 생산자 여럿 / 소비자 여럿 (Dmitry Vyukov 의 bounded MPMC queue)
+// - SpscQueue<T> : 생산자 하나 / 소비자 하나 전용 빠른 경로 (CAS 없이 load / store 만 사용)
+//
+// 둘 다 용량은 2의 거듭제곱으로 올림하고, 가득 차거나 비어 있으면 기다리지 않고 false 를 돌려줍니다.
+// 기다리는 정책(스핀, yield, 잠들기)은 사용하는 쪽에서 정합니다.
+
+#include "CacheLine.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+inline std::size_t RoundUpPowerOfTwo(std::size_t n)
+{
+	std::size_t p = 1;
+	while (p < n)
+		p <<= 1;
+	return p;
+}
+
+// Vyukov bounded MPMC queue
+// - 칸(cell)마다 sequence 번호를 둡니다.
+//   - sequence == pos       : pos 번째 push 가 쓸 수 있는 빈 칸
+//   - sequence == pos + 1   : pos 번째 push 가 채운 칸 (pos 번째 pop 이 가져갈 수 있음)
+//   - pop 이 끝나면 sequence = pos + capacity (한 바퀴 뒤의 push 가 쓸 수 있는 빈 칸)
+// - 생산자끼리는 enqueuePos_ 를, 소비자끼리는 dequeuePos_ 를 CAS 로 나눠 가지고,
+//   생산자와 소비자는 칸의 sequence 로만 만납니다. (서로의 위치 변수를 건드리지 않음)
+// - 칸을 캐시 라인 단위로 맞춰, 이웃 칸을 쓰는 생산자 / 소비자끼리 false sharing 이 생기지 않게 합니다.
+template <typename T>
+class MpmcQueue
+{
+public:
+	explicit MpmcQueue(std::size_t capacity)
+		: capacity_(RoundUpPowerOfTwo(capacity < 2 ? 2 : capacity)),
+		  mask_(capacity_ - 1),
+		  cells_(std::make_unique<Cell[]>(capacity_))
+	{
+		for (std::size_t i = 0; i < capacity_; ++i)
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	MpmcQueue(const MpmcQueue&) = delete;
+	MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+	std::size_t Capacity() const { return capacity_; }
+
+	// 대략적인 원소 수. 다른 스레드가 동시에 넣고 빼므로 참고용 (고수위 판단 등)
+	std::size_t ApproxSize() const
+	{
+		const std::size_t tail = enqueuePos_.value.load(std::memory_order_relaxed);
+		const std::size_t head = dequeuePos_.value.load(std::memory_order_relaxed);
+		return tail > head ? tail - head : 0;
+	}
+
+	bool TryPush(const T& value)
+	{
+		std::size_t pos = enqueuePos_.value.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Cell& cell = cells_[pos & mask_];
+			const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+			const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+			if (diff == 0)
+			{
+				if (enqueuePos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					cell.data = value;
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false; // 한 바퀴 전의 값을 아직 아무도 꺼내지 않음 = 가득 참
+			}
+			else
+			{
+				pos = enqueuePos_.value.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool TryPop(T& out)
+	{
+		std::size_t pos = dequeuePos_.value.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Cell& cell = cells_[pos & mask_];
+			const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+			const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+			if (diff == 0)
+			{
+				if (dequeuePos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					out = std::move(cell.data);
+					cell.sequence.store(pos + capacity_, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false; // 아직 채워지지 않음 = 비어 있음
+			}
+			else
+			{
+				pos = dequeuePos_.value.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+private:
+	struct alignas(kCacheLineSize) Cell
+	{
+		std::atomic<std::size_t> sequence{ 0 };
+		T data{};
+	};
+
+	const std::size_t capacity_;
+	const std::size_t mask_;
+	std::unique_ptr<Cell[]> cells_;
+	CacheLinePadded<std::atomic<std::size_t>> enqueuePos_;
+	CacheLinePadded<std::atomic<std::size_t>> dequeuePos_;
+};
+
+// SPSC 링 버퍼
+// - 생산자만 tail_ 을, 소비자만 head_ 를 씁니다. 상대 위치는 읽기만 하므로 CAS 가 필요 없습니다.
+// - 상대 위치의 마지막 값을 자기 캐시 라인에 복사해 두고(headCache_ / tailCache_),
+//   그 값으로 판단이 안 될 때(가득 참 / 비어 보임)만 상대의 캐시 라인을 다시 읽습니다.
+// - 배치 push / pop 은 여러 칸을 채운 뒤 위치를 한 번만 공개(release store)합니다.
+template <typename T>
+class SpscQueue
+{
+public:
+	explicit SpscQueue(std::size_t capacity)
+		: capacity_(RoundUpPowerOfTwo(capacity < 2 ? 2 : capacity)),
+		  mask_(capacity_ - 1),
+		  buffer_(std::make_unique<T[]>(capacity_))
+	{
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	std::size_t Capacity() const { return capacity_; }
+
+	bool TryPush(const T& value) { return TryPushBatch(&value, 1) == 1; }
+
+	bool TryPop(T& out) { return TryPopBatch(&out, 1) == 1; }
+
+	// 최대 count 개를 넣고, 실제로 넣은 개수를 돌려줍니다. (생산자 스레드 전용)
+	std::size_t TryPushBatch(const T* items, std::size_t count)
+	{
+		const std::size_t tail = producer_.tail.load(std::memory_order_relaxed);
+		std::size_t free = capacity_ - (tail - producer_.headCache);
+		if (free < count)
+		{
+			producer_.headCache = consumer_.head.load(std::memory_order_acquire);
+			free = capacity_ - (tail - producer_.headCache);
+		}
+		const std::size_t n = count < free ? count : free;
+		for (std::size_t i = 0; i < n; ++i)
+			buffer_[(tail + i) & mask_] = items[i];
+		if (n > 0)
+			producer_.tail.store(tail + n, std::memory_order_release);
+		return n;
+	}
+
+	// 최대 max 개를 꺼내고, 실제로 꺼낸 개수를 돌려줍니다. (소비자 스레드 전용)
+	std::size_t TryPopBatch(T* out, std::size_t max)
+	{
+		const std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+		std::size_t available = consumer_.tailCache - head;
+		if (available < max)
+		{
+			consumer_.tailCache = producer_.tail.load(std::memory_order_acquire);
+			available = consumer_.tailCache - head;
+		}
+		const std::size_t n = max < available ? max : available;
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = std::move(buffer_[(head + i) & mask_]);
+		if (n > 0)
+			consumer_.head.store(head + n, std::memory_order_release);
+		return n;
+	}
+
+private:
+	struct alignas(kCacheLineSize) ProducerSide
+	{
+		std::atomic<std::size_t> tail{ 0 };
+		std::size_t headCache = 0;
+	};
+
+	struct alignas(kCacheLineSize) ConsumerSide
+	{
+		std::atomic<std::size_t> head{ 0 };
+		std::size_t tailCache = 0;
+	};
+
+	const std::size_t capacity_;
+	const std::size_t mask_;
+	std::unique_ptr<T[]> buffer_;
+	ProducerSide producer_;
+	ConsumerSide consumer_;
+};
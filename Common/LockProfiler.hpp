@@ -0,0 +1,423 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 락 경합 프로파일러
+//
+// 02 의 누적 결과(g_Total)는 맞는지 알 수 있지만, 스레드들이 totalMutex / cs 앞에서 얼마나 기다렸는지는 보이지 않습니다.
+// ProfiledLock<Lock> 은 Lockable 타입(std::mutex, Common/Locks.hpp 의 락, WinCriticalSection)을 감싸서
+// 락 이름(site)별로 아래 값을 모읍니다.
+//
+// - acquires  : 획득 횟수
+// - contended : try_lock 이 실패해 기다려야 했던 획득 횟수 (나머지는 uncontended)
+// - wait      : 경합한 획득에서 lock() 호출부터 획득까지의 시간 히스토그램 (ns, 2의 거듭제곱 구간)
+// - hold      : 획득부터 unlock 까지의 시간 히스토그램. 스레드마다 SetHoldSampleEvery(N) 번에 한 번만 잽니다.
+//
+// 오버헤드
+// - 경합이 없으면 try_lock 한 번 + 스레드별 버퍼의 카운터 증가뿐입니다. (시계는 읽지 않음)
+// - 시계(NowNs)는 경합해서 어차피 기다리는 경우와, 보유 시간 샘플에서만 읽습니다.
+// - 카운터는 스레드별 버퍼에 있고 자기 스레드만 씁니다. (lock 접두사 없는 load + store, 공유 캐시 라인 없음)
+//
+// 집계
+// - 스레드가 끝나면 그 스레드의 버퍼를 전역 합계에 더하고 버립니다. (스레드 10000개를 만들어도 버퍼가 쌓이지 않음)
+// - Report 는 전역 합계와 아직 살아 있는 스레드(풀 워커 등)의 버퍼를 합쳐, 총 대기 시간이 큰 락부터 출력합니다.
+//
+//   ProfiledLock<std::mutex> totalMutex("totalMutex");
+//   { std::lock_guard<ProfiledLock<std::mutex>> lock(totalMutex); ... }
+//   LockProfiler::Instance().Report(std::cout);   // 종료 시
+//
+// 같은 이름의 락 인스턴스들은 하나의 site 로 합쳐집니다. (락 "종류"별 통계)
+
+#include "Timing.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 히스토그램 구간 b: b == 0 이면 0ns, 그 외 [2^(b-1), 2^b) ns. 마지막 구간은 그 이상 전부 (약 1초 이상)
+constexpr int kLockHistogramBuckets = 32;
+// site 수 상한. 넘치면 마지막 site("(other)")에 모입니다.
+constexpr std::size_t kMaxProfiledLocks = 128;
+
+// 스레드 하나, site 하나의 카운터. 소유 스레드만 쓰고 Report 가 relaxed 로 읽습니다.
+struct LockSiteCounters
+{
+	std::atomic<std::uint64_t> acquires{ 0 };
+	std::atomic<std::uint64_t> contended{ 0 };
+	std::atomic<std::uint64_t> waitNs{ 0 };
+	std::atomic<std::uint64_t> maxWaitNs{ 0 };
+	std::atomic<std::uint64_t> holdSamples{ 0 };
+	std::atomic<std::uint64_t> holdNs{ 0 };
+	std::atomic<std::uint64_t> maxHoldNs{ 0 };
+	std::atomic<std::uint64_t> wait[kLockHistogramBuckets] = {};
+	std::atomic<std::uint64_t> hold[kLockHistogramBuckets] = {};
+};
+
+// 합산용 (일반 정수)
+struct LockSiteTotals
+{
+	std::string name;
+	std::uint64_t acquires = 0;
+	std::uint64_t contended = 0;
+	std::uint64_t waitNs = 0;
+	std::uint64_t maxWaitNs = 0;
+	std::uint64_t holdSamples = 0;
+	std::uint64_t holdNs = 0;
+	std::uint64_t maxHoldNs = 0;
+	std::uint64_t wait[kLockHistogramBuckets] = {};
+	std::uint64_t hold[kLockHistogramBuckets] = {};
+
+	void Add(const LockSiteCounters& c)
+	{
+		acquires += c.acquires.load(std::memory_order_relaxed);
+		contended += c.contended.load(std::memory_order_relaxed);
+		waitNs += c.waitNs.load(std::memory_order_relaxed);
+		maxWaitNs = std::max<std::uint64_t>(maxWaitNs, c.maxWaitNs.load(std::memory_order_relaxed));
+		holdSamples += c.holdSamples.load(std::memory_order_relaxed);
+		holdNs += c.holdNs.load(std::memory_order_relaxed);
+		maxHoldNs = std::max<std::uint64_t>(maxHoldNs, c.maxHoldNs.load(std::memory_order_relaxed));
+		for (int b = 0; b < kLockHistogramBuckets; ++b)
+		{
+			wait[b] += c.wait[b].load(std::memory_order_relaxed);
+			hold[b] += c.hold[b].load(std::memory_order_relaxed);
+		}
+	}
+};
+
+inline int LockHistogramBucket(std::uint64_t ns)
+{
+	const int b = static_cast<int>(std::bit_width(ns));
+	return b < kLockHistogramBuckets ? b : kLockHistogramBuckets - 1;
+}
+
+// 구간 b 의 상한 (ns). 히스토그램 분위수는 이 값으로 보고합니다. (실제 값 이하, 2배 이내)
+inline std::uint64_t LockHistogramUpperNs(int b)
+{
+	return b == 0 ? 0 : (std::uint64_t{ 1 } << b) - 1;
+}
+
+// 히스토그램에서 q (0.0 ~ 1.0) 분위수가 들어 있는 구간의 상한
+inline std::uint64_t LockHistogramPercentile(const std::uint64_t (&hist)[kLockHistogramBuckets], double q)
+{
+	std::uint64_t total = 0;
+	for (std::uint64_t n : hist)
+		total += n;
+	if (total == 0)
+		return 0;
+	const std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(total));
+	std::uint64_t seen = 0;
+	for (int b = 0; b < kLockHistogramBuckets; ++b)
+	{
+		seen += hist[b];
+		if (seen > rank)
+			return LockHistogramUpperNs(b);
+	}
+	return LockHistogramUpperNs(kLockHistogramBuckets - 1);
+}
+
+class LockProfiler
+{
+public:
+	static LockProfiler& Instance()
+	{
+		static LockProfiler profiler;
+		return profiler;
+	}
+
+	LockProfiler(const LockProfiler&) = delete;
+	LockProfiler& operator=(const LockProfiler&) = delete;
+
+	// 끄면 ProfiledLock 이 감싼 락을 그대로 호출합니다. (실행 중 켜고 끌 수 있음)
+	void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+	bool Enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+	// 보유 시간을 스레드마다 N 번 획득에 한 번 잽니다. (N 은 2의 거듭제곱으로 올림, 1 이면 매번)
+	void SetHoldSampleEvery(unsigned n)
+	{
+		const unsigned rounded = std::bit_ceil(n == 0 ? 1u : n);
+		holdSampleMask_.store(rounded - 1, std::memory_order_relaxed);
+	}
+	unsigned HoldSampleEvery() const { return holdSampleMask_.load(std::memory_order_relaxed) + 1; }
+
+	// 이름으로 site 번호 찾기 (없으면 등록). 락을 만들 때 한 번만 호출됩니다.
+	std::uint32_t SiteId(const std::string& name)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		for (std::size_t i = 0; i < retired_.size(); ++i)
+		{
+			if (retired_[i].name == name)
+				return static_cast<std::uint32_t>(i);
+		}
+		if (retired_.size() + 1 >= kMaxProfiledLocks)
+			return OverflowSiteLocked();
+		retired_.emplace_back();
+		retired_.back().name = name;
+		return static_cast<std::uint32_t>(retired_.size() - 1);
+	}
+
+	// 현재 스레드의 site 카운터 (처음 쓰는 site 면 할당)
+	LockSiteCounters& Local(std::uint32_t site)
+	{
+		thread_local ThreadBufferHandle handle(*this);
+		LockSiteCounters* c = handle.buffer->sites[site].load(std::memory_order_relaxed);
+		if (c == nullptr)
+		{
+			c = new LockSiteCounters;
+			handle.buffer->sites[site].store(c, std::memory_order_release);
+		}
+		return *c;
+	}
+
+	unsigned NextHoldTick()
+	{
+		thread_local unsigned tick = 0;
+		return tick++ & holdSampleMask_.load(std::memory_order_relaxed);
+	}
+
+	// 끝난 스레드의 합계 + 살아 있는 스레드의 버퍼 (site 번호 순)
+	std::vector<LockSiteTotals> Snapshot()
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		std::vector<LockSiteTotals> sites = retired_;
+		for (const ThreadBuffer* buffer : live_)
+			AddBufferLocked(*buffer, sites);
+		return sites;
+	}
+
+	// 총 대기 시간이 큰 순서로 상위 top 개 site 를 출력합니다.
+	void Report(std::ostream& out, std::size_t top = 10)
+	{
+		std::vector<LockSiteTotals> sites = Snapshot();
+		sites.erase(std::remove_if(sites.begin(), sites.end(), [](const LockSiteTotals& s) { return s.acquires == 0; }), sites.end());
+		std::sort(sites.begin(), sites.end(), [](const LockSiteTotals& a, const LockSiteTotals& b) {
+			if (a.waitNs != b.waitNs)
+				return a.waitNs > b.waitNs;
+			return a.acquires > b.acquires;
+		});
+		if (sites.size() > top)
+			sites.resize(top);
+
+		std::size_t nameWidth = 6;
+		for (const LockSiteTotals& s : sites)
+		{
+			if (s.name.size() + 2 > nameWidth)
+				nameWidth = s.name.size() + 2;
+		}
+
+		const std::ios::fmtflags flags = out.flags();
+		out << "[lock profile] hottest locks by total wait (hold sampled 1/" << HoldSampleEvery()
+			<< ", percentiles are power-of-two bucket upper bounds capped at the observed max)\n";
+		out << std::left
+			<< std::setw(static_cast<int>(nameWidth)) << "lock"
+			<< std::setw(12) << "acquires"
+			<< std::setw(12) << "contended"
+			<< std::setw(9) << "cont(%)"
+			<< std::setw(12) << "wait(ms)"
+			<< std::setw(13) << "wait p50(ns)"
+			<< std::setw(13) << "wait p99(ns)"
+			<< std::setw(13) << "wait max(ns)"
+			<< std::setw(13) << "hold p50(ns)"
+			<< "hold p99(ns)\n";
+		for (const LockSiteTotals& s : sites)
+		{
+			out << std::left
+				<< std::setw(static_cast<int>(nameWidth)) << s.name
+				<< std::setw(12) << s.acquires
+				<< std::setw(12) << s.contended
+				<< std::setw(9) << std::fixed << std::setprecision(1) << s.contended * 100.0 / static_cast<double>(s.acquires)
+				<< std::setw(12) << std::setprecision(3) << static_cast<double>(s.waitNs) / 1e6
+				<< std::setw(13) << std::min(LockHistogramPercentile(s.wait, 0.50), s.maxWaitNs)
+				<< std::setw(13) << std::min(LockHistogramPercentile(s.wait, 0.99), s.maxWaitNs)
+				<< std::setw(13) << s.maxWaitNs
+				<< std::setw(13) << std::min(LockHistogramPercentile(s.hold, 0.50), s.maxHoldNs)
+				<< std::min(LockHistogramPercentile(s.hold, 0.99), s.maxHoldNs) << "\n";
+		}
+		if (sites.empty())
+			out << "(no profiled lock was acquired)\n";
+		out.flags(flags);
+	}
+
+private:
+	struct ThreadBuffer
+	{
+		std::atomic<LockSiteCounters*> sites[kMaxProfiledLocks] = {};
+
+		~ThreadBuffer()
+		{
+			for (auto& site : sites)
+				delete site.load(std::memory_order_relaxed);
+		}
+	};
+
+	// thread_local: 스레드가 처음 프로파일된 락을 잡을 때 버퍼를 등록하고, 스레드가 끝날 때 합계에 더한 뒤 버립니다.
+	struct ThreadBufferHandle
+	{
+		explicit ThreadBufferHandle(LockProfiler& p) : profiler(p), buffer(new ThreadBuffer)
+		{
+			std::lock_guard<std::mutex> guard(profiler.mutex_);
+			profiler.live_.push_back(buffer);
+		}
+
+		~ThreadBufferHandle()
+		{
+			std::lock_guard<std::mutex> guard(profiler.mutex_);
+			AddBufferLocked(*buffer, profiler.retired_);
+			profiler.live_.erase(std::find(profiler.live_.begin(), profiler.live_.end(), buffer));
+			delete buffer;
+		}
+
+		LockProfiler& profiler;
+		ThreadBuffer* buffer;
+	};
+
+	LockProfiler() { retired_.reserve(kMaxProfiledLocks); }
+
+	static void AddBufferLocked(const ThreadBuffer& buffer, std::vector<LockSiteTotals>& sites)
+	{
+		for (std::size_t i = 0; i < sites.size(); ++i)
+		{
+			if (const LockSiteCounters* c = buffer.sites[i].load(std::memory_order_acquire))
+				sites[i].Add(*c);
+		}
+	}
+
+	std::uint32_t OverflowSiteLocked()
+	{
+		if (retired_.size() + 1 == kMaxProfiledLocks)
+		{
+			retired_.emplace_back();
+			retired_.back().name = "(other)";
+		}
+		return static_cast<std::uint32_t>(kMaxProfiledLocks - 1);
+	}
+
+	std::atomic<bool> enabled_{ true };
+	std::atomic<unsigned> holdSampleMask_{ 15 };
+	std::mutex mutex_;
+	std::vector<LockSiteTotals> retired_;   // site 번호 = 인덱스. 이름 + 끝난 스레드들의 합계
+	std::vector<ThreadBuffer*> live_;
+};
+
+// 소유 스레드만 쓰는 카운터: lock 접두사 없이 올립니다.
+inline void BumpLockCounter(std::atomic<std::uint64_t>& counter, std::uint64_t n = 1)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+template <typename Lock>
+class ProfiledLock
+{
+public:
+	explicit ProfiledLock(const std::string& site = "unnamed") : site_(LockProfiler::Instance().SiteId(site)) {}
+
+	ProfiledLock(const ProfiledLock&) = delete;
+	ProfiledLock& operator=(const ProfiledLock&) = delete;
+
+	// 다른 스레드가 쓰기 전에 호출해야 합니다. (템플릿 코드에서 기본 생성한 락에 이름 붙이기)
+	void SetSite(const std::string& site) { site_ = LockProfiler::Instance().SiteId(site); }
+
+	void lock()
+	{
+		LockProfiler& profiler = LockProfiler::Instance();
+		if (!profiler.Enabled())
+		{
+			lock_.lock();
+			holdStartNs_ = 0;
+			return;
+		}
+
+		LockSiteCounters& c = profiler.Local(site_);
+		if (!lock_.try_lock())
+		{
+			const std::int64_t t0 = NowNs();
+			lock_.lock();
+			const std::uint64_t waited = static_cast<std::uint64_t>(NowNs() - t0);
+			BumpLockCounter(c.contended);
+			BumpLockCounter(c.waitNs, waited);
+			BumpLockCounter(c.wait[LockHistogramBucket(waited)]);
+			if (waited > c.maxWaitNs.load(std::memory_order_relaxed))
+				c.maxWaitNs.store(waited, std::memory_order_relaxed);
+		}
+		BumpLockCounter(c.acquires);
+		// 아래 값은 락을 잡은 스레드만 씁니다. (감싼 락이 보호)
+		holdStartNs_ = profiler.NextHoldTick() == 0 ? NowNs() : 0;
+	}
+
+	bool try_lock()
+	{
+		if (!lock_.try_lock())
+			return false;
+		LockProfiler& profiler = LockProfiler::Instance();
+		holdStartNs_ = 0;
+		if (profiler.Enabled())
+		{
+			BumpLockCounter(profiler.Local(site_).acquires);
+			if (profiler.NextHoldTick() == 0)
+				holdStartNs_ = NowNs();
+		}
+		return true;
+	}
+
+	void unlock()
+	{
+		if (holdStartNs_ != 0)
+		{
+			const std::uint64_t held = static_cast<std::uint64_t>(NowNs() - holdStartNs_);
+			LockSiteCounters& c = LockProfiler::Instance().Local(site_);
+			BumpLockCounter(c.holdSamples);
+			BumpLockCounter(c.holdNs, held);
+			BumpLockCounter(c.hold[LockHistogramBucket(held)]);
+			if (held > c.maxHoldNs.load(std::memory_order_relaxed))
+				c.maxHoldNs.store(held, std::memory_order_relaxed);
+		}
+		lock_.unlock();
+	}
+
+private:
+	Lock lock_;
+	std::uint32_t site_;
+	std::int64_t holdStartNs_ = 0;
+};
+
+// 템플릿 코드에서 기본 생성한 락에 site 이름 붙이기. 프로파일되지 않는 락이면 아무 일도 하지 않습니다.
+template <typename Lock>
+void NameLock(Lock&, const std::string&) {}
+
+template <typename Lock>
+void NameLock(ProfiledLock<Lock>& lock, const std::string& site)
+{
+	lock.SetSite(site);
+}
+
+#if defined(_WIN32)
+// CRITICAL_SECTION 을 Lockable 로 (ProfiledLock<WinCriticalSection>, std::lock_guard 에 넣기 위함)
+class WinCriticalSection
+{
+public:
+	WinCriticalSection() { ::InitializeCriticalSection(&cs_); }
+	~WinCriticalSection() { ::DeleteCriticalSection(&cs_); }
+
+	WinCriticalSection(const WinCriticalSection&) = delete;
+	WinCriticalSection& operator=(const WinCriticalSection&) = delete;
+
+	void lock() { ::EnterCriticalSection(&cs_); }
+	bool try_lock() { return ::TryEnterCriticalSection(&cs_) != FALSE; }
+	void unlock() { ::LeaveCriticalSection(&cs_); }
+
+private:
+	CRITICAL_SECTION cs_;
+};
+#endif
@@ -0,0 +1,296 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 프로젝트 락 모음
+//
+// 모두 std::mutex 와 같은 인터페이스(lock / try_lock / unlock, C++ Lockable)를 가지므로
+// std::lock_guard / std::unique_lock 에 그대로 넣을 수 있고, 락 타입을 템플릿 인자로 바꿔 끼울 수 있습니다.
+//
+// - TtasSpinLock  : test-and-test-and-set. 잠겨 있으면 읽기만 하며 기다리고, 실패할 때마다 대기 시간을 2배로(지수 백오프)
+// - TicketLock    : 번호표 순서대로 획득 (FIFO 공정성). 앞에 남은 대기자 수에 비례해 백오프
+// - McsLock       : 대기자마다 자기 노드에서만 스핀하는 큐 락. 락 해제 시 캐시 라인 이동이 다음 대기자 하나로 한정
+// - AdaptiveMutex : 잠깐 스핀한 뒤 futex 로 잠드는 mutex. 스핀 횟수는 최근 성공 기록으로 조절 (glibc adaptive mutex 방식)
+//
+// 스핀 대기 공통 규칙
+// - 대기 루프에는 CpuRelax() (x86 pause) 를 넣습니다.
+// - 코어가 하나뿐이면(SpinWaitUseful() == false) 스핀해도 락 보유자가 실행될 수 없으므로 바로 yield 합니다.
+// - 백오프가 상한에 닿으면 yield 를 섞어, 락 보유자가 선점된 경우(스레드 수 > 코어 수)에도 진행되게 합니다.
+
+#include "CacheLine.hpp"
+#include "Futex.hpp"
+#include "Platform.hpp" // CpuRelax, SpinWaitUseful
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 지수 백오프: Pause() 할 때마다 대기 시간이 kMin, 2*kMin, ... kMax 로 늘어납니다.
+class SpinBackoff
+{
+public:
+	static constexpr unsigned kMinSpins = 4;
+	static constexpr unsigned kMaxSpins = 1024;
+
+	void Pause()
+	{
+		if (!SpinWaitUseful() || spins_ >= kMaxSpins)
+		{
+			std::this_thread::yield();
+			return;
+		}
+		for (unsigned i = 0; i < spins_; ++i)
+			CpuRelax();
+		spins_ *= 2;
+	}
+
+	void Reset() { spins_ = kMinSpins; }
+
+private:
+	unsigned spins_ = kMinSpins;
+};
+
+class TtasSpinLock
+{
+public:
+	void lock()
+	{
+		SpinBackoff backoff;
+		while (locked_.exchange(true, std::memory_order_acquire))
+		{
+			// 잠겨 있는 동안은 읽기만 합니다. (exchange 를 반복하면 매번 캐시 라인을 독점으로 가져옴)
+			do
+				backoff.Pause();
+			while (locked_.load(std::memory_order_relaxed));
+		}
+	}
+
+	bool try_lock()
+	{
+		return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+	}
+
+	void unlock() { locked_.store(false, std::memory_order_release); }
+
+private:
+	std::atomic<bool> locked_{ false };
+};
+
+class TicketLock
+{
+public:
+	// 내 앞 대기자 한 명당 pause 횟수 (임계 구역 길이에 맞춰 조절하는 값)
+	static constexpr unsigned kSpinsPerWaiter = 64;
+
+	void lock()
+	{
+		const std::uint32_t ticket = next_.value.fetch_add(1, std::memory_order_relaxed);
+		while (true)
+		{
+			const std::uint32_t serving = serving_.value.load(std::memory_order_acquire);
+			if (serving == ticket)
+				return;
+			if (!SpinWaitUseful())
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			// 비례 백오프: 앞에 남은 사람이 많을수록 오래 쉽니다.
+			const std::uint32_t ahead = ticket - serving;
+			for (std::uint32_t i = 0; i < ahead * kSpinsPerWaiter; ++i)
+				CpuRelax();
+			if (ahead > std::thread::hardware_concurrency())
+				std::this_thread::yield();
+		}
+	}
+
+	bool try_lock()
+	{
+		std::uint32_t serving = serving_.value.load(std::memory_order_relaxed);
+		std::uint32_t expected = serving;
+		return next_.value.compare_exchange_strong(expected, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	void unlock()
+	{
+		// serving_ 은 락 보유자만 바꾸므로 load + store 로 충분합니다.
+		serving_.value.store(serving_.value.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+private:
+	// 번호표 발급(next_)과 호출 번호(serving_)를 다른 캐시 라인에 두어, 새 대기자가 보유자의 해제를 방해하지 않게 합니다.
+	CacheLinePadded<std::atomic<std::uint32_t>> next_;
+	CacheLinePadded<std::atomic<std::uint32_t>> serving_;
+};
+
+// MCS 큐 락 (Mellor-Crummey & Scott, 1991)
+// - 대기자는 자기 노드의 locked 플래그만 보며 스핀합니다.
+// - 해제하는 스레드가 다음 노드의 플래그 하나만 바꾸므로, 대기자가 많아도 캐시 라인 이동이 늘지 않습니다.
+// - lock(node) / unlock(node) 가 원래 형태이고, 인자 없는 lock() / unlock() 은 스레드마다 준비된
+//   노드 스택(kMaxHeldPerThread 개)을 사용합니다. 여러 McsLock 을 동시에 잡을 때는 LIFO 순서로 풀어야 합니다.
+//   그보다 깊게 중첩하면 넘친 노드는 힙에 만들고 unlock 에서 지웁니다.
+struct alignas(kCacheLineSize) McsNode
+{
+	std::atomic<McsNode*> next{ nullptr };
+	std::atomic<bool> locked{ false };
+};
+
+class McsLock
+{
+public:
+	static constexpr int kMaxHeldPerThread = 8;
+
+	void lock(McsNode& node)
+	{
+		node.next.store(nullptr, std::memory_order_relaxed);
+		node.locked.store(true, std::memory_order_relaxed);
+
+		McsNode* prev = tail_.exchange(&node, std::memory_order_acq_rel);
+		if (prev == nullptr)
+			return;
+
+		prev->next.store(&node, std::memory_order_release);
+		while (node.locked.load(std::memory_order_acquire))
+		{
+			if (SpinWaitUseful())
+				CpuRelax();
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	bool try_lock(McsNode& node)
+	{
+		node.next.store(nullptr, std::memory_order_relaxed);
+		McsNode* expected = nullptr;
+		return tail_.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	void unlock(McsNode& node)
+	{
+		McsNode* successor = node.next.load(std::memory_order_acquire);
+		if (successor == nullptr)
+		{
+			// 뒤에 아무도 없으면 tail 을 비우고 끝. 실패하면 누군가 tail 은 바꿨지만 아직 next 를 연결하지 못한 것입니다.
+			McsNode* expected = &node;
+			if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+				return;
+			while ((successor = node.next.load(std::memory_order_acquire)) == nullptr)
+				CpuRelax();
+		}
+		successor->locked.store(false, std::memory_order_release);
+	}
+
+	void lock()
+	{
+		McsNode* node = PushThreadNode();
+		lock(*node);
+		holder_ = node; // 락을 잡은 스레드만 쓰고 읽습니다.
+	}
+
+	bool try_lock()
+	{
+		McsNode* node = PushThreadNode();
+		if (!try_lock(*node))
+		{
+			PopThreadNode(node);
+			return false;
+		}
+		holder_ = node;
+		return true;
+	}
+
+	void unlock()
+	{
+		McsNode* node = holder_;
+		unlock(*node);
+		PopThreadNode(node);
+	}
+
+private:
+	struct ThreadNodes
+	{
+		McsNode nodes[kMaxHeldPerThread];
+		int depth = 0;
+	};
+
+	static ThreadNodes& CurrentThreadNodes()
+	{
+		thread_local ThreadNodes tls;
+		return tls;
+	}
+
+	static McsNode* PushThreadNode()
+	{
+		ThreadNodes& t = CurrentThreadNodes();
+		if (t.depth < kMaxHeldPerThread)
+			return &t.nodes[t.depth++];
+		++t.depth;
+		return new McsNode;
+	}
+
+	static void PopThreadNode(McsNode* node)
+	{
+		ThreadNodes& t = CurrentThreadNodes();
+		if (--t.depth >= kMaxHeldPerThread)
+			delete node;
+	}
+
+	std::atomic<McsNode*> tail_{ nullptr };
+	McsNode* holder_ = nullptr;
+};
+
+// 스핀 후 futex 로 잠드는 mutex (Drepper, "Futexes Are Tricky" 의 mutex3 + 적응형 스핀)
+// 상태: 0 = 풀림, 1 = 잠김(대기자 없음), 2 = 잠김(잠든 대기자가 있을 수 있음)
+// - 경쟁이 없으면 lock / unlock 모두 atomic 연산 하나 (시스템 콜 없음)
+// - 경쟁이 있으면 spinLimit 만큼 스핀하다가 상태를 2 로 바꾸고 futex 로 잠듭니다.
+// - unlock 은 상태가 2 였을 때만 futex wake 를 호출합니다.
+// - 스핀 한도는 "최근 스핀으로 획득하는 데 걸린 횟수" 의 이동 평균 * 2 (+ 여유) 로 조절합니다.
+class AdaptiveMutex
+{
+public:
+	static constexpr int kMaxSpins = 1000;
+
+	void lock()
+	{
+		std::uint32_t expected = 0;
+		if (state_.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+			return;
+
+		if (SpinWaitUseful())
+		{
+			const int estimate = spinEstimate_.load(std::memory_order_relaxed);
+			const int limit = estimate * 2 + 10 < kMaxSpins ? estimate * 2 + 10 : kMaxSpins;
+			int spins = 0;
+			for (; spins < limit; ++spins)
+			{
+				CpuRelax();
+				expected = 0;
+				if (state_.load(std::memory_order_relaxed) == 0 &&
+					state_.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+					break;
+			}
+			spinEstimate_.store(estimate + (spins - estimate) / 8, std::memory_order_relaxed);
+			if (spins < limit)
+				return;
+		}
+
+		// 잠들기: 상태를 2 로 바꿔 unlock 쪽이 깨우도록 남기고, 바꾸기 전 값이 0 이었으면 그대로 획득한 것입니다.
+		while (state_.exchange(2, std::memory_order_acquire) != 0)
+			FutexWait(&state_, 2);
+	}
+
+	bool try_lock()
+	{
+		std::uint32_t expected = 0;
+		return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	void unlock()
+	{
+		if (state_.exchange(0, std::memory_order_release) == 2)
+			FutexWakeOne(&state_);
+	}
+
+private:
+	FutexWord state_{ 0 };
+	std::atomic<int> spinEstimate_{ 0 };
+};
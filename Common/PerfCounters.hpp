@@ -0,0 +1,182 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 하드웨어 성능 카운터 (Linux perf_event_open)
+//
+//   PerfCounters counters(CacheCounterSpecs(HitmRawEvent()));
+//   counters.Start();            // 측정할 스레드를 만들기 "전에" 시작 (inherit)
+//   ... 스레드 생성 / 실행 / join ...
+//   counters.Stop();
+//   counters.Value(0);           // 열지 못한 카운터는 -1
+//
+// - 현재 스레드 기준으로 열고 inherit=1 을 주어, 이후에 만든 스레드의 값이 join(스레드 종료) 시 합산됩니다.
+// - exclude_kernel=1 이므로 perf_event_paranoid <= 2 면 일반 사용자도 열 수 있습니다.
+// - 가상 머신 / 컨테이너에서는 PMU 가 없거나 막혀 있는 경우가 많습니다. 이때는 Error() 에 이유가 남습니다.
+// - Windows 는 사용자 모드 API 가 없으므로 (VTune / WPR 의 PMU 프로파일 사용) 항상 사용 불가로 둡니다.
+
+#if !defined(_WIN32)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct PerfCounterSpec
+{
+	std::string name;
+	std::uint32_t type = 0;   // PERF_TYPE_HARDWARE / PERF_TYPE_HW_CACHE / PERF_TYPE_RAW
+	std::uint64_t config = 0;
+};
+
+// Intel 의 HITM(다른 코어 캐시에서 수정된 라인을 가져온 load) raw 이벤트.
+// Skylake 이후 MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM (event 0xD2, umask 0x04).
+// Intel 이 아니거나 알 수 없으면 0 (측정 안 함)
+inline std::uint64_t HitmRawEvent()
+{
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+	std::FILE* f = std::fopen("/proc/cpuinfo", "r");
+	if (!f)
+		return 0;
+	char line[256];
+	bool intel = false;
+	while (std::fgets(line, sizeof(line), f))
+	{
+		if (std::strncmp(line, "vendor_id", 9) == 0)
+		{
+			intel = std::strstr(line, "GenuineIntel") != nullptr;
+			break;
+		}
+	}
+	std::fclose(f);
+	return intel ? 0x04D2 : 0;
+#else
+	return 0;
+#endif
+}
+
+// cache-misses / cache-references (보통 LLC) + L1D load miss (+ hitmRaw != 0 이면 HITM)
+inline std::vector<PerfCounterSpec> CacheCounterSpecs(std::uint64_t hitmRaw)
+{
+	std::vector<PerfCounterSpec> specs;
+#if !defined(_WIN32)
+	specs.push_back({ "cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES });
+	specs.push_back({ "cache-refs", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES });
+	specs.push_back({ "l1d-miss", PERF_TYPE_HW_CACHE,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) });
+	if (hitmRaw != 0)
+		specs.push_back({ "hitm", PERF_TYPE_RAW, hitmRaw });
+#else
+	(void)hitmRaw;
+#endif
+	return specs;
+}
+
+class PerfCounters
+{
+public:
+	explicit PerfCounters(const std::vector<PerfCounterSpec>& specs)
+		: specs_(specs), fds_(specs.size(), -1)
+	{
+#if defined(_WIN32)
+		error_ = "not supported on Windows";
+#else
+		for (std::size_t i = 0; i < specs_.size(); ++i)
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = specs_[i].type;
+			attr.config = specs_[i].config;
+			attr.disabled = 1;
+			attr.inherit = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			const long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+			if (fd < 0)
+			{
+				if (error_.empty())
+					error_ = specs_[i].name + ": " + std::strerror(errno);
+				continue;
+			}
+			fds_[i] = static_cast<int>(fd);
+		}
+#endif
+	}
+
+	~PerfCounters()
+	{
+#if !defined(_WIN32)
+		for (int fd : fds_)
+		{
+			if (fd >= 0)
+				::close(fd);
+		}
+#endif
+	}
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	std::size_t Size() const { return specs_.size(); }
+	const std::string& Name(std::size_t i) const { return specs_[i].name; }
+	bool Available(std::size_t i) const { return fds_[i] >= 0; }
+	bool AnyAvailable() const
+	{
+		for (int fd : fds_)
+		{
+			if (fd >= 0)
+				return true;
+		}
+		return false;
+	}
+	// 처음 실패한 카운터와 이유 (모두 열렸으면 빈 문자열)
+	const std::string& Error() const { return error_; }
+
+	void Start()
+	{
+#if !defined(_WIN32)
+		for (int fd : fds_)
+		{
+			if (fd < 0)
+				continue;
+			::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	void Stop()
+	{
+#if !defined(_WIN32)
+		for (int fd : fds_)
+		{
+			if (fd >= 0)
+				::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		}
+#endif
+	}
+
+	// 열지 못했거나 읽기에 실패하면 -1
+	long long Value(std::size_t i) const
+	{
+#if !defined(_WIN32)
+		std::uint64_t value = 0;
+		if (fds_[i] >= 0 && ::read(fds_[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))
+			return static_cast<long long>(value);
+#else
+		(void)i;
+#endif
+		return -1;
+	}
+
+private:
+	std::vector<PerfCounterSpec> specs_;
+	std::vector<int> fds_;
+	std::string error_;
+};
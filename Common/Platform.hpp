@@ -0,0 +1,161 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 플랫폼 추상화
+//
+// 목적
+// - Std 버전 랩들이 <Windows.h>/<conio.h> 없이도 빌드되도록, OS 의존 기능을 한 곳에 모읍니다.
+//   - thread id / 현재 CPU 번호 조회
+//   - 밀리초 단위 sleep
+//   - 키 입력 폴링 (_kbhit / _getch 대체)
+//   - 스핀 대기용 CPU 힌트 (pause)
+// - Win.hpp 쪽 코드는 계속 WinAPI를 직접 사용하며, Windows 전용으로 남습니다.
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX // std::min / std::max 와 충돌하는 매크로 제거
+#endif
+#include <Windows.h>
+#include <conio.h> // _kbhit, _getch
+#else
+#include <poll.h>
+#include <sched.h> // sched_getcpu
+#include <sys/syscall.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // _mm_pause
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using LabThreadId = unsigned long;
+
+// 현재 스레드의 OS thread id
+// - Windows: GetCurrentThreadId()
+// - Linux  : gettid() (perf, top -H 에서 보이는 값과 같습니다)
+inline LabThreadId CurrentThreadId()
+{
+#if defined(_WIN32)
+	return static_cast<LabThreadId>(::GetCurrentThreadId());
+#else
+	return static_cast<LabThreadId>(::syscall(SYS_gettid));
+#endif
+}
+
+// 현재 스레드가 실행 중인 CPU 번호 (반환 직후 다른 CPU 로 옮겨질 수 있으므로 힌트로만 사용)
+inline unsigned CurrentCpu()
+{
+#if defined(_WIN32)
+	return static_cast<unsigned>(::GetCurrentProcessorNumber());
+#elif defined(__linux__)
+	const int cpu = ::sched_getcpu();
+	return cpu < 0 ? 0u : static_cast<unsigned>(cpu);
+#else
+	return 0;
+#endif
+}
+
+inline void SleepMs(unsigned ms)
+{
+#if defined(_WIN32)
+	::Sleep(ms);
+#else
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#endif
+}
+
+// 스핀 대기 루프 한 번에 넣는 CPU 힌트
+// - x86: pause (하이퍼스레딩 형제 코어에 자원을 양보하고, 루프 탈출 시 파이프라인 플러시를 줄임)
+// - 그 외: 아무 힌트가 없으면 yield
+inline void CpuRelax()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	_mm_pause();
+#elif defined(__aarch64__)
+	asm volatile("yield" ::: "memory");
+#else
+	std::this_thread::yield();
+#endif
+}
+
+// 스핀 대기가 의미가 있는지 (코어가 하나뿐이면 스핀하는 동안 상대 스레드가 실행될 수 없음)
+inline bool SpinWaitUseful()
+{
+	static const bool useful = std::thread::hardware_concurrency() > 1;
+	return useful;
+}
+
+// 입력 스트림이 닫혔을 때(EOF) ReadKey()가 돌려주는 값
+constexpr int kKeyEof = -1;
+
+#if !defined(_WIN32)
+// 터미널을 non-canonical / no-echo 모드로 바꿔서 Enter 없이 한 글자씩 읽을 수 있게 합니다.
+// 원래 설정은 프로세스 종료 시 atexit()로 복원합니다.
+struct TerminalRawMode
+{
+	termios saved{};
+	bool active = false;
+
+	static TerminalRawMode& Instance()
+	{
+		static TerminalRawMode mode;
+		return mode;
+	}
+
+	void Enable()
+	{
+		if (active || !::isatty(STDIN_FILENO))
+			return;
+		if (::tcgetattr(STDIN_FILENO, &saved) != 0)
+			return;
+
+		termios raw = saved;
+		raw.c_lflag &= ~(ICANON | ECHO);
+		raw.c_cc[VMIN] = 1;
+		raw.c_cc[VTIME] = 0;
+		if (::tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0)
+			return;
+
+		active = true;
+		std::atexit([] { TerminalRawMode::Instance().Restore(); });
+	}
+
+	void Restore()
+	{
+		if (!active)
+			return;
+		::tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+		active = false;
+	}
+};
+#endif
+
+// 읽을 키 입력이 있으면 true (블로킹하지 않음) - _kbhit() 대체
+inline bool KeyHit()
+{
+#if defined(_WIN32)
+	return _kbhit() != 0;
+#else
+	TerminalRawMode::Instance().Enable();
+	pollfd pfd{ STDIN_FILENO, POLLIN, 0 };
+	return ::poll(&pfd, 1, 0) > 0;
+#endif
+}
+
+// 키 하나를 읽음 - _getch() 대체
+// 입력이 닫혔으면 kKeyEof를 반환합니다.
+inline int ReadKey()
+{
+#if defined(_WIN32)
+	return _getch();
+#else
+	TerminalRawMode::Instance().Enable();
+	unsigned char ch = 0;
+	const ssize_t n = ::read(STDIN_FILENO, &ch, 1);
+	return n == 1 ? static_cast<int>(ch) : kKeyEof;
+#endif
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 프로세스 자원 사용량
+//
+// - PeakRssKb()    : 최대 상주 메모리(peak RSS, KB)
+// - CurrentRssKb() : 지금 상주 메모리(RSS, KB). 객체 N개를 만든 전후의 차이로 객체당 메모리를 잴 때 사용
+// - ResetPeakRss() : peak RSS 기준점 초기화 (Linux 전용, 구간별 peak를 재기 위해 사용)
+// - ReadProcessUsage() : 프로세스 전체 CPU 시간(user / sys)과 문맥 교환 횟수
+//
+// Linux 는 /proc/self/status 의 VmHWM 을 읽고, clear_refs 에 "5"를 쓰면 VmHWM 이 현재 RSS로 초기화됩니다.
+// Windows 의 PeakWorkingSetSize 는 초기화할 방법이 없으므로 프로세스 전체 기준 peak 입니다.
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+inline long long PeakRssKb()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc{};
+	if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return -1;
+	return static_cast<long long>(pmc.PeakWorkingSetSize / 1024);
+#else
+	if (std::FILE* f = std::fopen("/proc/self/status", "r"))
+	{
+		char line[256];
+		long long kb = -1;
+		while (std::fgets(line, sizeof(line), f))
+		{
+			if (std::strncmp(line, "VmHWM:", 6) == 0)
+			{
+				std::sscanf(line + 6, "%lld", &kb);
+				break;
+			}
+		}
+		std::fclose(f);
+		if (kb >= 0)
+			return kb;
+	}
+
+	rusage usage{};
+	::getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss; // Linux: KB
+#endif
+}
+
+inline long long CurrentRssKb()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc{};
+	if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return -1;
+	return static_cast<long long>(pmc.WorkingSetSize / 1024);
+#else
+	long long kb = -1;
+	if (std::FILE* f = std::fopen("/proc/self/status", "r"))
+	{
+		char line[256];
+		while (std::fgets(line, sizeof(line), f))
+		{
+			if (std::strncmp(line, "VmRSS:", 6) == 0)
+			{
+				std::sscanf(line + 6, "%lld", &kb);
+				break;
+			}
+		}
+		std::fclose(f);
+	}
+	return kb;
+#endif
+}
+
+// 성공하면 이후 PeakRssKb()는 "지금부터의 peak"를 돌려줍니다.
+inline bool ResetPeakRss()
+{
+#if defined(_WIN32)
+	return false;
+#else
+	std::FILE* f = std::fopen("/proc/self/clear_refs", "w");
+	if (!f)
+		return false;
+	const bool ok = std::fputs("5", f) >= 0;
+	return (std::fclose(f) == 0) && ok;
+#endif
+}
+
+// 프로세스 전체(모든 스레드 합계) 누적값입니다. 구간 값은 전후 두 번 읽어 뺍니다.
+// - voluntaryCs   : 스스로 잠들며 CPU를 내준 횟수 (mutex / cv / futex 대기, sleep, yield 등)
+// - involuntaryCs : time slice 소진이나 선점으로 빼앗긴 횟수
+// Windows 는 프로세스 단위 문맥 교환 횟수를 제공하지 않으므로 -1 입니다.
+struct ProcessUsage
+{
+	std::int64_t userNs = 0;
+	std::int64_t sysNs = 0;
+	long long voluntaryCs = -1;
+	long long involuntaryCs = -1;
+
+	std::int64_t CpuNs() const { return userNs + sysNs; }
+	long long ContextSwitches() const { return voluntaryCs < 0 ? -1 : voluntaryCs + involuntaryCs; }
+};
+
+#if defined(_WIN32)
+// FILETIME 은 100ns 단위
+inline std::int64_t FileTimeToNs(const FILETIME& t)
+{
+	return static_cast<std::int64_t>((static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime) * 100;
+}
+#else
+inline ProcessUsage UsageFromRusage(const rusage& usage)
+{
+	ProcessUsage u;
+	u.userNs = static_cast<std::int64_t>(usage.ru_utime.tv_sec) * 1000000000 + usage.ru_utime.tv_usec * 1000;
+	u.sysNs = static_cast<std::int64_t>(usage.ru_stime.tv_sec) * 1000000000 + usage.ru_stime.tv_usec * 1000;
+	u.voluntaryCs = usage.ru_nvcsw;
+	u.involuntaryCs = usage.ru_nivcsw;
+	return u;
+}
+#endif
+
+inline ProcessUsage ReadProcessUsage()
+{
+	ProcessUsage u;
+#if defined(_WIN32)
+	FILETIME creation{};
+	FILETIME exit{};
+	FILETIME kernel{};
+	FILETIME user{};
+	if (::GetProcessTimes(::GetCurrentProcess(), &creation, &exit, &kernel, &user))
+	{
+		u.userNs = FileTimeToNs(user);
+		u.sysNs = FileTimeToNs(kernel);
+	}
+#else
+	rusage usage{};
+	if (::getrusage(RUSAGE_SELF, &usage) == 0)
+		u = UsageFromRusage(usage);
+#endif
+	return u;
+}
+
+// after - before. 한쪽이라도 문맥 교환 횟수를 모르면 -1 로 둡니다.
+inline ProcessUsage UsageDelta(const ProcessUsage& before, const ProcessUsage& after)
+{
+	ProcessUsage d;
+	d.userNs = after.userNs - before.userNs;
+	d.sysNs = after.sysNs - before.sysNs;
+	if (before.voluntaryCs >= 0 && after.voluntaryCs >= 0)
+	{
+		d.voluntaryCs = after.voluntaryCs - before.voluntaryCs;
+		d.involuntaryCs = after.involuntaryCs - before.involuntaryCs;
+	}
+	return d;
+}
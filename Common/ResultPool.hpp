@@ -0,0 +1,320 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 재사용하는 결과 슬롯 풀
+//
+// std::promise / Promise<T> 는 결과마다 shared state 를 힙에 만들고, WinAPI 버전은 결과마다 Event 를 만들고 닫습니다.
+// 결과가 초당 수천 ~ 수백만 개면 그 할당 / 커널 객체 생성이 계산보다 비싸집니다.
+// ResultPool 은 shared state(결과 슬롯)를 미리 만들어 두고 빌려 줬다가 돌려받습니다.
+//
+// 슬롯 (ResultSlot)
+// - 값(optional<T>) / 예외 / 대기 워드를 캐시 라인 하나 이상에 담습니다. (인접 슬롯과 false sharing 없음)
+// - 대기 워드는 Future.hpp 의 FutureState 와 같은 규칙입니다. kReady 를 마지막에 세우고(release), 기다리는 쪽은
+//   짧게 스핀한 뒤 kWaiting 을 세우고 워드에서 잠듭니다. (Futex.hpp: Linux futex, Windows WaitOnAddress)
+// - 참조 수 2 (promise 쪽 1 + future 쪽 1). 둘 다 손을 떼면 마지막 쪽이 슬롯을 비우고 풀에 돌려줍니다.
+//
+// 빈 슬롯 목록 (freelist)
+// - Treiber 스택입니다. head 는 64비트 워드 하나에 {태그 32비트, 슬롯 번호 32비트}를 담고 CAS 로 바꿉니다.
+// - 꺼낼 때마다 태그를 올리므로, 다른 스레드가 같은 슬롯을 꺼냈다 돌려놓아도(ABA) 오래된 CAS 는 실패합니다.
+// - 슬롯이 모두 나가 있으면 Acquire 는 releases_ 워드에서 잠들고, 돌려주는 쪽은 기다리는 스레드가 있을 때만 깨웁니다.
+//
+//   ResultPool<long long> pool(1024);              // 할당은 여기서 한 번
+//   PooledPromise<long long> promise = pool.Acquire();
+//   PooledFuture<long long> future = promise.GetFuture();
+//   (워커) promise.SetValue(sum);                  // promise 는 여기서 슬롯을 놓음
+//   (메인) long long v = future.Get();             // 마지막으로 놓는 쪽이 슬롯을 풀에 돌려줌
+//
+// std::promise 와 같은 규칙
+// - GetFuture / Get 은 한 번만 호출할 수 있습니다.
+// - 값을 채우지 않고 PooledPromise 가 소멸하면 future_error(broken_promise) 가 전달됩니다. (이 경로만 할당함)
+// - 풀은 빌려 준 슬롯보다 오래 살아야 합니다.
+
+#include "CacheLine.hpp"
+#include "Futex.hpp"
+#include "Platform.hpp" // CpuRelax, SpinWaitUseful
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future> // std::future_error
+#include <memory>
+#include <optional>
+#include <utility>
+
+template <typename T>
+class ResultPool;
+template <typename T>
+class PooledPromise;
+template <typename T>
+class PooledFuture;
+
+template <typename T>
+class alignas(kCacheLineSize) ResultSlot
+{
+public:
+	static constexpr std::uint32_t kReady = 1u << 0;
+	static constexpr std::uint32_t kWaiting = 1u << 1;
+	static constexpr int kSpinCount = 128;
+
+	bool IsReady() const { return (state_.load(std::memory_order_acquire) & kReady) != 0; }
+
+	void Wait()
+	{
+		const int spins = SpinWaitUseful() ? kSpinCount : 0;
+		for (int i = 0; i < spins; ++i)
+		{
+			if (IsReady())
+				return;
+			CpuRelax();
+		}
+
+		std::uint32_t s = state_.load(std::memory_order_acquire);
+		while ((s & kReady) == 0)
+		{
+			if ((s & kWaiting) == 0)
+			{
+				if (!state_.compare_exchange_weak(s, s | kWaiting, std::memory_order_acq_rel, std::memory_order_acquire))
+					continue;
+				s |= kWaiting;
+			}
+			FutexWait(&state_, s);
+			s = state_.load(std::memory_order_acquire);
+		}
+	}
+
+private:
+	friend class ResultPool<T>;
+	friend class PooledPromise<T>;
+	friend class PooledFuture<T>;
+
+	void Publish()
+	{
+		const std::uint32_t old = state_.fetch_or(kReady, std::memory_order_acq_rel);
+		if (old & kWaiting)
+			FutexWakeAll(&state_);
+	}
+
+	// 마지막으로 놓는 쪽이 슬롯을 풀에 돌려줍니다.
+	void Drop()
+	{
+		if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			pool_->Recycle(this);
+	}
+
+	FutexWord state_{ 0 };
+	std::atomic<std::uint32_t> refs_{ 0 };
+	std::atomic<std::uint32_t> next_{ 0 }; // freelist 에서 다음 빈 슬롯 번호
+	ResultPool<T>* pool_ = nullptr;
+	std::optional<T> value_;
+	std::exception_ptr error_;
+};
+
+// 워커(결과를 채우는 쪽) 핸들. SetValue / SetException 뒤에는 슬롯을 놓고 빈 핸들이 됩니다.
+template <typename T>
+class PooledPromise
+{
+public:
+	PooledPromise() = default;
+	PooledPromise(PooledPromise&& other) noexcept : slot_(std::exchange(other.slot_, nullptr)) {}
+	PooledPromise& operator=(PooledPromise&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Abandon();
+			slot_ = std::exchange(other.slot_, nullptr);
+		}
+		return *this;
+	}
+	PooledPromise(const PooledPromise&) = delete;
+	PooledPromise& operator=(const PooledPromise&) = delete;
+	~PooledPromise() { Abandon(); }
+
+	bool Valid() const { return slot_ != nullptr; }
+
+	PooledFuture<T> GetFuture()
+	{
+		slot_->refs_.fetch_add(1, std::memory_order_relaxed);
+		return PooledFuture<T>(slot_);
+	}
+
+	template <typename... Args>
+	void SetValue(Args&&... args)
+	{
+		ResultSlot<T>* slot = std::exchange(slot_, nullptr);
+		slot->value_.emplace(std::forward<Args>(args)...);
+		slot->Publish();
+		slot->Drop();
+	}
+
+	void SetException(std::exception_ptr error)
+	{
+		ResultSlot<T>* slot = std::exchange(slot_, nullptr);
+		slot->error_ = std::move(error);
+		slot->Publish();
+		slot->Drop();
+	}
+
+private:
+	friend class ResultPool<T>;
+	explicit PooledPromise(ResultSlot<T>* slot) : slot_(slot) {}
+
+	void Abandon()
+	{
+		if (slot_ != nullptr)
+			SetException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+	}
+
+	ResultSlot<T>* slot_ = nullptr;
+};
+
+// 결과를 받는 쪽 핸들. Get 뒤에는 슬롯을 놓고 빈 핸들이 됩니다. (std::future::get 과 같음)
+template <typename T>
+class PooledFuture
+{
+public:
+	PooledFuture() = default;
+	PooledFuture(PooledFuture&& other) noexcept : slot_(std::exchange(other.slot_, nullptr)) {}
+	PooledFuture& operator=(PooledFuture&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (slot_ != nullptr)
+				slot_->Drop();
+			slot_ = std::exchange(other.slot_, nullptr);
+		}
+		return *this;
+	}
+	PooledFuture(const PooledFuture&) = delete;
+	PooledFuture& operator=(const PooledFuture&) = delete;
+	~PooledFuture()
+	{
+		if (slot_ != nullptr)
+			slot_->Drop();
+	}
+
+	bool Valid() const { return slot_ != nullptr; }
+	bool IsReady() const { return slot_ != nullptr && slot_->IsReady(); }
+	void Wait() const { slot_->Wait(); }
+
+	// 값을 꺼내고 슬롯을 놓은 뒤 돌려줍니다. 예외면 슬롯을 놓은 뒤 다시 throw 합니다.
+	T Get()
+	{
+		ResultSlot<T>* slot = std::exchange(slot_, nullptr);
+		slot->Wait();
+		std::exception_ptr error = slot->error_;
+		if (error)
+		{
+			slot->Drop();
+			std::rethrow_exception(error);
+		}
+		T value = std::move(*slot->value_);
+		slot->Drop();
+		return value;
+	}
+
+private:
+	friend class PooledPromise<T>;
+	explicit PooledFuture(ResultSlot<T>* slot) : slot_(slot) {}
+
+	ResultSlot<T>* slot_ = nullptr;
+};
+
+template <typename T>
+class ResultPool
+{
+public:
+	explicit ResultPool(std::size_t capacity)
+		: capacity_(capacity < 1 ? 1 : static_cast<std::uint32_t>(capacity)),
+		  slots_(std::make_unique<ResultSlot<T>[]>(capacity_))
+	{
+		for (std::uint32_t i = 0; i < capacity_; ++i)
+		{
+			slots_[i].pool_ = this;
+			slots_[i].next_.store(i + 1 < capacity_ ? i + 1 : kNil, std::memory_order_relaxed);
+		}
+		head_.store(0, std::memory_order_release);
+	}
+
+	ResultPool(const ResultPool&) = delete;
+	ResultPool& operator=(const ResultPool&) = delete;
+
+	std::size_t Capacity() const { return capacity_; }
+
+	// 빈 슬롯이 없으면 빈 핸들(Valid() == false)
+	PooledPromise<T> TryAcquire()
+	{
+		ResultSlot<T>* slot = PopFree();
+		if (slot == nullptr)
+			return PooledPromise<T>();
+		slot->refs_.store(1, std::memory_order_relaxed);
+		return PooledPromise<T>(slot);
+	}
+
+	// 빈 슬롯이 생길 때까지 기다립니다.
+	PooledPromise<T> Acquire()
+	{
+		while (true)
+		{
+			PooledPromise<T> promise = TryAcquire();
+			if (promise.Valid())
+				return promise;
+			const std::uint32_t released = releases_.load(std::memory_order_acquire);
+			promise = TryAcquire();
+			if (promise.Valid())
+				return promise;
+			waiters_.fetch_add(1, std::memory_order_seq_cst);
+			FutexWait(&releases_, released);
+			waiters_.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	friend class ResultSlot<T>;
+
+	static constexpr std::uint32_t kNil = UINT32_MAX;
+
+	static std::uint64_t Pack(std::uint64_t tag, std::uint32_t index) { return (tag << 32) | index; }
+
+	ResultSlot<T>* PopFree()
+	{
+		std::uint64_t head = head_.load(std::memory_order_acquire);
+		while (true)
+		{
+			const std::uint32_t index = static_cast<std::uint32_t>(head);
+			if (index == kNil)
+				return nullptr;
+			// 다른 스레드가 이 슬롯을 먼저 꺼내 next_ 가 바뀌었어도, 그때는 태그가 달라 CAS 가 실패합니다.
+			const std::uint32_t next = slots_[index].next_.load(std::memory_order_relaxed);
+			if (head_.compare_exchange_weak(head, Pack((head >> 32) + 1, next), std::memory_order_acquire, std::memory_order_acquire))
+				return &slots_[index];
+		}
+	}
+
+	void PushFree(ResultSlot<T>* slot)
+	{
+		const std::uint32_t index = static_cast<std::uint32_t>(slot - slots_.get());
+		std::uint64_t head = head_.load(std::memory_order_relaxed);
+		do
+		{
+			slot->next_.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+		} while (!head_.compare_exchange_weak(head, Pack((head >> 32) + 1, index), std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// 슬롯을 비우고 freelist 에 돌려놓습니다. 비우기는 PushFree 의 release 로 다음에 꺼내는 스레드에 보입니다.
+	void Recycle(ResultSlot<T>* slot)
+	{
+		slot->value_.reset();
+		slot->error_ = nullptr;
+		slot->state_.store(0, std::memory_order_relaxed);
+		PushFree(slot);
+		releases_.fetch_add(1, std::memory_order_seq_cst);
+		if (waiters_.load(std::memory_order_seq_cst) > 0)
+			FutexWakeOne(&releases_);
+	}
+
+	const std::uint32_t capacity_;
+	std::unique_ptr<ResultSlot<T>[]> slots_;
+	alignas(kCacheLineSize) std::atomic<std::uint64_t> head_{ 0 };
+	alignas(kCacheLineSize) FutexWord releases_{ 0 }; // 슬롯을 돌려줄 때마다 올림 (Acquire 대기용)
+	std::atomic<std::uint32_t> waiters_{ 0 };
+};
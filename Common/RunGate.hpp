@@ -0,0 +1,98 @@
+#pragma once
+
+// ThreadLab 공용 코어 - RunGate (실행 / 일시정지 / 종료 게이트)
+//
+// 03_SignalWaiting 의 TickTockWorker 처럼 "평소에는 계속 돌고, 가끔 멈추는" 워커용 게이트입니다.
+// condition_variable 버전은 멈출 일이 없어도 반복마다 mutex 를 잡고 조건을 검사하지만,
+// RunGate 는 실행 중이면 atomic load 한 번으로 통과합니다.
+//
+//   상태 워드 (32bit)
+//   - kRunning : 통과
+//   - kPaused  : 대기 (kParkedBit 가 붙어 있으면 잠든 워커가 있음)
+//   - kExit    : 종료. 한 번 들어가면 Pause / Resume 으로 되돌릴 수 없습니다.
+//
+// 잠들기 / 깨우기는 주소 기반 대기(Futex.hpp: Linux futex, Windows WaitOnAddress)를 직접 사용합니다.
+// Resume / RequestExit 은 잠든 워커가 있을 때(kParkedBit)만 시스템 콜을 호출합니다.
+
+#include "Futex.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+class RunGate
+{
+public:
+	static constexpr std::uint32_t kRunning = 0;
+	static constexpr std::uint32_t kPaused = 1;
+	static constexpr std::uint32_t kExit = 2;
+	static constexpr std::uint32_t kParkedBit = 4;
+
+	explicit RunGate(bool startPaused = false) : state_(startPaused ? kPaused : kRunning) {}
+
+	RunGate(const RunGate&) = delete;
+	RunGate& operator=(const RunGate&) = delete;
+
+	// 워커가 반복마다 호출: 실행 중이면 true, 종료 요청이면 false. 일시정지 중이면 풀릴 때까지 잠듭니다.
+	bool Pass()
+	{
+		if (state_.load(std::memory_order_acquire) == kRunning)
+			return true;
+		return PassSlow();
+	}
+
+	void Pause()
+	{
+		std::uint32_t expected = kRunning;
+		state_.compare_exchange_strong(expected, kPaused, std::memory_order_acq_rel);
+	}
+
+	void Resume()
+	{
+		std::uint32_t s = state_.load(std::memory_order_relaxed);
+		while (s != kExit && s != kRunning)
+		{
+			if (state_.compare_exchange_weak(s, kRunning, std::memory_order_acq_rel))
+			{
+				if (s & kParkedBit)
+					FutexWakeAll(&state_);
+				return;
+			}
+		}
+	}
+
+	void RequestExit()
+	{
+		if (state_.exchange(kExit, std::memory_order_acq_rel) & kParkedBit)
+			FutexWakeAll(&state_);
+	}
+
+	bool IsPaused() const { return (state_.load(std::memory_order_acquire) & ~kParkedBit) == kPaused; }
+	bool ExitRequested() const { return state_.load(std::memory_order_acquire) == kExit; }
+	// 일시정지 중 잠든(또는 잠들려는) 워커가 있는지 - 측정용
+	bool Parked() const { return (state_.load(std::memory_order_acquire) & kParkedBit) != 0; }
+
+private:
+	bool PassSlow()
+	{
+		while (true)
+		{
+			std::uint32_t s = state_.load(std::memory_order_acquire);
+			if (s == kRunning)
+				return true;
+			if (s == kExit)
+				return false;
+
+			// 잠들기 전에 kParkedBit 를 남겨야 Resume 쪽이 깨우기를 건너뛰지 않습니다.
+			if (!(s & kParkedBit))
+			{
+				if (!state_.compare_exchange_weak(s, s | kParkedBit, std::memory_order_acq_rel))
+					continue;
+				s |= kParkedBit;
+			}
+			// 그 사이 값이 바뀌었으면 커널이 바로 돌려보냅니다. (spurious wakeup 도 루프에서 다시 검사)
+			FutexWait(&state_, s);
+		}
+	}
+
+	FutexWord state_;
+};
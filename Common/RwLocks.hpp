@@ -0,0 +1,204 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 읽기 위주(read-mostly) 공유 상태용 동기화
+//
+// - RwSpinLock    : 쓰기 우선 reader-writer 스핀락. 쓰기 대기자가 있으면 새 읽기를 막아 writer 기아를 방지
+// - SeqLock<T>    : 읽기는 락 없이 복사 후 시퀀스 번호로 검증(바뀌었으면 재시도), 쓰기만 직렬화
+// - BigReaderLock : CPU 마다 읽기 카운터를 따로 둔 RW 락 (Linux 커널 brlock 방식).
+//                   읽기는 자기 CPU 슬롯만 건드리므로 읽기끼리 캐시 라인을 공유하지 않고, 쓰기는 모든 슬롯을 확인합니다.
+//
+// RwSpinLock / BigReaderLock 은 std::shared_mutex 와 같은 lock / unlock / lock_shared / unlock_shared 를 가지므로
+// std::shared_lock / std::unique_lock 에 그대로 넣을 수 있습니다.
+
+#include "CacheLine.hpp"
+#include "Locks.hpp" // SpinBackoff, TtasSpinLock
+#include "Platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+class RwSpinLock
+{
+public:
+	void lock_shared()
+	{
+		SpinBackoff backoff;
+		while (true)
+		{
+			std::uint32_t s = state_.load(std::memory_order_relaxed);
+			// 쓰기 중이거나 쓰기 대기자가 있으면 새 읽기는 들어가지 않습니다. (쓰기 우선)
+			if ((s & (kWriter | kWriterWaiting)) == 0 &&
+				state_.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed))
+				return;
+			backoff.Pause();
+		}
+	}
+
+	void unlock_shared() { state_.fetch_sub(1, std::memory_order_release); }
+
+	void lock()
+	{
+		SpinBackoff backoff;
+		while (true)
+		{
+			std::uint32_t s = state_.load(std::memory_order_relaxed);
+			if ((s & ~kWriterWaiting) == 0)
+			{
+				// 읽기도 쓰기도 없음: kWriterWaiting 을 지우고 잡습니다. (다른 대기 writer 는 다음 루프에서 다시 세움)
+				if (state_.compare_exchange_weak(s, kWriter, std::memory_order_acquire, std::memory_order_relaxed))
+					return;
+				continue;
+			}
+			if ((s & kWriterWaiting) == 0)
+				state_.fetch_or(kWriterWaiting, std::memory_order_relaxed);
+			backoff.Pause();
+		}
+	}
+
+	void unlock() { state_.fetch_and(~kWriter, std::memory_order_release); }
+
+private:
+	static constexpr std::uint32_t kWriter = 1u << 31;
+	static constexpr std::uint32_t kWriterWaiting = 1u << 30;
+
+	// 하위 비트: 읽기 중인 스레드 수
+	std::atomic<std::uint32_t> state_{ 0 };
+};
+
+// 시퀀스 락
+// - 쓰기: 번호를 홀수로 만들고 -> 값 기록 -> 짝수로 되돌림. 쓰기끼리는 내부 스핀락으로 직렬화합니다.
+// - 읽기: 짝수 번호를 읽고 -> 값 복사 -> 번호가 그대로면 성공, 아니면 다시 읽습니다. 읽기는 공유 메모리에 쓰지 않습니다.
+// 값은 8바이트 atomic 워드로 나눠 저장해서, 쓰기와 겹친 읽기도 (결과는 버리지만) 데이터 레이스가 되지 않게 합니다.
+template <typename T>
+class SeqLock
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SeqLock<T> copies T word by word");
+
+public:
+	T Read() const
+	{
+		T out;
+		SpinBackoff backoff;
+		while (true)
+		{
+			const std::uint32_t before = seq_.load(std::memory_order_acquire);
+			if (before & 1)
+			{
+				backoff.Pause(); // 쓰기 중
+				continue;
+			}
+			std::uint64_t buffer[kWords];
+			for (std::size_t i = 0; i < kWords; ++i)
+				buffer[i] = words_[i].load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (seq_.load(std::memory_order_relaxed) == before)
+			{
+				std::memcpy(&out, buffer, sizeof(T));
+				return out;
+			}
+		}
+	}
+
+	// f(T&) 로 현재 값을 고칩니다.
+	template <typename F>
+	void Write(F&& f)
+	{
+		std::lock_guard<TtasSpinLock> guard(writer_);
+		T value = Load();
+		f(value);
+
+		const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+		seq_.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::uint64_t buffer[kWords] = {};
+		std::memcpy(buffer, &value, sizeof(T));
+		for (std::size_t i = 0; i < kWords; ++i)
+			words_[i].store(buffer[i], std::memory_order_relaxed);
+		seq_.store(seq + 2, std::memory_order_release);
+	}
+
+private:
+	static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+	// writer_ 를 잡은 쓰기 쪽에서만 호출 (다른 쓰기가 없으므로 재시도 불필요)
+	T Load() const
+	{
+		std::uint64_t buffer[kWords];
+		for (std::size_t i = 0; i < kWords; ++i)
+			buffer[i] = words_[i].load(std::memory_order_relaxed);
+		T out;
+		std::memcpy(&out, buffer, sizeof(T));
+		return out;
+	}
+
+	alignas(kCacheLineSize) std::atomic<std::uint32_t> seq_{ 0 };
+	std::atomic<std::uint64_t> words_[kWords] = {};
+	TtasSpinLock writer_;
+};
+
+// CPU 별 읽기 카운터 RW 락 ("big reader" lock)
+// - lock_shared  : 현재 CPU 슬롯의 카운터 +1, 쓰기 중이면 되돌리고 기다림
+// - lock         : 쓰기 플래그를 세우고 모든 슬롯의 카운터가 0 이 될 때까지 기다림
+// 유저 공간에서는 읽는 도중 다른 CPU 로 옮겨질 수 있으므로, 잡은 슬롯을 스레드 로컬에 기억했다가 그 슬롯을 풉니다.
+// (그래서 한 스레드가 BigReaderLock 읽기를 중첩해서 잡을 수는 없습니다.)
+// 읽기 쪽 "카운터 +1 -> 쓰기 플래그 확인" 과 쓰기 쪽 "플래그 세우기 -> 카운터 확인" 이 서로를 보도록 seq_cst 를 사용합니다.
+class BigReaderLock
+{
+public:
+	BigReaderLock()
+		: slotCount_(std::max(1u, std::thread::hardware_concurrency())),
+		  readers_(std::make_unique<CacheLinePadded<std::atomic<int>>[]>(slotCount_))
+	{
+	}
+
+	void lock_shared()
+	{
+		const unsigned slot = CurrentCpu() % slotCount_;
+		std::atomic<int>& counter = readers_[slot].value;
+		while (true)
+		{
+			counter.fetch_add(1, std::memory_order_seq_cst);
+			if (!writer_.load(std::memory_order_seq_cst))
+				break;
+			counter.fetch_sub(1, std::memory_order_relaxed);
+			SpinBackoff backoff;
+			while (writer_.load(std::memory_order_relaxed))
+				backoff.Pause();
+		}
+		HeldSlot() = slot;
+	}
+
+	void unlock_shared() { readers_[HeldSlot()].value.fetch_sub(1, std::memory_order_release); }
+
+	void lock()
+	{
+		SpinBackoff backoff;
+		while (writer_.exchange(true, std::memory_order_seq_cst))
+			backoff.Pause();
+		for (unsigned i = 0; i < slotCount_; ++i)
+		{
+			backoff.Reset();
+			while (readers_[i].value.load(std::memory_order_seq_cst) != 0)
+				backoff.Pause();
+		}
+	}
+
+	void unlock() { writer_.store(false, std::memory_order_release); }
+
+private:
+	static unsigned& HeldSlot()
+	{
+		thread_local unsigned slot = 0;
+		return slot;
+	}
+
+	const unsigned slotCount_;
+	std::unique_ptr<CacheLinePadded<std::atomic<int>>[]> readers_;
+	alignas(kCacheLineSize) std::atomic<bool> writer_{ false };
+};
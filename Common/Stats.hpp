@@ -0,0 +1,57 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 측정값 요약 (지연 시간 분포 등)
+//
+// 샘플을 모아 두었다가 min / median / p99 / max / mean 을 계산합니다.
+// 정렬 기반이므로 측정 구간 밖(측정이 끝난 뒤)에서 호출합니다.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct LatencySummary
+{
+	std::size_t count = 0;
+	std::int64_t min = 0;
+	std::int64_t p50 = 0;
+	std::int64_t p90 = 0;
+	std::int64_t p99 = 0;
+	std::int64_t p999 = 0;
+	std::int64_t max = 0;
+	double mean = 0.0;
+};
+
+// 정렬된 샘플에서 q (0.0 ~ 1.0) 분위수 (nearest-rank)
+inline std::int64_t PercentileSorted(const std::vector<std::int64_t>& sorted, double q)
+{
+	if (sorted.empty())
+		return 0;
+	std::size_t rank = static_cast<std::size_t>(q * static_cast<double>(sorted.size()));
+	if (rank >= sorted.size())
+		rank = sorted.size() - 1;
+	return sorted[rank];
+}
+
+// samples 는 정렬됩니다.
+inline LatencySummary Summarize(std::vector<std::int64_t>& samples)
+{
+	LatencySummary s;
+	if (samples.empty())
+		return s;
+
+	std::sort(samples.begin(), samples.end());
+	double sum = 0.0;
+	for (std::int64_t v : samples)
+		sum += static_cast<double>(v);
+
+	s.count = samples.size();
+	s.min = samples.front();
+	s.p50 = PercentileSorted(samples, 0.50);
+	s.p90 = PercentileSorted(samples, 0.90);
+	s.p99 = PercentileSorted(samples, 0.99);
+	s.p999 = PercentileSorted(samples, 0.999);
+	s.max = samples.back();
+	s.mean = sum / static_cast<double>(samples.size());
+	return s;
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 스레드 속성 (CPU affinity, NUMA 노드, 우선순위, 이름)
+//
+// 스레드를 만드는 API(std::thread, _beginthreadex, 풀 워커)와 관계없이 쓰도록,
+// 속성은 "새 스레드가 자기 자신에게 맨 처음 적용"합니다.
+//
+//   ThreadAttributes attrs = ParseThreadAttributes(cli);   // cpus=0-3 spread=1 node=0 priority=high name=acc
+//   std::thread th([&] { ApplyThreadAttributes(attrs, index); Work(); });
+//
+// - cpus     : 실행을 허용할 논리 CPU 목록. spread 면 index 번째 스레드를 cpus[index % n] 하나에 고정
+// - numaNode : cpus 가 비어 있으면 그 노드의 CPU 들로 제한합니다. 메모리는 first-touch 정책에 따라
+//              고정된 스레드가 처음 쓰는 페이지가 그 노드에 잡힙니다. (libnuma 없이 동작)
+//              노드 → CPU 목록은 ParseThreadAttributes 에서 한 번 읽어 cpus 에 넣어 둡니다. (스레드마다 sysfs 를 읽지 않음)
+// - priority : Windows THREAD_PRIORITY_* / Linux nice (-10 ~ 10). 높이기는 권한이 필요할 수 있습니다.
+// - name     : 디버거 / top -H / perf 에 보이는 이름 (Linux 는 15자). 여러 스레드면 뒤에 index 를 붙입니다.
+//
+// Windows 는 프로세서 그룹 0 (논리 CPU 64개 이하)만 다룹니다.
+
+#include "Args.hpp"
+#include "Platform.hpp"
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum class ThreadPriority
+{
+	Lowest,
+	Low,
+	Normal,
+	High,
+	Highest,
+};
+
+inline const char* ThreadPriorityName(ThreadPriority p)
+{
+	switch (p)
+	{
+	case ThreadPriority::Lowest:  return "lowest";
+	case ThreadPriority::Low:     return "low";
+	case ThreadPriority::Normal:  return "normal";
+	case ThreadPriority::High:    return "high";
+	case ThreadPriority::Highest: return "highest";
+	}
+	return "?";
+}
+
+inline bool ParseThreadPriority(const std::string& name, ThreadPriority* out)
+{
+	for (ThreadPriority p : { ThreadPriority::Lowest, ThreadPriority::Low, ThreadPriority::Normal, ThreadPriority::High, ThreadPriority::Highest })
+	{
+		if (name == ThreadPriorityName(p))
+		{
+			*out = p;
+			return true;
+		}
+	}
+	return false;
+}
+
+struct ThreadAttributes
+{
+	std::vector<unsigned> cpus;
+	bool spread = false;
+	int numaNode = -1;
+	ThreadPriority priority = ThreadPriority::Normal;
+	std::string name;
+
+	bool IsDefault() const { return cpus.empty() && numaNode < 0 && priority == ThreadPriority::Normal && name.empty(); }
+};
+
+// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+inline std::vector<unsigned> ParseCpuList(const std::string& text)
+{
+	std::vector<unsigned> out;
+	std::stringstream ss(text);
+	std::string item;
+	while (std::getline(ss, item, ','))
+	{
+		if (item.empty() || item[0] < '0' || item[0] > '9')
+			continue;
+		const std::size_t dash = item.find('-');
+		const unsigned first = static_cast<unsigned>(std::strtoul(item.c_str(), nullptr, 10));
+		const unsigned last = dash == std::string::npos ? first : static_cast<unsigned>(std::strtoul(item.c_str() + dash + 1, nullptr, 10));
+		for (unsigned cpu = first; cpu <= last; ++cpu)
+			out.push_back(cpu);
+	}
+	return out;
+}
+
+// 논리 CPU 하나의 위치
+struct CpuInfo
+{
+	unsigned cpu = 0;
+	int core = 0;    // 같은 값이면 같은 물리 코어 (SMT 형제)
+	int package = 0; // 소켓
+	int node = 0;    // NUMA 노드
+};
+
+#if !defined(_WIN32)
+inline bool ReadSysfsText(const std::string& path, std::string* out)
+{
+	std::FILE* f = std::fopen(path.c_str(), "r");
+	if (!f)
+		return false;
+	char buf[4096];
+	const std::size_t n = std::fread(buf, 1, sizeof(buf) - 1, f);
+	std::fclose(f);
+	buf[n] = '\0';
+	*out = buf;
+	return true;
+}
+
+inline int ReadSysfsInt(const std::string& path, int fallback)
+{
+	std::string text;
+	return ReadSysfsText(path, &text) ? std::atoi(text.c_str()) : fallback;
+}
+#endif
+
+// 이 프로세스가 쓸 수 있는 논리 CPU 들의 코어 / 소켓 / NUMA 노드
+inline std::vector<CpuInfo> ReadCpuTopology()
+{
+	std::vector<CpuInfo> out;
+#if defined(_WIN32)
+	DWORD_PTR processMask = 0;
+	DWORD_PTR systemMask = 0;
+	::GetProcessAffinityMask(::GetCurrentProcess(), &processMask, &systemMask);
+
+	DWORD bytes = 0;
+	::GetLogicalProcessorInformation(nullptr, &bytes);
+	std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(bytes / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+	if (info.empty() || !::GetLogicalProcessorInformation(info.data(), &bytes))
+		return out;
+
+	constexpr unsigned kMaskBits = sizeof(DWORD_PTR) * 8;
+	std::vector<CpuInfo> all(kMaskBits);
+	int coreIndex = 0;
+	int packageIndex = 0;
+	for (const auto& entry : info)
+	{
+		for (unsigned cpu = 0; cpu < kMaskBits; ++cpu)
+		{
+			if ((entry.ProcessorMask & (static_cast<DWORD_PTR>(1) << cpu)) == 0)
+				continue;
+			all[cpu].cpu = cpu;
+			if (entry.Relationship == RelationProcessorCore)
+				all[cpu].core = coreIndex;
+			else if (entry.Relationship == RelationProcessorPackage)
+				all[cpu].package = packageIndex;
+			else if (entry.Relationship == RelationNumaNode)
+				all[cpu].node = static_cast<int>(entry.NumaNode.NodeNumber);
+		}
+		if (entry.Relationship == RelationProcessorCore)
+			++coreIndex;
+		else if (entry.Relationship == RelationProcessorPackage)
+			++packageIndex;
+	}
+	for (unsigned cpu = 0; cpu < kMaskBits; ++cpu)
+	{
+		if (processMask & (static_cast<DWORD_PTR>(1) << cpu))
+			out.push_back(all[cpu]);
+	}
+#else
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+		return out;
+
+	std::vector<int> nodeOf(CPU_SETSIZE, 0);
+	for (int node = 0; node < 1024; ++node)
+	{
+		std::string list;
+		if (!ReadSysfsText("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", &list))
+			break;
+		for (unsigned cpu : ParseCpuList(list))
+		{
+			if (cpu < nodeOf.size())
+				nodeOf[cpu] = node;
+		}
+	}
+
+	for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+	{
+		if (!CPU_ISSET(cpu, &allowed))
+			continue;
+		const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+		CpuInfo c;
+		c.cpu = cpu;
+		c.package = ReadSysfsInt(base + "physical_package_id", 0);
+		// core_id 는 소켓 안에서만 유일하므로 소켓 번호와 묶어서 비교합니다.
+		c.core = c.package * 65536 + ReadSysfsInt(base + "core_id", static_cast<int>(cpu));
+		c.node = nodeOf[cpu];
+		out.push_back(c);
+	}
+#endif
+	return out;
+}
+
+inline std::vector<unsigned> NumaNodeCpus(int node)
+{
+	std::vector<unsigned> out;
+	for (const CpuInfo& c : ReadCpuTopology())
+	{
+		if (c.node == node)
+			out.push_back(c.cpu);
+	}
+	return out;
+}
+
+// 현재 스레드의 이름 (실패해도 동작에는 영향 없음)
+inline bool SetCurrentThreadName(const std::string& name)
+{
+#if defined(_WIN32)
+	std::wstring wide(name.begin(), name.end());
+	return SUCCEEDED(::SetThreadDescription(::GetCurrentThread(), wide.c_str()));
+#else
+	return ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str()) == 0;
+#endif
+}
+
+// 현재 스레드를 cpus 중 하나에서만 실행되게 합니다.
+inline bool PinCurrentThread(const std::vector<unsigned>& cpus)
+{
+	if (cpus.empty())
+		return true;
+#if defined(_WIN32)
+	DWORD_PTR mask = 0;
+	for (unsigned cpu : cpus)
+	{
+		if (cpu < sizeof(DWORD_PTR) * 8)
+			mask |= static_cast<DWORD_PTR>(1) << cpu;
+	}
+	return mask != 0 && ::SetThreadAffinityMask(::GetCurrentThread(), mask) != 0;
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (unsigned cpu : cpus)
+	{
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &set);
+	}
+	return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+inline bool SetCurrentThreadPriority(ThreadPriority priority)
+{
+#if defined(_WIN32)
+	int value = THREAD_PRIORITY_NORMAL;
+	switch (priority)
+	{
+	case ThreadPriority::Lowest:  value = THREAD_PRIORITY_LOWEST; break;
+	case ThreadPriority::Low:     value = THREAD_PRIORITY_BELOW_NORMAL; break;
+	case ThreadPriority::Normal:  value = THREAD_PRIORITY_NORMAL; break;
+	case ThreadPriority::High:    value = THREAD_PRIORITY_ABOVE_NORMAL; break;
+	case ThreadPriority::Highest: value = THREAD_PRIORITY_HIGHEST; break;
+	}
+	return ::SetThreadPriority(::GetCurrentThread(), value) != 0;
+#else
+	// Linux 의 nice 는 스레드(tid) 단위로 적용됩니다.
+	int nice = 0;
+	switch (priority)
+	{
+	case ThreadPriority::Lowest:  nice = 10; break;
+	case ThreadPriority::Low:     nice = 5; break;
+	case ThreadPriority::Normal:  nice = 0; break;
+	case ThreadPriority::High:    nice = -5; break;
+	case ThreadPriority::Highest: nice = -10; break;
+	}
+	return ::setpriority(PRIO_PROCESS, static_cast<id_t>(CurrentThreadId()), nice) == 0;
+#endif
+}
+
+// 새 스레드의 첫 줄에서 호출합니다. index 는 같은 속성으로 만든 스레드들 중 몇 번째인지입니다.
+// 하나라도 적용에 실패하면 false (나머지는 계속 적용)
+inline bool ApplyThreadAttributes(const ThreadAttributes& attrs, unsigned index = 0)
+{
+	if (attrs.IsDefault())
+		return true;
+
+	bool ok = true;
+	const std::vector<unsigned>& cpus = attrs.cpus;
+	if (!cpus.empty())
+	{
+		if (attrs.spread)
+			ok = PinCurrentThread({ cpus[index % cpus.size()] }) && ok;
+		else
+			ok = PinCurrentThread(cpus) && ok;
+	}
+	if (attrs.priority != ThreadPriority::Normal)
+		ok = SetCurrentThreadPriority(attrs.priority) && ok;
+	if (!attrs.name.empty())
+		ok = SetCurrentThreadName(attrs.name + "-" + std::to_string(index)) && ok;
+	return ok;
+}
+
+// 명령줄: cpus=0-3,8 spread=1 node=N priority=lowest|low|normal|high|highest name=prefix
+// 잘못된 priority 는 normal 로, CPU 가 없는 node 는 고정하지 않고 둡니다. (둘 다 stderr 에 경고)
+inline ThreadAttributes ParseThreadAttributes(const LabArgs& cli)
+{
+	ThreadAttributes attrs;
+	attrs.cpus = ParseCpuList(cli.Get("cpus", ""));
+	attrs.spread = cli.GetInt("spread", 0) != 0;
+	attrs.numaNode = static_cast<int>(cli.GetInt("node", -1));
+	if (attrs.cpus.empty() && attrs.numaNode >= 0)
+	{
+		attrs.cpus = NumaNodeCpus(attrs.numaNode);
+		if (attrs.cpus.empty())
+			std::cerr << "warning: node=" << attrs.numaNode << " has no usable cpus, threads are not pinned\n";
+	}
+	const std::string priority = cli.Get("priority", "normal");
+	if (!ParseThreadPriority(priority, &attrs.priority))
+		std::cerr << "warning: unknown priority=" << priority << ", using normal\n";
+	attrs.name = cli.Get("name", "");
+	return attrs;
+}
+
+inline std::string DescribeThreadAttributes(const ThreadAttributes& attrs)
+{
+	if (attrs.IsDefault())
+		return "default";
+	std::string out;
+	if (!attrs.cpus.empty())
+	{
+		out += "cpus=";
+		for (std::size_t i = 0; i < attrs.cpus.size(); ++i)
+		{
+			if (i)
+				out += ',';
+			out += std::to_string(attrs.cpus[i]);
+		}
+		out += attrs.spread ? " (spread) " : " ";
+	}
+	if (attrs.numaNode >= 0)
+		out += "node=" + std::to_string(attrs.numaNode) + " ";
+	if (attrs.priority != ThreadPriority::Normal)
+		out += std::string("priority=") + ThreadPriorityName(attrs.priority) + " ";
+	if (!attrs.name.empty())
+		out += "name=" + attrs.name + " ";
+	out.pop_back();
+	return out;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 고정 크기 워커 풀
+//
+// 목적
+// - 작업(task)마다 스레드를 만들고(join) 버리는 대신, 미리 만든 워커 N개가 작업 큐를 나눠 처리합니다.
+//   - 스레드 생성/소멸 비용과 스택 메모리가 작업 수가 아니라 워커 수에 비례합니다.
+//   - 워커 수를 코어 수(hardware_concurrency)에 맞추면 과도한 문맥 교환(oversubscription)이 없습니다.
+//
+// 구조
+// - 작업 큐 하나(std::deque) + mutex 하나 + condition_variable 두 개
+//   - workAvailable : 큐에 작업이 들어오거나 종료 요청이 있을 때 워커를 깨움
+//   - allDone       : 제출된 작업이 모두 끝났을 때 WaitAll()을 깨움
+//
+// 사용
+//   ThreadPool pool;                 // hardware_concurrency() 개
+//   pool.Submit([] { ... });
+//   pool.WaitAll();                  // 지금까지 제출한 작업이 모두 끝날 때까지 대기
+//   (소멸자에서 남은 작업을 모두 처리한 뒤 워커를 join 합니다.)
+//   ThreadPool pinned(4, attrs);     // 워커 i 가 시작하자마자 ApplyThreadAttributes(attrs, i)
+
+#include "ThreadAttributes.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	// hardware_concurrency()는 알 수 없으면 0을 반환하므로 최소 1개를 보장합니다.
+	static unsigned DefaultThreadCount()
+	{
+		const unsigned n = std::thread::hardware_concurrency();
+		return n == 0 ? 1 : n;
+	}
+
+	explicit ThreadPool(unsigned threadCount = DefaultThreadCount(), const ThreadAttributes& attrs = ThreadAttributes())
+		: attrs_(attrs)
+	{
+		if (threadCount == 0)
+			threadCount = 1;
+		workers_.reserve(threadCount);
+		for (unsigned i = 0; i < threadCount; ++i)
+			workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			stopping_ = true;
+		}
+		workAvailable_.notify_all();
+		for (auto& worker : workers_)
+			worker.join();
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	unsigned Size() const { return static_cast<unsigned>(workers_.size()); }
+
+	void Submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			tasks_.push_back(std::move(task));
+			++pending_;
+		}
+		workAvailable_.notify_one();
+	}
+
+	void WaitAll()
+	{
+		std::unique_lock<std::mutex> lock(m_);
+		allDone_.wait(lock, [&] { return pending_ == 0; });
+	}
+
+private:
+	void WorkerLoop(unsigned index)
+	{
+		ApplyThreadAttributes(attrs_, index);
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_);
+				workAvailable_.wait(lock, [&] { return stopping_ || !tasks_.empty(); });
+				// 종료 요청이 와도 큐에 남은 작업은 끝까지 처리합니다.
+				if (tasks_.empty())
+					return;
+				task = std::move(tasks_.front());
+				tasks_.pop_front();
+			}
+
+			task();
+
+			bool last = false;
+			{
+				std::lock_guard<std::mutex> lock(m_);
+				last = (--pending_ == 0);
+			}
+			if (last)
+				allDone_.notify_all();
+		}
+	}
+
+	std::mutex m_;
+	std::condition_variable workAvailable_;
+	std::condition_variable allDone_;
+	std::deque<std::function<void()>> tasks_;
+	std::size_t pending_ = 0; // 제출됐지만 아직 끝나지 않은 작업 수 (큐 대기 + 실행 중)
+	bool stopping_ = false;
+	const ThreadAttributes attrs_;
+	std::vector<std::thread> workers_;
+};
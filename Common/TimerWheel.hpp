@@ -0,0 +1,433 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 계층형 타이머 휠 (hierarchical timing wheel)
+//
+// TickTockWorker 의 sleep_for(1s) 나 메인 루프의 30ms 폴링처럼 "시간만 기다리는" 스레드를 없애고,
+// 서비스 스레드 하나가 모든 타이머의 콜백을 대신 실행합니다.
+//
+//   TimerWheel wheel;                                          // 1ms tick, 서비스 스레드 1개
+//   TimerId tick = wheel.ScheduleEvery(std::chrono::seconds(1), [](std::int64_t) { ... });
+//   wheel.ScheduleAfter(std::chrono::milliseconds(30), [](std::int64_t dueNs) { ... });
+//   wheel.Cancel(tick);
+//
+// 구조 (Varghese & Lauck, Linux 의 옛 timer wheel 과 같은 방식)
+// - 레벨 4개 x 슬롯 64개. 레벨 L 의 슬롯 하나는 64^L tick 을 덮습니다. (1ms tick 이면 약 4.6시간까지)
+// - 타이머는 만료 tick 과 현재 tick 의 차이가 64 안으로 들어오는 가장 낮은 레벨의 슬롯에 들어갑니다.
+// - 레벨 L 의 슬롯 경계가 오면 그 슬롯의 타이머를 아래 레벨로 다시 넣고(cascade), 레벨 0 슬롯은 그 tick 에 만료됩니다.
+// - 슬롯은 노드 인덱스로 이은 이중 연결 리스트라서 등록 / 취소가 O(1) 입니다. (정렬이나 힙 없음)
+// - 레벨마다 64비트 점유 비트맵을 두어, 다음에 할 일이 있는 tick 을 바로 계산하고 그때까지 잠듭니다.
+//   (빈 tick 마다 깨어나지 않음)
+//
+// 콜백
+// - 서비스 스레드에서 lock 없이 실행합니다. 콜백 안에서 Schedule / Cancel 을 호출해도 됩니다.
+// - 인자 dueNs 는 요청한 시각(NowNs 기준)입니다. NowNs() - dueNs 가 지터(tick 반올림 포함)입니다.
+// - 주기 타이머는 dueNs += period 로 다음 시각을 정하므로 늦게 실행돼도 누적 오차가 쌓이지 않습니다.
+// - 콜백이 오래 걸리면 다른 타이머가 모두 늦어집니다. 무거운 일은 ThreadPool 등에 넘기세요.
+
+#include "Timing.hpp"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 취소용 핸들. generation 이 다르면(이미 끝나 재사용된 노드) 무시됩니다.
+struct TimerId
+{
+	std::uint32_t index = UINT32_MAX;
+	std::uint32_t generation = 0;
+
+	bool Valid() const { return index != UINT32_MAX; }
+};
+
+using TimerCallback = std::function<void(std::int64_t dueNs)>;
+
+class TimerWheel
+{
+public:
+	static constexpr int kLevels = 4;
+	static constexpr int kSlotBits = 6;
+	static constexpr int kSlots = 1 << kSlotBits;
+
+	explicit TimerWheel(std::int64_t tickNs = 1000000)
+		: tickNs_(tickNs > 0 ? tickNs : 1), epochNs_(NowNs())
+	{
+		for (auto& level : heads_)
+			level.fill(kNil);
+		thread_ = std::thread(&TimerWheel::ServiceLoop, this);
+	}
+
+	// 남은 타이머는 실행하지 않고 버립니다.
+	~TimerWheel()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			stopping_ = true;
+		}
+		wake_.notify_one();
+		thread_.join();
+	}
+
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	// dueNs (NowNs 기준) 에 실행. periodNs > 0 이면 그 뒤로 periodNs 마다 반복
+	TimerId ScheduleAtNs(std::int64_t dueNs, std::int64_t periodNs, TimerCallback callback)
+	{
+		TimerId id;
+		bool wake = false;
+		{
+			std::lock_guard<std::mutex> lock(m_);
+			const std::uint32_t index = Allocate();
+			Node& node = nodes_[index];
+			node.dueNs = dueNs;
+			node.periodNs = periodNs;
+			node.callback = std::move(callback);
+			node.cancelled = false;
+			Insert(index);
+			id = TimerId{ index, node.generation };
+			// 서비스 스레드가 이 타이머보다 늦게 깨어날 예정이면 다시 계산하게 합니다.
+			wake = node.expiresTick < sleepingUntilTick_;
+		}
+		if (wake)
+			wake_.notify_one();
+		return id;
+	}
+
+	template <typename Rep, typename Period>
+	TimerId ScheduleAfter(std::chrono::duration<Rep, Period> delay, TimerCallback callback)
+	{
+		return ScheduleAtNs(NowNs() + ToNs(delay), 0, std::move(callback));
+	}
+
+	// 첫 실행은 period 뒤
+	template <typename Rep, typename Period>
+	TimerId ScheduleEvery(std::chrono::duration<Rep, Period> period, TimerCallback callback)
+	{
+		const std::int64_t periodNs = ToNs(period);
+		return ScheduleAtNs(NowNs() + periodNs, periodNs, std::move(callback));
+	}
+
+	// 앞으로의 실행을 막았으면 true. (이미 실행된 단발 타이머, 지난 핸들은 false)
+	// 콜백이 지금 실행 중인 주기 타이머는 이번 콜백이 끝난 뒤 다시 등록되지 않습니다.
+	bool Cancel(TimerId id)
+	{
+		std::lock_guard<std::mutex> lock(m_);
+		if (!id.Valid() || id.index >= nodes_.size())
+			return false;
+		Node& node = nodes_[id.index];
+		if (node.generation != id.generation || node.cancelled)
+			return false;
+		switch (node.state)
+		{
+		case NodeState::Linked:
+			Unlink(id.index);
+			Free(id.index);
+			return true;
+		case NodeState::Due:
+			node.cancelled = true; // 서비스 스레드가 꺼낸 뒤 아직 실행 전
+			return true;
+		case NodeState::Running:
+			node.cancelled = true;
+			return node.periodNs > 0;
+		case NodeState::Free:
+			break;
+		}
+		return false;
+	}
+
+	std::size_t Pending() const
+	{
+		std::lock_guard<std::mutex> lock(m_);
+		return live_;
+	}
+
+	// 서비스 스레드가 깨어난 횟수 (대기 비용 측정용)
+	long long Wakeups() const
+	{
+		std::lock_guard<std::mutex> lock(m_);
+		return wakeups_;
+	}
+
+	std::int64_t TickNs() const { return tickNs_; }
+
+private:
+	static constexpr std::uint32_t kNil = UINT32_MAX;
+	static constexpr std::uint64_t kNoTick = UINT64_MAX;
+
+	enum class NodeState : std::uint8_t
+	{
+		Free,
+		Linked,  // 휠의 슬롯에 있음
+		Due,     // 만료되어 꺼냄, 콜백 실행 전
+		Running, // 콜백 실행 중
+	};
+
+	struct Node
+	{
+		std::uint64_t expiresTick = 0;
+		std::int64_t dueNs = 0;
+		std::int64_t periodNs = 0;
+		std::uint32_t prev = kNil;
+		std::uint32_t next = kNil; // 슬롯 리스트, 또는 free list
+		std::uint32_t generation = 0;
+		std::uint8_t level = 0;
+		std::uint8_t slot = 0;
+		NodeState state = NodeState::Free;
+		bool cancelled = false;
+		TimerCallback callback;
+	};
+
+	template <typename Rep, typename Period>
+	static std::int64_t ToNs(std::chrono::duration<Rep, Period> d)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+	}
+
+	// dueNs 이후의 첫 tick (올림)
+	std::uint64_t TickOf(std::int64_t dueNs) const
+	{
+		const std::int64_t rel = dueNs - epochNs_;
+		return rel <= 0 ? 0 : static_cast<std::uint64_t>((rel + tickNs_ - 1) / tickNs_);
+	}
+
+	std::uint32_t Allocate()
+	{
+		std::uint32_t index = freeHead_;
+		if (index != kNil)
+		{
+			freeHead_ = nodes_[index].next;
+		}
+		else
+		{
+			// deque 는 뒤에 추가해도 기존 원소가 옮겨지지 않으므로, 실행 중인 콜백을 안전하게 가리킬 수 있습니다.
+			index = static_cast<std::uint32_t>(nodes_.size());
+			nodes_.emplace_back();
+		}
+		++live_;
+		return index;
+	}
+
+	void Free(std::uint32_t index)
+	{
+		Node& node = nodes_[index];
+		node.state = NodeState::Free;
+		node.callback = nullptr;
+		++node.generation;
+		node.next = freeHead_;
+		freeHead_ = index;
+		--live_;
+	}
+
+	// 새로 등록하거나 주기 타이머를 다시 넣을 때: 만료 tick 을 계산해 Link 합니다.
+	void Insert(std::uint32_t index)
+	{
+		Node& node = nodes_[index];
+		node.expiresTick = TickOf(node.dueNs);
+		if (node.expiresTick <= currentTick_)
+			node.expiresTick = currentTick_ + 1; // 이미 지났으면 다음 tick 에 실행 (현재 tick 의 슬롯은 이미 처리됨)
+		Link(index);
+	}
+
+	// cascade 로 아래 레벨에 다시 넣을 때: 만료 tick 을 그대로 둡니다.
+	// 지금 처리 중인 tick 에 만료되는 타이머는 레벨 0 의 현재 슬롯에 들어가 같은 ProcessTick 에서 실행됩니다.
+	void Relink(std::uint32_t index)
+	{
+		Node& node = nodes_[index];
+		if (node.expiresTick < currentTick_)
+			node.expiresTick = currentTick_;
+		Link(index);
+	}
+
+	// 만료 tick 과 현재 tick 의 차이가 64 안으로 들어오는 가장 낮은 레벨에 넣습니다.
+	void Link(std::uint32_t index)
+	{
+		Node& node = nodes_[index];
+		int level = 0;
+		while (level < kLevels - 1 && (node.expiresTick >> (kSlotBits * level)) - (currentTick_ >> (kSlotBits * level)) >= kSlots)
+			++level;
+		std::uint64_t slotTick = node.expiresTick >> (kSlotBits * level);
+		// 맨 위 레벨보다 먼 타이머는 가장 늦은 슬롯에 두고, cascade 때 다시 자리를 찾습니다.
+		const std::uint64_t base = currentTick_ >> (kSlotBits * level);
+		if (slotTick - base >= kSlots)
+			slotTick = base + kSlots - 1;
+
+		const std::uint8_t slot = static_cast<std::uint8_t>(slotTick & (kSlots - 1));
+		node.level = static_cast<std::uint8_t>(level);
+		node.slot = slot;
+		node.state = NodeState::Linked;
+		node.prev = kNil;
+		node.next = heads_[level][slot];
+		if (node.next != kNil)
+			nodes_[node.next].prev = index;
+		heads_[level][slot] = index;
+		occupied_[level] |= std::uint64_t{ 1 } << slot;
+	}
+
+	void Unlink(std::uint32_t index)
+	{
+		Node& node = nodes_[index];
+		if (node.prev != kNil)
+			nodes_[node.prev].next = node.next;
+		else
+			heads_[node.level][node.slot] = node.next;
+		if (node.next != kNil)
+			nodes_[node.next].prev = node.prev;
+		if (heads_[node.level][node.slot] == kNil)
+			occupied_[node.level] &= ~(std::uint64_t{ 1 } << node.slot);
+	}
+
+	// 슬롯 전체를 떼어 내 첫 노드를 돌려줍니다.
+	std::uint32_t TakeSlot(int level, int slot)
+	{
+		const std::uint32_t head = heads_[level][slot];
+		heads_[level][slot] = kNil;
+		occupied_[level] &= ~(std::uint64_t{ 1 } << slot);
+		return head;
+	}
+
+	// currentTick_ 다음으로 할 일(레벨 0 만료 또는 위 레벨 cascade)이 있는 tick. 없으면 kNoTick
+	std::uint64_t NextEventTick() const
+	{
+		std::uint64_t best = kNoTick;
+		for (int level = 0; level < kLevels; ++level)
+		{
+			if (occupied_[level] == 0)
+				continue;
+			const int shift = kSlotBits * level;
+			const std::uint64_t base = currentTick_ >> shift;
+			// base + 1 번째 슬롯부터 돌아가며 처음 차 있는 슬롯까지의 거리
+			const int start = static_cast<int>((base + 1) & (kSlots - 1));
+			const std::uint64_t rotated = std::rotr(occupied_[level], start);
+			const std::uint64_t k = static_cast<std::uint64_t>(std::countr_zero(rotated)) + 1;
+			const std::uint64_t tick = (base + k) << shift;
+			if (tick < best)
+				best = tick;
+		}
+		return best;
+	}
+
+	// tick 하나를 처리: 위 레벨부터 경계에 닿은 슬롯을 아래로 내리고, 레벨 0 슬롯의 타이머를 due 로 옮깁니다.
+	void ProcessTick(std::uint64_t tick, std::vector<std::uint32_t>& due)
+	{
+		currentTick_ = tick;
+		for (int level = kLevels - 1; level >= 1; --level)
+		{
+			const int shift = kSlotBits * level;
+			if ((tick & ((std::uint64_t{ 1 } << shift) - 1)) != 0)
+				continue;
+			std::uint32_t index = TakeSlot(level, static_cast<int>((tick >> shift) & (kSlots - 1)));
+			while (index != kNil)
+			{
+				const std::uint32_t next = nodes_[index].next;
+				Relink(index);
+				index = next;
+			}
+		}
+
+		std::uint32_t index = TakeSlot(0, static_cast<int>(tick & (kSlots - 1)));
+		while (index != kNil)
+		{
+			const std::uint32_t next = nodes_[index].next;
+			nodes_[index].state = NodeState::Due;
+			due.push_back(index);
+			index = next;
+		}
+	}
+
+	void RunDue(std::vector<std::uint32_t>& due)
+	{
+		for (std::uint32_t index : due)
+		{
+			Node* node = nullptr;
+			{
+				// deque 의 인덱스 표는 다른 스레드의 emplace_back 이 바꿀 수 있으므로 lock 안에서 찾습니다.
+				std::lock_guard<std::mutex> lock(m_);
+				node = &nodes_[index];
+				if (node->cancelled)
+				{
+					Free(index);
+					continue;
+				}
+				node->state = NodeState::Running;
+			}
+
+			// Running 인 동안 이 노드는 서비스 스레드만 고칩니다. (Cancel 은 cancelled 만 세움)
+			node->callback(node->dueNs);
+
+			std::lock_guard<std::mutex> lock(m_);
+			if (node->periodNs > 0 && !node->cancelled)
+			{
+				node->dueNs += node->periodNs;
+				Insert(index);
+			}
+			else
+			{
+				Free(index);
+			}
+		}
+		due.clear();
+	}
+
+	void ServiceLoop()
+	{
+		std::vector<std::uint32_t> due;
+		std::unique_lock<std::mutex> lock(m_);
+		while (!stopping_)
+		{
+			++wakeups_;
+			const std::int64_t now = NowNs();
+			const std::uint64_t nowTick = now <= epochNs_ ? 0 : static_cast<std::uint64_t>((now - epochNs_) / tickNs_);
+			std::uint64_t next = NextEventTick();
+			while (next <= nowTick)
+			{
+				ProcessTick(next, due);
+				next = NextEventTick();
+			}
+			// 그 사이의 빈 tick 은 건너뜁니다. (할 일이 없으므로 슬롯 배치는 그대로 유효)
+			if (nowTick > currentTick_)
+				currentTick_ = nowTick;
+
+			if (!due.empty())
+			{
+				lock.unlock();
+				RunDue(due);
+				lock.lock();
+				continue;
+			}
+
+			next = NextEventTick();
+			sleepingUntilTick_ = next;
+			if (next == kNoTick)
+				wake_.wait(lock);
+			else
+				wake_.wait_until(lock, LabClock::time_point(std::chrono::duration_cast<LabClock::duration>(
+					std::chrono::nanoseconds(epochNs_ + static_cast<std::int64_t>(next) * tickNs_))));
+			sleepingUntilTick_ = 0; // 깨어 있는 동안에는 Schedule 이 깨우지 않음
+		}
+	}
+
+	const std::int64_t tickNs_;
+	const std::int64_t epochNs_;
+
+	mutable std::mutex m_;
+	std::condition_variable wake_;
+	std::deque<Node> nodes_;
+	std::uint32_t freeHead_ = kNil;
+	std::size_t live_ = 0;
+	std::array<std::array<std::uint32_t, kSlots>, kLevels> heads_{};
+	std::array<std::uint64_t, kLevels> occupied_{};
+	std::uint64_t currentTick_ = 0;
+	std::uint64_t sleepingUntilTick_ = 0;
+	long long wakeups_ = 0;
+	bool stopping_ = false;
+	std::thread thread_;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 시간 측정
+//
+// - 모든 측정은 std::chrono::steady_clock 기준입니다. (시스템 시간 변경의 영향을 받지 않음)
+// - 랩 코드에서는 StopWatch로 구간 시간을 재고, 초/밀리초/나노초 단위로 꺼내 씁니다.
+
+#include <chrono>
+#include <cstdint>
+
+using LabClock = std::chrono::steady_clock;
+
+inline std::int64_t NowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		LabClock::now().time_since_epoch()).count();
+}
+
+class StopWatch
+{
+public:
+	StopWatch() : start_(LabClock::now()) {}
+
+	void Restart() { start_ = LabClock::now(); }
+
+	std::int64_t ElapsedNs() const
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(LabClock::now() - start_).count();
+	}
+
+	double ElapsedMs() const { return static_cast<double>(ElapsedNs()) / 1e6; }
+	double ElapsedSec() const { return static_cast<double>(ElapsedNs()) / 1e9; }
+
+private:
+	LabClock::time_point start_;
+};
@@ -0,0 +1,389 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 스레드별 이벤트 트레이서 (Chrome trace / Perfetto JSON)
+//
+// 랩들은 스레드 시작 / 끝을 std::cout 으로 찍습니다. 스트림 락에서 스레드들이 줄을 서므로 타이밍이 바뀌고,
+// 출력만으로는 누가 언제 실행되고 얼마나 기다렸는지 알 수 없습니다.
+//
+// - 스레드마다 고정 크기 링 버퍼 하나. 기록은 소유 스레드만 하므로 락도 원자 RMW 도 없습니다.
+//   (이벤트 칸을 채운 뒤 head 를 release store)
+// - 이벤트: Begin / End (구간), Instant (순간), Complete (시작 시각 + 길이를 한 번에)
+// - 시각은 NowNs() 의 ns. 이름과 분류는 문자열 리터럴(수명이 프로세스와 같은 포인터)만 받습니다.
+// - 링이 가득 차면 오래된 이벤트부터 덮어씁니다. (비행 기록기) 덮어쓴 개수는 dump 때 출력
+// - 스레드가 끝나면 링에서 쓴 부분만 복사해 보관하고 링을 돌려줍니다.
+// - 꺼져 있으면(기본) 기록 함수는 atomic load 한 번으로 돌아옵니다.
+//
+//   int main(int argc, char** argv)
+//   {
+//       const LabArgs cli(argc, argv);
+//       TraceSession trace(cli);               // trace=out.json 이 있으면 켜고, main 이 끝날 때 JSON 을 씀
+//       ...
+//   }
+//   void Worker()
+//   {
+//       TraceThreadName("worker");
+//       TraceScope scope("Worker", "lifecycle");  // 생성자 Begin, 소멸자 End
+//       TraceInstant("set_value", "result");
+//   }
+//
+// 결과 파일은 chrome://tracing 또는 https://ui.perfetto.dev 에서 엽니다.
+// dump 는 다른 스레드가 기록하지 않을 때(워커 join 이후) 해야 합니다. 살아 있는 풀 워커도 쉬고 있으면 괜찮습니다.
+
+#include "Args.hpp"
+#include "Platform.hpp" // CurrentThreadId
+#include "Timing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 스레드당 링 크기 (이벤트 수). tracebuf=N 으로 바꿈 (2의 거듭제곱으로 올림)
+constexpr std::size_t kTraceDefaultCapacity = 1 << 14;
+// 링 크기 상한 (이벤트 40바이트 기준 스레드당 640MB 예약. 쓰지 않은 페이지는 메모리를 차지하지 않음)
+constexpr std::size_t kTraceMaxCapacity = 1 << 24;
+
+// 초기화하지 않는 타입: 링을 할당할 때 칸을 건드리지 않으므로, 쓰지 않은 페이지는 실제 메모리를 차지하지 않습니다.
+struct TraceEvent
+{
+	std::int64_t ts;            // ns (NowNs)
+	std::int64_t value;         // Complete: 길이(ns), Instant: 인자
+	const char* name;
+	const char* category;
+	char phase;                 // 'B' 'E' 'i' 'X'
+};
+
+class Tracer
+{
+public:
+	static Tracer& Instance()
+	{
+		static Tracer tracer;
+		return tracer;
+	}
+
+	Tracer(const Tracer&) = delete;
+	Tracer& operator=(const Tracer&) = delete;
+
+	static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+	// 기록 시작. 이미 만들어진 링은 크기를 유지합니다. (kTraceMaxCapacity 를 넘으면 상한으로 자름)
+	void Start(std::size_t capacityPerThread = kTraceDefaultCapacity)
+	{
+		std::size_t capacity = 1;
+		while (capacity < capacityPerThread && capacity < kTraceMaxCapacity)
+			capacity <<= 1;
+		capacity_.store(capacity, std::memory_order_relaxed);
+		startNs_ = NowNs();
+		enabled_.store(true, std::memory_order_release);
+	}
+
+	void Stop() { enabled_.store(false, std::memory_order_release); }
+
+	void Record(char phase, const char* name, const char* category, std::int64_t ts, std::int64_t value)
+	{
+		Ring& ring = LocalRing();
+		const std::uint64_t h = ring.head.load(std::memory_order_relaxed);
+		TraceEvent& e = ring.events[h & (ring.capacity - 1)];
+		e.ts = ts;
+		e.value = value;
+		e.name = name;
+		e.category = category;
+		e.phase = phase;
+		ring.head.store(h + 1, std::memory_order_release);
+	}
+
+	// 현재 스레드의 이름 (트레이스 뷰어의 행 이름). 리터럴만 받습니다.
+	void SetThreadName(const char* name) { LocalRing().name = name; }
+
+	// Chrome trace JSON 으로 씁니다. 기록한 이벤트 수, 실패하면 -1
+	long long Dump(const std::string& path)
+	{
+		std::ofstream out(path);
+		if (!out)
+			return -1;
+
+		std::lock_guard<std::mutex> guard(mutex_);
+		std::vector<ThreadLog> logs = retired_;
+		for (const Ring* ring : live_)
+			logs.push_back(Collect(*ring));
+
+		long long count = 0;
+		bool first = true;
+		out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		for (const ThreadLog& log : logs)
+		{
+			WriteSeparator(out, first);
+			out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << log.tid << ",\"args\":{\"name\":\"";
+			WriteEscaped(out, log.name ? log.name : "thread");
+			out << " (" << log.tid << ")\"}}";
+			for (const TraceEvent& e : log.events)
+			{
+				WriteSeparator(out, first);
+				out << "{\"ph\":\"" << e.phase << "\",\"name\":\"";
+				WriteEscaped(out, e.name);
+				out << "\",\"cat\":\"";
+				WriteEscaped(out, e.category);
+				out << "\",\"pid\":1,\"tid\":" << log.tid << ",\"ts\":";
+				WriteMicros(out, e.ts - startNs_);
+				if (e.phase == 'X')
+				{
+					out << ",\"dur\":";
+					WriteMicros(out, e.value);
+				}
+				else if (e.phase == 'i')
+					out << ",\"s\":\"t\",\"args\":{\"value\":" << e.value << "}";
+				out << "}";
+				++count;
+			}
+		}
+		out << "\n]}\n";
+
+		std::uint64_t dropped = 0;
+		for (const ThreadLog& log : logs)
+			dropped += log.dropped;
+		droppedAtDump_ = dropped;
+		threadsAtDump_ = logs.size();
+		return count;
+	}
+
+	std::uint64_t DroppedAtDump() const { return droppedAtDump_; }
+	std::size_t ThreadsAtDump() const { return threadsAtDump_; }
+
+private:
+	struct Ring
+	{
+		explicit Ring(std::size_t cap) : events(new TraceEvent[cap]), capacity(cap), tid(static_cast<long long>(CurrentThreadId())) {}
+
+		std::unique_ptr<TraceEvent[]> events;
+		std::size_t capacity;
+		std::atomic<std::uint64_t> head{ 0 };
+		long long tid;
+		const char* name = nullptr;
+	};
+
+	// 끝난 스레드의 이벤트 (쓴 만큼만, 오래된 것부터)
+	struct ThreadLog
+	{
+		long long tid = 0;
+		const char* name = nullptr;
+		std::vector<TraceEvent> events;
+		std::uint64_t dropped = 0;
+	};
+
+	// thread_local: 스레드의 첫 이벤트에서 링을 만들어 등록하고, 스레드가 끝나면 ThreadLog 로 옮깁니다.
+	struct RingHandle
+	{
+		explicit RingHandle(Tracer& t) : tracer(t), ring(new Ring(t.capacity_.load(std::memory_order_relaxed)))
+		{
+			std::lock_guard<std::mutex> guard(tracer.mutex_);
+			tracer.live_.push_back(ring);
+		}
+
+		~RingHandle()
+		{
+			std::lock_guard<std::mutex> guard(tracer.mutex_);
+			tracer.retired_.push_back(Collect(*ring));
+			tracer.live_.erase(std::find(tracer.live_.begin(), tracer.live_.end(), ring));
+			delete ring;
+		}
+
+		Tracer& tracer;
+		Ring* ring;
+	};
+
+	Tracer() = default;
+
+	Ring& LocalRing()
+	{
+		thread_local RingHandle handle(*this);
+		return *handle.ring;
+	}
+
+	static ThreadLog Collect(const Ring& ring)
+	{
+		ThreadLog log;
+		log.tid = ring.tid;
+		log.name = ring.name;
+		const std::uint64_t head = ring.head.load(std::memory_order_acquire);
+		const std::uint64_t begin = head > ring.capacity ? head - ring.capacity : 0;
+		log.dropped = begin;
+		log.events.reserve(static_cast<std::size_t>(head - begin));
+		for (std::uint64_t i = begin; i < head; ++i)
+			log.events.push_back(ring.events[i & (ring.capacity - 1)]);
+		return log;
+	}
+
+	static void WriteSeparator(std::ostream& out, bool& first)
+	{
+		if (!first)
+			out << ",\n";
+		first = false;
+	}
+
+	// JSON 문자열: " 와 \ 앞에 \, 0x20 미만의 제어 문자는 \u00XX
+	static void WriteEscaped(std::ostream& out, const char* s)
+	{
+		static constexpr char kHex[] = "0123456789abcdef";
+		for (; s && *s; ++s)
+		{
+			const unsigned char c = static_cast<unsigned char>(*s);
+			if (c < 0x20)
+			{
+				out << "\\u00" << kHex[c >> 4] << kHex[c & 0xf];
+				continue;
+			}
+			if (c == '"' || c == '\\')
+				out << '\\';
+			out << *s;
+		}
+	}
+
+	// Chrome trace 의 ts / dur 단위는 us. ns 를 소수 셋째 자리까지 씁니다.
+	static void WriteMicros(std::ostream& out, std::int64_t ns)
+	{
+		if (ns < 0)
+		{
+			out << '-';
+			ns = -ns;
+		}
+		const std::int64_t frac = ns % 1000;
+		out << ns / 1000 << '.' << static_cast<char>('0' + frac / 100) << static_cast<char>('0' + frac / 10 % 10) << static_cast<char>('0' + frac % 10);
+	}
+
+	static inline std::atomic<bool> enabled_{ false };
+	std::atomic<std::size_t> capacity_{ kTraceDefaultCapacity };
+	std::int64_t startNs_ = 0;
+	std::mutex mutex_;
+	std::vector<Ring*> live_;
+	std::vector<ThreadLog> retired_;
+	std::uint64_t droppedAtDump_ = 0;
+	std::size_t threadsAtDump_ = 0;
+};
+
+inline bool TraceEnabled() { return Tracer::Enabled(); }
+
+inline void TraceBegin(const char* name, const char* category = "lab")
+{
+	if (Tracer::Enabled())
+		Tracer::Instance().Record('B', name, category, NowNs(), 0);
+}
+
+inline void TraceEnd(const char* name, const char* category = "lab")
+{
+	if (Tracer::Enabled())
+		Tracer::Instance().Record('E', name, category, NowNs(), 0);
+}
+
+inline void TraceInstant(const char* name, const char* category = "lab", std::int64_t value = 0)
+{
+	if (Tracer::Enabled())
+		Tracer::Instance().Record('i', name, category, NowNs(), value);
+}
+
+// 이미 잰 구간을 이벤트 하나로 (startNs 는 NowNs 기준)
+inline void TraceComplete(const char* name, const char* category, std::int64_t startNs, std::int64_t durationNs)
+{
+	if (Tracer::Enabled())
+		Tracer::Instance().Record('X', name, category, startNs, durationNs);
+}
+
+inline void TraceThreadName(const char* name)
+{
+	if (Tracer::Enabled())
+		Tracer::Instance().SetThreadName(name);
+}
+
+// 블록 하나를 Begin / End 구간으로
+class TraceScope
+{
+public:
+	TraceScope(const char* name, const char* category = "lab") : name_(name), category_(category), on_(Tracer::Enabled())
+	{
+		if (on_)
+			Tracer::Instance().Record('B', name_, category_, NowNs(), 0);
+	}
+
+	~TraceScope()
+	{
+		if (on_)
+			Tracer::Instance().Record('E', name_, category_, NowNs(), 0);
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* name_;
+	const char* category_;
+	bool on_;
+};
+
+// Lockable 을 감싸 경합한 획득만 "lock wait" 구간으로 남깁니다. (경합이 없으면 try_lock 한 번)
+// 락 앞에 줄 선 스레드들(convoy)이 타임라인에 계단처럼 보입니다.
+template <typename Lock>
+class TracedLock
+{
+public:
+	void lock()
+	{
+		if (!Tracer::Enabled())
+		{
+			lock_.lock();
+			return;
+		}
+		if (lock_.try_lock())
+			return;
+		const std::int64_t t0 = NowNs();
+		lock_.lock();
+		Tracer::Instance().Record('X', "lock wait", "lock", t0, NowNs() - t0);
+	}
+
+	bool try_lock() { return lock_.try_lock(); }
+	void unlock() { lock_.unlock(); }
+
+private:
+	Lock lock_;
+};
+
+// main 에 하나: trace=path 가 있으면 기록을 켜고, 소멸자(main 끝)에서 JSON 을 씁니다.
+// - trace=path    : 결과 파일 (없으면 꺼짐)
+// - tracebuf=N    : 스레드당 링 크기 (이벤트 수, 기본 kTraceDefaultCapacity, 1 ~ kTraceMaxCapacity)
+class TraceSession
+{
+public:
+	explicit TraceSession(const LabArgs& cli) : path_(cli.Get("trace", ""))
+	{
+		if (path_.empty())
+			return;
+		const long long capacity = cli.GetInt("tracebuf", static_cast<long long>(kTraceDefaultCapacity));
+		Tracer::Instance().Start(static_cast<std::size_t>(std::clamp(capacity, 1LL, static_cast<long long>(kTraceMaxCapacity))));
+		TraceThreadName("main");
+	}
+
+	~TraceSession()
+	{
+		if (path_.empty())
+			return;
+		Tracer& tracer = Tracer::Instance();
+		tracer.Stop();
+		const long long count = tracer.Dump(path_);
+		if (count < 0)
+			std::cout << "[trace] cannot write " << path_ << "\n";
+		else
+			std::cout << "[trace] " << count << " events from " << tracer.ThreadsAtDump() << " threads -> " << path_
+				<< " (overwritten " << tracer.DroppedAtDump() << ")\n";
+	}
+
+	TraceSession(const TraceSession&) = delete;
+	TraceSession& operator=(const TraceSession&) = delete;
+
+private:
+	std::string path_;
+};
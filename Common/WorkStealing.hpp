@@ -0,0 +1,434 @@
+#pragma once
+
+// ThreadLab 공용 코어 - 작업 훔치기(work-stealing) 스케줄러
+//
+// 구조
+// - 워커마다 Chase-Lev 덱(deque)을 하나씩 가집니다.
+//   - 소유 워커: 덱의 bottom 쪽에서 Push / Pop (LIFO, 최근에 만든 작업 = 캐시에 남아 있는 작업)
+//   - 다른 워커: 덱의 top 쪽에서 Steal (FIFO, 가장 오래된 = 보통 가장 큰 작업)
+//   - 소유자와 도둑이 부딪히는 경우는 원소가 하나 남았을 때뿐이고, 그때만 CAS 로 정리합니다.
+// - 할 일이 없는 워커는 무작위로 고른 다른 워커의 덱에서 작업을 훔칩니다.
+// - 워커가 아닌 스레드(main 등)에서 제출한 작업은 전역 주입 큐(injection queue)로 들어갑니다.
+//
+// 작업과 join
+// - Spawn(group, fn) 으로 자식 작업을 만들고, Wait(group) 으로 그 그룹의 작업이 모두 끝날 때까지 기다립니다.
+// - 워커 스레드 안에서 Wait 하면 블록하지 않고 다른 작업(자기 덱 / 훔친 작업)을 대신 실행하며 기다립니다.
+//   그래서 재귀적으로 작업을 나누고 기다려도 워커가 모자라 교착되는 일이 없습니다.
+// - 워커가 아닌 스레드의 Wait 는 std::atomic::wait 로 잠듭니다.
+//
+// 비교용 모드
+// - QueueMode::GlobalQueue : 덱을 쓰지 않고 모든 작업을 mutex 로 보호되는 큐(LIFO) 하나에 넣습니다.
+//   (같은 Spawn/Wait 구조에서 큐 구조만 바꿔 "전역 큐 풀"과 비교하기 위한 모드)
+//
+// 주의
+// - 작업 안에서 던진 예외는 잡지 않습니다. (결과/예외 전달은 promise 등으로 직접 처리)
+// - 스케줄러를 소멸시키기 전에 제출한 작업을 모두 Wait 해야 합니다.
+
+#include "CacheLine.hpp"
+#include "ThreadAttributes.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Chase-Lev 작업 덱 (Lê, Pop, Cohen, Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models", 2013)
+// - T 는 포인터처럼 trivially copyable 한 타입이어야 합니다.
+// - 배열이 가득 차면 두 배로 키우며, 도둑이 옛 배열을 읽고 있을 수 있으므로 옛 배열은 덱이 소멸할 때 해제합니다.
+template <typename T>
+class ChaseLevDeque
+{
+public:
+	explicit ChaseLevDeque(std::int64_t initialCapacity = 256)
+	{
+		arrays_.push_back(std::make_unique<Array>(initialCapacity));
+		array_.store(arrays_.back().get(), std::memory_order_relaxed);
+	}
+
+	ChaseLevDeque(const ChaseLevDeque&) = delete;
+	ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+	// 소유 스레드 전용
+	void Push(T item)
+	{
+		const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+		const std::int64_t t = top_.load(std::memory_order_acquire);
+		Array* a = array_.load(std::memory_order_relaxed);
+		if (b - t > a->capacity - 1)
+		{
+			arrays_.push_back(a->Grow(b, t));
+			a = arrays_.back().get();
+			array_.store(a, std::memory_order_release);
+		}
+		a->Put(b, item);
+		// 논문의 release fence + relaxed store 대신 release store 를 씁니다. (x86 에서는 같은 코드, TSan 이 이해할 수 있음)
+		bottom_.store(b + 1, std::memory_order_release);
+	}
+
+	// 소유 스레드 전용
+	bool Pop(T* out)
+	{
+		const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+		Array* a = array_.load(std::memory_order_relaxed);
+		bottom_.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::int64_t t = top_.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			// 비어 있음
+			bottom_.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		T item = a->Get(b);
+		if (t == b)
+		{
+			// 마지막 하나: 도둑과 경쟁
+			const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom_.store(b + 1, std::memory_order_relaxed);
+			if (!won)
+				return false;
+		}
+		*out = item;
+		return true;
+	}
+
+	// 아무 스레드나 호출 가능
+	bool Steal(T* out)
+	{
+		std::int64_t t = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const std::int64_t b = bottom_.load(std::memory_order_acquire);
+		if (t >= b)
+			return false;
+
+		Array* a = array_.load(std::memory_order_acquire);
+		T item = a->Get(t);
+		if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false; // 다른 도둑이나 소유자가 먼저 가져감
+		*out = item;
+		return true;
+	}
+
+	bool LooksEmpty() const
+	{
+		return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct Array
+	{
+		explicit Array(std::int64_t cap)
+			: capacity(cap), mask(cap - 1), slots(new std::atomic<T>[static_cast<std::size_t>(cap)]) {}
+
+		T Get(std::int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+		void Put(std::int64_t i, T item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+
+		std::unique_ptr<Array> Grow(std::int64_t bottom, std::int64_t top) const
+		{
+			auto bigger = std::make_unique<Array>(capacity * 2);
+			for (std::int64_t i = top; i < bottom; ++i)
+				bigger->Put(i, Get(i));
+			return bigger;
+		}
+
+		std::int64_t capacity; // 2의 거듭제곱
+		std::int64_t mask;
+		std::unique_ptr<std::atomic<T>[]> slots;
+	};
+
+	alignas(kCacheLineSize) std::atomic<std::int64_t> top_{ 0 };
+	alignas(kCacheLineSize) std::atomic<std::int64_t> bottom_{ 0 };
+	std::atomic<Array*> array_{ nullptr };
+	std::vector<std::unique_ptr<Array>> arrays_; // 소유 스레드만 수정 (현재 + 옛 배열)
+};
+
+// Spawn 으로 만든 작업들의 완료를 한꺼번에 기다리기 위한 묶음
+class TaskGroup
+{
+public:
+	TaskGroup() = default;
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+private:
+	friend class WorkStealingScheduler;
+	std::atomic<int> pending_{ 0 };
+};
+
+class WorkStealingScheduler
+{
+public:
+	enum class QueueMode
+	{
+		WorkStealing, // 워커별 Chase-Lev 덱 + 무작위 훔치기
+		GlobalQueue,  // 비교용: mutex 로 보호되는 전역 큐 하나
+	};
+
+	static unsigned DefaultThreadCount()
+	{
+		const unsigned n = std::thread::hardware_concurrency();
+		return n == 0 ? 1 : n;
+	}
+
+	explicit WorkStealingScheduler(unsigned threadCount = DefaultThreadCount(), QueueMode mode = QueueMode::WorkStealing,
+		const ThreadAttributes& attrs = ThreadAttributes())
+		: mode_(mode), attrs_(attrs)
+	{
+		if (threadCount == 0)
+			threadCount = 1;
+		workers_.reserve(threadCount);
+		for (unsigned i = 0; i < threadCount; ++i)
+			workers_.push_back(std::make_unique<Worker>(0x9E3779B97F4A7C15ull * (i + 1)));
+		for (unsigned i = 0; i < threadCount; ++i)
+			workers_[i]->thread = std::thread(&WorkStealingScheduler::WorkerLoop, this, static_cast<int>(i));
+	}
+
+	~WorkStealingScheduler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(parkM_);
+			stopping_ = true;
+		}
+		parkCv_.notify_all();
+		for (auto& worker : workers_)
+			worker->thread.join();
+	}
+
+	WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+	WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+	unsigned Size() const { return static_cast<unsigned>(workers_.size()); }
+	QueueMode Mode() const { return mode_; }
+
+	// 지금까지 성공한 훔치기 횟수 (통계용)
+	std::uint64_t StealCount() const
+	{
+		std::uint64_t total = 0;
+		for (const auto& worker : workers_)
+			total += worker->steals.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	template <typename F>
+	void Spawn(TaskGroup& group, F&& fn)
+	{
+		group.pending_.fetch_add(1, std::memory_order_relaxed);
+		Task* task = new Task{ std::function<void()>(std::forward<F>(fn)), &group };
+
+		const int self = CurrentWorkerIndex();
+		if (self >= 0 && mode_ == QueueMode::WorkStealing)
+			workers_[self]->deque.Push(task);
+		else
+			PushGlobal(task);
+
+		WakeOne();
+	}
+
+	// 워커 스레드: 다른 작업을 대신 실행하며 대기 / 그 외 스레드: 잠들어서 대기
+	void Wait(TaskGroup& group)
+	{
+		const int self = CurrentWorkerIndex();
+		if (self < 0)
+		{
+			int pending = group.pending_.load(std::memory_order_acquire);
+			while (pending != 0)
+			{
+				group.pending_.wait(pending, std::memory_order_acquire);
+				pending = group.pending_.load(std::memory_order_acquire);
+			}
+			return;
+		}
+
+		while (group.pending_.load(std::memory_order_acquire) != 0)
+		{
+			if (!TryRunOne(self))
+				std::this_thread::yield();
+		}
+	}
+
+private:
+	struct Task
+	{
+		std::function<void()> fn;
+		TaskGroup* group;
+	};
+
+	struct Worker
+	{
+		explicit Worker(std::uint64_t seed) : rng(seed) {}
+
+		ChaseLevDeque<Task*> deque;
+		std::thread thread;
+		std::uint64_t rng;
+		std::atomic<std::uint64_t> steals{ 0 };
+	};
+
+	// 현재 스레드가 이 스케줄러의 워커이면 인덱스, 아니면 -1
+	int CurrentWorkerIndex() const
+	{
+		return tlsScheduler_ == this ? tlsWorkerIndex_ : -1;
+	}
+
+	void PushGlobal(Task* task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(globalM_);
+			global_.push_back(task);
+		}
+		globalSize_.fetch_add(1, std::memory_order_release);
+	}
+
+	bool PopGlobal(Task** out)
+	{
+		if (globalSize_.load(std::memory_order_acquire) == 0)
+			return false;
+		std::lock_guard<std::mutex> lock(globalM_);
+		if (global_.empty())
+			return false;
+		// GlobalQueue 모드는 가장 최근 작업(= 가장 작게 쪼개진 작업)부터 꺼냅니다.
+		// FIFO 로 꺼내면 Wait 중인 워커가 가장 큰 작업을 대신 실행하게 되어 스택이 끝없이 깊어집니다.
+		if (mode_ == QueueMode::GlobalQueue)
+		{
+			*out = global_.back();
+			global_.pop_back();
+		}
+		else
+		{
+			*out = global_.front();
+			global_.pop_front();
+		}
+		globalSize_.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool TrySteal(int self, Task** out)
+	{
+		const int count = static_cast<int>(workers_.size());
+		if (count <= 1)
+			return false;
+
+		// xorshift64 로 시작 희생자(victim)를 고르고 한 바퀴 돌아봅니다.
+		std::uint64_t& x = workers_[self]->rng;
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		const int start = static_cast<int>(x % static_cast<std::uint64_t>(count));
+		for (int k = 0; k < count; ++k)
+		{
+			const int victim = (start + k) % count;
+			if (victim == self)
+				continue;
+			if (workers_[victim]->deque.Steal(out))
+			{
+				workers_[self]->steals.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool TryRunOne(int self)
+	{
+		Task* task = nullptr;
+		const bool found =
+			(mode_ == QueueMode::WorkStealing && workers_[self]->deque.Pop(&task)) ||
+			PopGlobal(&task) ||
+			(mode_ == QueueMode::WorkStealing && TrySteal(self, &task));
+		if (!found)
+			return false;
+		Execute(task);
+		return true;
+	}
+
+	void Execute(Task* task)
+	{
+		task->fn();
+		TaskGroup* group = task->group;
+		delete task;
+		// notify 는 주소를 키로만 사용하므로(futex / WakeByAddress), 깨어난 쪽이 group 을 먼저 정리해도 안전합니다.
+		if (group->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			group->pending_.notify_all();
+	}
+
+	bool AnyWorkVisible() const
+	{
+		if (globalSize_.load(std::memory_order_acquire) != 0)
+			return true;
+		for (const auto& worker : workers_)
+			if (!worker->deque.LooksEmpty())
+				return true;
+		return false;
+	}
+
+	// 잠든 워커가 있을 때만 깨웁니다. (seq_cst 로 "작업 추가 -> sleepers 확인" 순서를 보장)
+	void WakeOne()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleepers_.load(std::memory_order_seq_cst) == 0)
+			return;
+		{
+			std::lock_guard<std::mutex> lock(parkM_);
+			++wakeEpoch_;
+		}
+		parkCv_.notify_one();
+	}
+
+	void WorkerLoop(int index)
+	{
+		ApplyThreadAttributes(attrs_, static_cast<unsigned>(index));
+		tlsScheduler_ = this;
+		tlsWorkerIndex_ = index;
+
+		while (true)
+		{
+			if (TryRunOne(index))
+				continue;
+
+			// 잠들기 전: epoch 를 기록하고 sleepers 를 올린 뒤, 한 번 더 작업이 있는지 확인합니다.
+			// Spawn 쪽은 작업을 넣은 뒤 sleepers 를 보므로, 둘 중 하나는 반드시 상대를 봅니다.
+			std::unique_lock<std::mutex> lock(parkM_);
+			if (stopping_)
+				break;
+			const std::uint64_t epoch = wakeEpoch_;
+			sleepers_.fetch_add(1, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (AnyWorkVisible())
+			{
+				sleepers_.fetch_sub(1, std::memory_order_relaxed);
+				continue;
+			}
+			parkCv_.wait(lock, [&] { return stopping_ || wakeEpoch_ != epoch; });
+			sleepers_.fetch_sub(1, std::memory_order_relaxed);
+			if (stopping_)
+				break;
+		}
+
+		tlsScheduler_ = nullptr;
+		tlsWorkerIndex_ = -1;
+	}
+
+	static inline thread_local const WorkStealingScheduler* tlsScheduler_ = nullptr;
+	static inline thread_local int tlsWorkerIndex_ = -1;
+
+	const QueueMode mode_;
+	const ThreadAttributes attrs_;
+	std::vector<std::unique_ptr<Worker>> workers_;
+
+	std::mutex globalM_;
+	std::deque<Task*> global_;
+	std::atomic<std::size_t> globalSize_{ 0 };
+
+	std::mutex parkM_;
+	std::condition_variable parkCv_;
+	std::uint64_t wakeEpoch_ = 0; // parkM_ 로 보호
+	std::atomic<int> sleepers_{ 0 };
+	bool stopping_ = false;			// parkM_ 로 보호
+};